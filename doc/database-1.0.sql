@@ -11,6 +11,8 @@ CREATE TABLE Environment
   size_x INTEGER NOT NULL,
   size_y INTEGER NOT NULL,
 
+  seed INTEGER NOT NULL,                -- Seed of the random numbers
+
   time_rot INTEGER NOT NULL,
   size_rot INTEGER NOT NULL,
 
@@ -45,6 +47,7 @@ CREATE TABLE Environment
   PRIMARY KEY(id),
   CHECK(time >= 0),
   CHECK(size_x > 0 AND size_y > 0),
+  CHECK(seed >= 0),
   CHECK(time_rot >= 0),
   CHECK(size_rot >= 0),
   CHECK(mutations_probability >= 0 AND mutations_probability <= 1),
@@ -170,12 +173,30 @@ END;
 CREATE TABLE Code(
   id INTEGER NOT NULL,
 
+  hash INTEGER NOT NULL,                -- FNV-1a hash of the data
+  size INTEGER NOT NULL,                -- size of the data
+  refs INTEGER NOT NULL DEFAULT 0,      -- rows that use the code
+
   data BLOB NOT NULL,
 
   PRIMARY KEY(id),
-  CHECK(length(data) > 0 AND (length(data) % 4 = 0))
+  CHECK(length(data) > 0 AND (length(data) % 4 = 0)),
+  CHECK(refs >= 0)
 );
 
+CREATE INDEX Code_index ON Code(hash);
+
+/* Delete the code when it isn't used anymore */
+CREATE TRIGGER Code_update_refs
+AFTER UPDATE OF refs
+ON Code
+FOR EACH ROW
+WHEN NEW.refs = 0
+BEGIN
+  DELETE FROM Code
+  WHERE id = NEW.id;
+END;
+
 
 /*******************
  * Spawn
@@ -206,6 +227,44 @@ CREATE TABLE Spawn(
   CHECK(energy > 0)
 );
 
+/* Count the references to the code */
+CREATE TRIGGER Spawn_insert_code_id
+AFTER INSERT
+ON Spawn
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.code_id;
+END;
+
+CREATE TRIGGER Spawn_delete_code_id
+AFTER DELETE
+ON Spawn
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.code_id;
+END;
+
+/* Move the reference (nothing to do if Code(id) was updated) */
+CREATE TRIGGER Spawn_update_code_id
+AFTER UPDATE OF code_id
+ON Spawn
+FOR EACH ROW
+WHEN EXISTS(SELECT 1
+            FROM Code
+            WHERE id = OLD.code_id)
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.code_id;
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.code_id;
+END;
+
 /* regions must be inside the world */
 CREATE TRIGGER Spawn_insert
 BEFORE INSERT
@@ -404,6 +463,44 @@ CREATE TABLE Bug
   CHECK(creation >= 0)
 );
 
+/* Count the references to the code */
+CREATE TRIGGER Bug_insert_code_id
+AFTER INSERT
+ON Bug
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.code_id;
+END;
+
+CREATE TRIGGER Bug_delete_code_id
+AFTER DELETE
+ON Bug
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.code_id;
+END;
+
+/* Move the reference (nothing to do if Code(id) was updated) */
+CREATE TRIGGER Bug_update_code_id
+AFTER UPDATE OF code_id
+ON Bug
+FOR EACH ROW
+WHEN EXISTS(SELECT 1
+            FROM Code
+            WHERE id = OLD.code_id)
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.code_id;
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.code_id;
+END;
+
 CREATE INDEX Bug_index ON Bug(father_id);
 
 /* creation must be the current time */
@@ -435,10 +532,47 @@ CREATE TABLE Egg
   FOREIGN KEY(world_id) REFERENCES World(id) ON UPDATE CASCADE ON DELETE CASCADE,
   FOREIGN KEY(memory_id) REFERENCES Code(id) ON UPDATE CASCADE ON DELETE CASCADE,
   UNIQUE(world_id),
-  UNIQUE(memory_id),
   CHECK(energy > 0)
 );
 
+/* Count the references to the code */
+CREATE TRIGGER Egg_insert_memory_id
+AFTER INSERT
+ON Egg
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.memory_id;
+END;
+
+CREATE TRIGGER Egg_delete_memory_id
+AFTER DELETE
+ON Egg
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.memory_id;
+END;
+
+/* Move the reference (nothing to do if Code(id) was updated) */
+CREATE TRIGGER Egg_update_memory_id
+AFTER UPDATE OF memory_id
+ON Egg
+FOR EACH ROW
+WHEN EXISTS(SELECT 1
+            FROM Code
+            WHERE id = OLD.memory_id)
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.memory_id;
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.memory_id;
+END;
+
 
 /*******************
  * Registers
@@ -447,9 +581,11 @@ CREATE TABLE Registers(
   id INTEGER NOT NULL,
 
   data BLOB NOT NULL,
+  running INTEGER NOT NULL DEFAULT 1,   -- 0 if the CPU was stopped
 
   PRIMARY KEY(id),
-  CHECK(length(data) = 520)
+  CHECK(length(data) = 520),
+  CHECK(running IN (0, 1))
 );
 
 
@@ -478,13 +614,50 @@ CREATE TABLE AliveBug
   FOREIGN KEY(memory_id) REFERENCES Code(id) ON UPDATE CASCADE ON DELETE CASCADE,
   UNIQUE(world_id),
   UNIQUE(registers_id),
-  UNIQUE(memory_id),
   CHECK(time_last_action IS NULL OR time_last_action >= 0),
   CHECK(action_time IS NULL OR action_time > 0),
   CHECK(birth >= 0),
   CHECK(energy > 0)
 );
 
+/* Count the references to the code */
+CREATE TRIGGER AliveBug_insert_memory_id
+AFTER INSERT
+ON AliveBug
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.memory_id;
+END;
+
+CREATE TRIGGER AliveBug_delete_memory_id
+AFTER DELETE
+ON AliveBug
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.memory_id;
+END;
+
+/* Move the reference (nothing to do if Code(id) was updated) */
+CREATE TRIGGER AliveBug_update_memory_id
+AFTER UPDATE OF memory_id
+ON AliveBug
+FOR EACH ROW
+WHEN EXISTS(SELECT 1
+            FROM Code
+            WHERE id = OLD.memory_id)
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.memory_id;
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.memory_id;
+END;
+
 /* Check that the time_last_action isn't in the future */
 CREATE TRIGGER AliveBug_insert_time_last_action
 BEFORE INSERT
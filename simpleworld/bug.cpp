@@ -29,7 +29,6 @@
 #endif // DEBUG
 
 #include <simpleworld/cpu/types.hpp>
-#include <simpleworld/db/code.hpp>
 #include <simpleworld/db/registers.hpp>
 #include "simpleworld.hpp"
 #include "types.hpp"
@@ -49,16 +48,115 @@ Bug::Bug(SimpleWorld* sw, db::ID id)
   : Element(ElementBug), db::Bug(sw, id), db::AliveBug(sw, id),
     db::World(sw, this->world_id()), world(sw),
     regs(db::Registers(sw, db::AliveBug::registers_id()).data()),
-    mem(db::Code(sw, db::AliveBug::memory_id()).data()),
-    cpu(isa, &this->regs, &this->mem, this)
+    mem(sw, db::AliveBug::memory_id(), sw->code_cache()),
+    cpu(isa, &this->regs, &this->mem, this), sequence(0), waiting(false),
+    changed_(0)
 {
+  this->energy_ = db::AliveBug::energy();
+  this->time_last_action_null_ = db::AliveBug::is_null("time_last_action");
+  this->time_last_action_ = this->time_last_action_null_ ? 0 :
+    db::AliveBug::time_last_action();
+  this->action_time_null_ = db::AliveBug::is_null("action_time");
+  this->action_time_ = this->action_time_null_ ? 0 :
+    db::AliveBug::action_time();
+  this->position_x_ = db::World::position_x();
+  this->position_y_ = db::World::position_y();
+  this->orientation_null_ = db::World::is_null("orientation");
+  this->orientation_ = this->orientation_null_ ? OrientationNorth :
+    db::World::orientation();
+  // a stopped CPU must not run again when the World is loaded
+  this->cpu_running_ =
+    db::Registers(sw, db::AliveBug::registers_id()).running();
+  this->cpu.running(this->cpu_running_);
+
+  // the instructions are decoded only once for all the bugs with this code
+  this->cpu.share_cache(boost::shared_ptr<const cpu::CPU::DecodedCode>(
+                          this->mem.image(), &this->mem.image()->decoded));
+}
+
+
+/**
+ * Set the energy of the bug.
+ * The energy is written to the database when the bug is saved.
+ * @param energy the new energy.
+ */
+void Bug::energy(Energy energy)
+{
+  this->energy_ = energy;
+  this->changed_ |= ChangedEnergy;
+}
+
+/**
+ * Set the time of the last action.
+ * The time is written to the database when the bug is saved.
+ * @param time_last_action the new time.
+ */
+void Bug::time_last_action(Time time_last_action)
+{
+  this->time_last_action_ = time_last_action;
+  this->time_last_action_null_ = false;
+  this->changed_ |= ChangedTimeLastAction;
+}
+
+/**
+ * Set the time when the action will be finished.
+ * @param action_time the new time.
+ * @exception DBException if there is an error with the update.
+ */
+void Bug::action_time(Time action_time)
+{
+  // The triggers check that action_time is not in the past, so it can't
+  // wait until the bug is saved: the action could be interrupted before
+  db::AliveBug::action_time(action_time);
+  this->action_time_ = action_time;
+  this->action_time_null_ = false;
+  this->changed_ &= ~ChangedActionTime;
+}
+
+
+/**
+ * Set the position in the x coord.
+ * @param position_x the new position.
+ * @exception DBException if there is an error with the update.
+ */
+void Bug::position_x(Coord position_x)
+{
+  // The positions must be unique, so they are written immediately
+  db::World::position_x(position_x);
+  this->position_x_ = position_x;
+}
+
+/**
+ * Set the position in the y coord.
+ * @param position_y the new position.
+ * @exception DBException if there is an error with the update.
+ */
+void Bug::position_y(Coord position_y)
+{
+  // The positions must be unique, so they are written immediately
+  db::World::position_y(position_y);
+  this->position_y_ = position_y;
+}
+
+/**
+ * Set the orientation.
+ * The orientation is written to the database when the bug is saved.
+ * @param orientation the new orientation.
+ */
+void Bug::orientation(Orientation orientation)
+{
+  this->orientation_ = orientation;
+  this->orientation_null_ = false;
+  this->changed_ |= ChangedOrientation;
 }
 
 
 /**
  * The bug has been attacked.
+ * @return true if the interrupt was thrown, false if the stack or the
+ * ip are not valid and the bug must be killed.
  */
-void Bug::attacked()
+bool Bug::attacked()
 {
 #ifdef DEBUG
   std::cout << boost::str(boost::format("\
@@ -67,13 +165,15 @@ Bug[%1%] attacked")
     << std::endl;
 #endif // DEBUG
 
-  this->cpu.interrupt(INTERRUPT_WORLDEVENT, EventAttack);
+  return this->cpu.try_interrupt(INTERRUPT_WORLDEVENT, EventAttack);
 }
 
 /**
  * The code of the bug has been mutated.
+ * @return true if the interrupt was thrown, false if the stack or the
+ * ip are not valid and the bug must be killed.
  */
-void Bug::mutated()
+bool Bug::mutated()
 {
 #ifdef DEBUG
   std::cout << boost::str(boost::format("\
@@ -82,9 +182,54 @@ Bug[%1%] mutated")
     << std::endl;
 #endif // DEBUG
 
-  // The content of the memory has changed and must be updated
-  this->mem.update();
-  this->cpu.interrupt(INTERRUPT_WORLDEVENT, EventMutation);
+  // the code is mutated in memory, so only the decoded instructions must be
+  // updated
+  this->cpu.invalidate_cache();
+  return this->cpu.try_interrupt(INTERRUPT_WORLDEVENT, EventMutation);
+}
+
+
+/**
+ * Write the state of the bug that is only kept in memory.
+ * @exception DBException if there is a error in the database.
+ */
+void Bug::save()
+{
+  // a execution of CPU::speculate() not resumed is discarded
+  this->cpu.restore();
+  this->cpu.save_registers();
+  this->regs.flush();
+  // the code can be shared, so the memory can be written in other row
+  db::ID memory_id = this->mem.id();
+  this->mem.flush();
+
+  // the changed columns of AliveBug are written with only one UPDATE
+  unsigned columns = 0;
+  if (this->changed_ & ChangedEnergy)
+    columns |= db::AliveBug::ColumnEnergy;
+  if (this->changed_ & ChangedTimeLastAction)
+    columns |= db::AliveBug::ColumnTimeLastAction;
+  if (this->changed_ & ChangedActionTime)
+    columns |= db::AliveBug::ColumnActionTime;
+  if (this->mem.id() != memory_id)
+    columns |= db::AliveBug::ColumnMemoryId;
+  db::AliveBug::update(columns, this->energy_,
+                       this->time_last_action_, this->time_last_action_null_,
+                       this->action_time_, this->action_time_null_,
+                       this->mem.id());
+  if (this->changed_ & ChangedOrientation) {
+    if (this->orientation_null_)
+      db::World::set_null("orientation");
+    else
+      db::World::orientation(this->orientation_);
+  }
+  this->changed_ = 0;
+
+  if (this->cpu.running() != this->cpu_running_) {
+    this->cpu_running_ = this->cpu.running();
+    db::Registers(this->world, db::AliveBug::registers_id()).
+      running(this->cpu_running_);
+  }
 }
 
 
@@ -97,12 +242,14 @@ bool Bug::is_null(const std::string& colname) const
 {
   if (colname == "father_id")
     return db::Bug::is_null(colname);
-  else if (colname == "time_last_action" or colname == "action_time")
-    return db::AliveBug::is_null(colname);
+  else if (colname == "time_last_action")
+    return this->time_last_action_null_;
+  else if (colname == "action_time")
+    return this->action_time_null_;
   else if (colname == "orientation")
-    return db::World::is_null(colname);
+    return this->orientation_null_;
   else
-    return false;
+    return db::AliveBug::is_null(colname);
 }
 
 /**
@@ -113,10 +260,20 @@ void Bug::set_null(const std::string& colname)
 {
   if (colname == "father_id")
     db::Bug::set_null(colname);
-  else if (colname == "time_last_action" or colname == "action_time")
+  else if (colname == "time_last_action") {
+    this->time_last_action_ = 0;
+    this->time_last_action_null_ = true;
+    this->changed_ |= ChangedTimeLastAction;
+  } else if (colname == "action_time") {
+    this->action_time_ = 0;
+    this->action_time_null_ = true;
+    this->changed_ |= ChangedActionTime;
+  } else if (colname == "orientation") {
+    this->orientation_ = OrientationNorth;
+    this->orientation_null_ = true;
+    this->changed_ |= ChangedOrientation;
+  } else
     db::AliveBug::set_null(colname);
-  else if (colname == "orientation")
-    db::World::set_null(colname);
 }
 
 }
@@ -21,8 +21,10 @@
 #ifndef SIMPLEWORLD_BUG_HPP
 #define SIMPLEWORLD_BUG_HPP
 
+#include <simpleworld/types.hpp>
 #include <simpleworld/element.hpp>
 #include <simpleworld/dbmemory.hpp>
+#include <simpleworld/codememory.hpp>
 #include <simpleworld/cpu.hpp>
 #include <simpleworld/db/types.hpp>
 #include <simpleworld/db/bug.hpp>
@@ -79,15 +81,118 @@ public:
   }
 
 
+  /**
+   * Get the energy of the bug.
+   * @return the energy.
+   */
+  Energy energy() const { return this->energy_; }
+
+  /**
+   * Set the energy of the bug.
+   * The energy is written to the database when the bug is saved.
+   * @param energy the new energy.
+   */
+  void energy(Energy energy);
+
+  /**
+   * Get the time of the last action.
+   * @return the time.
+   */
+  Time time_last_action() const { return this->time_last_action_; }
+
+  /**
+   * Check if the time of the last action is NULL.
+   * @return true if no action was done yet, else false.
+   */
+  bool time_last_action_null() const { return this->time_last_action_null_; }
+
+  /**
+   * Set the time of the last action.
+   * The time is written to the database when the bug is saved.
+   * @param time_last_action the new time.
+   */
+  void time_last_action(Time time_last_action);
+
+  /**
+   * Get the time when the action will be finished.
+   * @return the time.
+   */
+  Time action_time() const { return this->action_time_; }
+
+  /**
+   * Check if the time when the action will be finished is NULL.
+   * @return true if the bug is not doing a action, else false.
+   */
+  bool action_time_null() const { return this->action_time_null_; }
+
+  /**
+   * Set the time when the action will be finished.
+   * @param action_time the new time.
+   * @exception DBException if there is an error with the update.
+   */
+  void action_time(Time action_time);
+
+
+  /**
+   * Get the position in the x coord.
+   * @return the position.
+   */
+  Coord position_x() const { return this->position_x_; }
+
+  /**
+   * Get the position in the y coord.
+   * @return the position.
+   */
+  Coord position_y() const { return this->position_y_; }
+
+  /**
+   * Set the position in the x coord.
+   * @param position_x the new position.
+   * @exception DBException if there is an error with the update.
+   */
+  void position_x(Coord position_x);
+
+  /**
+   * Set the position in the y coord.
+   * @param position_y the new position.
+   * @exception DBException if there is an error with the update.
+   */
+  void position_y(Coord position_y);
+
+  /**
+   * Get the orientation.
+   * @return the orientation.
+   */
+  Orientation orientation() const { return this->orientation_; }
+
+  /**
+   * Set the orientation.
+   * The orientation is written to the database when the bug is saved.
+   * @param orientation the new orientation.
+   */
+  void orientation(Orientation orientation);
+
+
   /**
    * The bug has been attacked.
+   * @return true if the interrupt was thrown, false if the stack or the
+   * ip are not valid and the bug must be killed.
    */
-  virtual void attacked();
+  virtual bool attacked();
 
   /**
    * The code of the bug has been mutated.
+   * @return true if the interrupt was thrown, false if the stack or the
+   * ip are not valid and the bug must be killed.
+   */
+  virtual bool mutated();
+
+
+  /**
+   * Write the state of the bug that is only kept in memory.
+   * @exception DBException if there is a error in the database.
    */
-  virtual void mutated();
+  void save();
 
 
   /**
@@ -107,8 +212,34 @@ public:
   SimpleWorld* world;           /**< World where the bug lives */
 
   DBMemory regs;                /**< Registers of the bug */
-  DBMemory mem;                 /**< Memory of the bug */
+  CodeMemory mem;               /**< Memory of the bug */
   CPU cpu;                      /**< CPU of the bug */
+
+  Uint64 sequence;              /**< Order of the bug in the World */
+  bool waiting;                 /**< If the bug waits for its action */
+
+private:
+  /**
+   * Columns that have been changed but not written to the database.
+   */
+  enum Changed {
+    ChangedEnergy = 1 << 0,
+    ChangedTimeLastAction = 1 << 1,
+    ChangedActionTime = 1 << 2,
+    ChangedOrientation = 1 << 3
+  };
+
+  Energy energy_;               /**< Energy of the bug */
+  Time time_last_action_;       /**< Time of the last action */
+  bool time_last_action_null_;  /**< If time_last_action is NULL */
+  Time action_time_;            /**< Time when the action will be finished */
+  bool action_time_null_;       /**< If action_time is NULL */
+  Coord position_x_;            /**< Position in the x coord */
+  Coord position_y_;            /**< Position in the y coord */
+  Orientation orientation_;     /**< Orientation of the bug */
+  bool orientation_null_;       /**< If orientation is NULL */
+  bool cpu_running_;            /**< If the CPU is running in the database */
+  unsigned changed_;            /**< Changed columns */
 };
 
 }
@@ -0,0 +1,128 @@
+/**
+ * @file simpleworld/codecache.cpp
+ * Cache of the code shared by the bugs.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#include <boost/shared_array.hpp>
+
+#include <simpleworld/db/code.hpp>
+#include "codecache.hpp"
+
+namespace simpleworld
+{
+
+/**
+ * Constructor.
+ * @param isa instruction set architecture used to decode the code.
+ * @param data the code.
+ * @param size size of the code.
+ */
+CodeImage::CodeImage(const cpu::ISA& isa, const void* data,
+                     cpu::Address size)
+  : memory(data, size)
+{
+  cpu::CPU::decode(isa, this->memory, &this->decoded);
+}
+
+
+/**
+ * Check if the code is equal to other code.
+ * @param data the other code.
+ * @param size size of the other code.
+ * @return true if the codes are equal, else false.
+ */
+bool CodeImage::equal(const void* data, cpu::Address size) const
+{
+  if (this->memory.size() != size)
+    return false;
+
+  std::vector<Uint8> bytes(size);
+  this->memory.read(&bytes[0], size);
+  return std::equal(bytes.begin(), bytes.end(),
+                    static_cast<const Uint8*>(data));
+}
+
+
+/**
+ * Constructor.
+ * @param isa instruction set architecture used to decode the code.
+ */
+CodeCache::CodeCache(const cpu::ISA& isa)
+  : isa_(isa), inserted_(0)
+{
+}
+
+
+/**
+ * Get a code.
+ * The code is loaded from the database if it isn't in the cache.
+ * @param db database.
+ * @param id id of the code.
+ * @return the code.
+ * @exception DBException if there is an error with the query.
+ */
+boost::shared_ptr<const CodeImage> CodeCache::get(db::DB* db, db::ID id)
+{
+  db::Code code(db, id);
+  Uint64 hash = code.hash();
+  Uint32 size;
+  boost::shared_array<Uint8> data = code.data().read(&size);
+
+  // the codes with the same hash are compared, as the table Code does, so
+  // a collision of the hash doesn't share the code of other genome
+  std::pair<Images::iterator, Images::iterator> range =
+    this->images_.equal_range(hash);
+  for (Images::iterator iter = range.first; iter != range.second; ++iter) {
+    boost::shared_ptr<const CodeImage> image = iter->second.lock();
+    if (image and image->equal(data.get(), size))
+      return image;
+  }
+
+  boost::shared_ptr<const CodeImage> image(new CodeImage(this->isa_,
+                                                         data.get(), size));
+  this->images_.insert(std::make_pair(hash,
+                                      boost::weak_ptr<const CodeImage>(image)));
+
+  // the cost of the purge is amortized over the insertions
+  if (++this->inserted_ > this->images_.size() / 2)
+    this->purge_();
+
+  return image;
+}
+
+
+/**
+ * Remove the codes already freed.
+ */
+void CodeCache::purge_()
+{
+  Images::iterator iter = this->images_.begin();
+  while (iter != this->images_.end())
+    if (iter->second.expired())
+      this->images_.erase(iter++);
+    else
+      ++iter;
+
+  this->inserted_ = 0;
+}
+
+}
@@ -0,0 +1,120 @@
+/**
+ * @file simpleworld/codecache.hpp
+ * Cache of the code shared by the bugs.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEWORLD_CODECACHE_HPP
+#define SIMPLEWORLD_CODECACHE_HPP
+
+#include <map>
+#include <cstddef>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <simpleworld/ints.hpp>
+#include <simpleworld/cpu/types.hpp>
+#include <simpleworld/cpu/isa.hpp>
+#include <simpleworld/cpu/memory.hpp>
+#include <simpleworld/cpu/cpu.hpp>
+#include <simpleworld/db/types.hpp>
+#include <simpleworld/db/db.hpp>
+
+namespace simpleworld
+{
+
+/**
+ * Code loaded from the database and its instructions decoded.
+ * It's read only, so it can be used by several bugs at the same time.
+ */
+struct CodeImage
+{
+  /**
+   * Constructor.
+   * @param isa instruction set architecture used to decode the code.
+   * @param data the code.
+   * @param size size of the code.
+   */
+  CodeImage(const cpu::ISA& isa, const void* data, cpu::Address size);
+
+
+  /**
+   * Check if the code is equal to other code.
+   * @param data the other code.
+   * @param size size of the other code.
+   * @return true if the codes are equal, else false.
+   */
+  bool equal(const void* data, cpu::Address size) const;
+
+  const cpu::Memory memory;     /**< Code */
+  cpu::CPU::DecodedCode decoded; /**< Instructions of the code decoded */
+};
+
+
+/**
+ * Cache of the code shared by the bugs.
+ *
+ * The code is found by the hash of the table Code and compared with the
+ * code of the row, so the bugs with the same genome share the code
+ * decoded. The cache doesn't keep the code
+ * alive: it's freed when the last bug that uses it is destroyed.
+ */
+class CodeCache
+{
+public:
+  /**
+   * Constructor.
+   * @param isa instruction set architecture used to decode the code.
+   */
+  CodeCache(const cpu::ISA& isa);
+
+
+  /**
+   * Number of codes in the cache, including the codes already freed that
+   * are not purged yet.
+   * @return the number of codes.
+   */
+  std::size_t size() const { return this->images_.size(); }
+
+
+  /**
+   * Get a code.
+   * The code is loaded from the database if it isn't in the cache.
+   * @param db database.
+   * @param id id of the code.
+   * @return the code.
+   * @exception DBException if there is an error with the query.
+   */
+  boost::shared_ptr<const CodeImage> get(db::DB* db, db::ID id);
+
+private:
+  const cpu::ISA& isa_;         /**< Instruction set */
+
+  typedef std::multimap<Uint64, boost::weak_ptr<const CodeImage> > Images;
+  Images images_;               /**< Codes by hash */
+  std::size_t inserted_;        /**< Codes inserted since the last purge */
+
+  /**
+   * Remove the codes already freed.
+   */
+  void purge_();
+};
+
+}
+
+#endif // SIMPLEWORLD_CODECACHE_HPP
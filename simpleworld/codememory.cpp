@@ -0,0 +1,103 @@
+/**
+ * @file simpleworld/codememory.cpp
+ * Memory subclass that get the data from the table Code.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/shared_array.hpp>
+#include <boost/scoped_array.hpp>
+
+#include <simpleworld/ints.hpp>
+#include <simpleworld/db/code.hpp>
+#include "codememory.hpp"
+
+namespace simpleworld
+{
+
+/**
+ * Constructor.
+ * @param db database.
+ * @param id id of the code.
+ * @param cache cache where the code is loaded from, or NULL to load it
+ * from the database.
+ * @exception DBException if there is an error with the query.
+ */
+CodeMemory::CodeMemory(db::DB* db, db::ID id, CodeCache* cache)
+  : cpu::Memory(0), db_(db), id_(id)
+{
+  if (cache == NULL) {
+    this->update();
+    return;
+  }
+
+  // the pages are shared with the image until they are written
+  this->image_ = cache->get(db, id);
+  Memory::copy(this->image_->memory);
+  this->saved_.copy(*this);
+}
+
+
+/**
+* Update the data from the database.
+* The changes not written to the database are lost.
+* @exception DBException if there is an error with the query.
+*/
+void CodeMemory::update()
+{
+  Uint32 size;
+  boost::shared_array<Uint8> data =
+    db::Code(this->db_, this->id_).data().read(&size);
+  Memory::copy(cpu::Memory(data.get(), size));
+  this->image_.reset();
+  this->saved_.copy(*this);
+}
+
+/**
+ * Write the memory to the database if it was changed.
+ * The rows that use the code must be changed to id() if it changes.
+ * @exception DBException if there is an error with the update.
+ */
+void CodeMemory::flush()
+{
+  if (not this->changed_())
+    return;
+
+  boost::scoped_array<Uint8> data(new Uint8[this->size_]);
+  this->read_(0, data.get(), this->size_);
+  this->id_ = db::Code(this->db_, this->id_).update(data.get(), this->size_);
+  this->image_.reset();
+  this->saved_.copy(*this);
+}
+
+
+/**
+ * Check if the memory has changed since it was read or written.
+ * @return true if the memory has changed, else false.
+ */
+bool CodeMemory::changed_() const
+{
+  if (this->size_ != this->saved_.size())
+    return true;
+
+  for (cpu::Address page = 0; page < this->pages_.size(); page++)
+    if (not this->shares_page(this->saved_, page))
+      return true;
+
+  return false;
+}
+
+}
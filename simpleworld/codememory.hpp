@@ -0,0 +1,103 @@
+/**
+ * @file simpleworld/codememory.hpp
+ * Memory subclass that get the data from the table Code.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEWORLD_CODEMEMORY_HPP
+#define SIMPLEWORLD_CODEMEMORY_HPP
+
+#include <boost/shared_ptr.hpp>
+
+#include <simpleworld/cpu/types.hpp>
+#include <simpleworld/cpu/memory.hpp>
+#include <simpleworld/db/types.hpp>
+#include <simpleworld/db/db.hpp>
+#include <simpleworld/codecache.hpp>
+
+namespace simpleworld
+{
+
+/**
+ * Memory subclass that get the data from the table Code.
+ * The code can be shared by several bugs and eggs, so the changes are made
+ * in memory and when flush() is called they are written copy on write:
+ * the id of the code changes if other rows use the old code.
+ * The memory has changed if a page is not shared with a copy of the
+ * memory made when it was read or written.
+ */
+class CodeMemory: public cpu::Memory
+{
+public:
+  /**
+   * Constructor.
+   * @param db database.
+   * @param id id of the code.
+   * @param cache cache where the code is loaded from, or NULL to load it
+   * from the database.
+   * @exception DBException if there is an error with the query.
+   */
+  CodeMemory(db::DB* db, db::ID id, CodeCache* cache = NULL);
+
+
+  /**
+   * Get the id of the code.
+   * It changes when the memory is written.
+   * @return the id of the code.
+   */
+  db::ID id() const { return this->id_; }
+
+  /**
+   * Get the code of the cache with the same data than the memory.
+   * It's NULL if the memory was not loaded from the cache or if it was
+   * written.
+   * @return the code.
+   */
+  const boost::shared_ptr<const CodeImage>& image() const
+  { return this->image_; }
+
+
+  /**
+  * Update the data from the database.
+  * The changes not written to the database are lost.
+  * @exception DBException if there is an error with the query.
+  */
+  void update();
+
+  /**
+   * Write the memory to the database if it was changed.
+   * The rows that use the code must be changed to id() if it changes.
+   * @exception DBException if there is an error with the update.
+   */
+  void flush();
+
+private:
+  db::DB* db_;                  /**< DB connection */
+  db::ID id_;                   /**< ID of the code */
+  boost::shared_ptr<const CodeImage> image_; /**< Code of the cache */
+  cpu::Memory saved_;           /**< Memory in the database */
+
+  /**
+   * Check if the memory has changed since it was read or written.
+   * @return true if the memory has changed, else false.
+   */
+  bool changed_() const;
+};
+
+}
+
+#endif // SIMPLEWORLD_CODEMEMORY_HPP
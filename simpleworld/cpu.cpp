@@ -18,13 +18,15 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <simpleworld/cpu/instruction.hpp>
+#include <algorithm>
+#include <cassert>
+
+#include <simpleworld/cpu/exception.hpp>
 
 #include "types.hpp"
 #include "isa.hpp"
 #include "cpu.hpp"
 #include "bug.hpp"
-#include "actionerror.hpp"
 
 namespace simpleworld
 {
@@ -38,45 +40,151 @@ namespace simpleworld
  */
 CPU::CPU(const cpu::ISA& isa, cpu::Memory* registers, cpu::Memory* memory,
          Bug* bug)
-  : cpu::CPU(isa, registers, memory), bug(bug)
+  : cpu::CPU(isa, registers, memory), bug(bug), yield_(YieldNone),
+    speculation_(SpeculationNone), cycles_(0), saved_running_(false),
+    saved_memory_(0)
 {
 }
 
 
+/**
+ * Execute some cycles (or until a stop instruction is found).
+ * The execution is also stopped by the world instructions, see
+ * yielded().
+ * @param cycles number of cycles to execute.
+ * @return cycles remaining (> 0 if the CPU was stopped.
+ */
+Uint8 CPU::execute(Uint16 cycles)
+{
+  this->execute_world_(cycles);
+
+  return cycles;
+}
+
 /**
 * Execute the next instruction.
 * @exception CPUException A stop instruction was found
 */
 void CPU::next()
 {
-  try {
-    cpu::CPU::next();
-  } catch (const ActionError& e) {
-    // invalid world command
-    cpu::Address addr = this->get_reg(REGISTER_PC);
-    this->interrupt(INTERRUPT_WORLDACTION, addr,
-                    cpu::Instruction(this->get_mem(addr, false)).data);
-  }
+  if (not this->running())
+    throw EXCEPTION(cpu::CPUException, "CPU stopped");
+
+  this->execute(1);
 }
 
 /**
- * Throw a interrupt.
+ * Throw a interrupt without exceptions.
+ * If the ip or the stack are not valid a Invalid Memory Location fault is
+ * stored and false is returned.
  * @param code the code of the interrupt.
  * @param g1 the word stored in g1.
  * @param g2 the word stored in g2.
- * @exception MemoryError if the ip is not valid.
+ * @return true if the interrupt was thrown or it's disabled, false if not.
  */
-void CPU::interrupt(Uint8 code, cpu::Word g1, cpu::Word g2)
+bool CPU::try_interrupt(Uint8 code, cpu::Word g1, cpu::Word g2)
 {
+  // the interrupt is thrown in the state before speculate()
+  this->restore();
+
   // interrupt the current action
-  if (this->interrupt_enabled(code) and not this->bug->is_null("action_time")) {
+  cpu::Word handler;
+  if (not this->interrupt_handler_(code, &handler))
+    return false;
+  if (handler != 0 and not this->bug->action_time_null()) {
     this->bug->set_null("action_time");
     this->set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionInterrupted));
 
-    return;
+    return true;
+  }
+
+  return cpu::CPU::try_interrupt(code, g1, g2);
+}
+
+
+/**
+ * Execute some cycles without changing anything outside of the CPU.
+ * The execution is stopped before the first world instruction and the
+ * state of the CPU before the execution is kept until resume() or
+ * restore() are called.
+ * It can be called at the same time in the CPUs of different bugs.
+ * @param cycles number of cycles to execute.
+ */
+void CPU::speculate(Uint16 cycles)
+{
+  assert(this->speculation_ == SpeculationNone);
+  // a interrupt would cancel the action, changing the bug
+  assert(this->bug->action_time_null());
+
+  std::copy(this->regs_, this->regs_ + TOTAL_REGISTERS, this->saved_regs_);
+  this->saved_running_ = this->running_;
+  // the pages are shared with the memory until they are written
+  this->saved_memory_.copy(*this->memory_);
+
+  this->speculation_ = SpeculationRunning;
+  try {
+    this->execute_world_(cycles);
+    // the world instruction is executed by resume()
+    this->speculation_ = this->yield_ == YieldDeferred ?
+      SpeculationYielded : SpeculationFinished;
+  } catch (const cpu::CPUException& e) {
+    this->error_ = e.info;
+    this->speculation_ = SpeculationFailed;
   }
+  this->cycles_ = cycles;
+}
 
-  cpu::CPU::interrupt(code, g1, g2);
+/**
+ * Finish the execution started by speculate().
+ * The world instruction where the execution was stopped is executed with
+ * the rest of the cycles.
+ * The execution can be stopped again by the world instruction, see
+ * yielded().
+ * @exception CPUException if the CPU was stopped by a critical error.
+ */
+void CPU::resume()
+{
+  assert(this->speculated());
+
+  Speculation speculation = this->speculation_;
+  this->speculation_ = SpeculationNone;
+  if (speculation == SpeculationYielded)
+    this->execute(this->cycles_);
+  else if (speculation == SpeculationFailed)
+    throw EXCEPTION(cpu::CPUException, this->error_);
+}
+
+/**
+ * Discard the execution done by speculate(), if any.
+ */
+void CPU::restore()
+{
+  if (not this->speculated())
+    return;
+
+  std::copy(this->saved_regs_, this->saved_regs_ + TOTAL_REGISTERS,
+            this->regs_);
+  this->update_window_();
+  this->running_ = this->saved_running_;
+  // the pages changed are still marked as changed in the database memory,
+  // so they are written again with the old data
+  this->memory_->copy(this->saved_memory_);
+  this->invalidate_cache();
+
+  this->speculation_ = SpeculationNone;
+}
+
+
+/**
+ * Execute some cycles (or until a stop instruction is found or the
+ * execution is stopped by a world instruction).
+ * @param cycles number of cycles to execute, updated with the cycles
+ * remaining.
+ */
+void CPU::execute_world_(Uint16& cycles)
+{
+  this->yield_ = YieldNone;
+  this->execute_(cycles);
 }
 
 }
@@ -21,6 +21,9 @@
 #ifndef SIMPLEWORLD_CPU_HPP
 #define SIMPLEWORLD_CPU_HPP
 
+#include <string>
+
+#include <simpleworld/cpu/types.hpp>
 #include <simpleworld/cpu/isa.hpp>
 #include <simpleworld/cpu/memory.hpp>
 #include <simpleworld/cpu/cpu.hpp>
@@ -33,6 +36,17 @@ class Bug;
 class CPU: public cpu::CPU
 {
 public:
+  /**
+   * Why the execution was stopped in a world instruction.
+   */
+  enum Yield {
+    YieldNone,                  /**< Not stopped in a world instruction */
+    YieldDeferred,              /**< The World is not used by speculate() */
+    YieldBlocked,               /**< The action can't be finished now */
+    YieldDeath                  /**< The bug died executing the action */
+  };
+
+
   /**
    * Constructor.
    * @param isa instruction set architecture of the CPU.
@@ -44,6 +58,17 @@ public:
       Bug* bug);
 
 
+  using cpu::CPU::execute;
+
+  /**
+   * Execute some cycles (or until a stop instruction is found).
+   * The execution is also stopped by the world instructions, see
+   * yielded().
+   * @param cycles number of cycles to execute.
+   * @return cycles remaining (> 0 if the CPU was stopped.
+   */
+  Uint8 execute(Uint16 cycles);
+
   /**
   * Execute the next instruction.
   * @exception CPUException A stop instruction was found
@@ -52,16 +77,107 @@ public:
 
 
   /**
-   * Throw a interrupt.
+   * Throw a interrupt without exceptions.
+   * If the ip or the stack are not valid a Invalid Memory Location fault is
+   * stored and false is returned.
    * @param code the code of the interrupt.
    * @param g1 the word stored in g1.
    * @param g2 the word stored in g2.
-   * @exception MemoryError if the ip is not valid.
+   * @return true if the interrupt was thrown or it's disabled, false if not.
+   */
+  bool try_interrupt(Uint8 code, cpu::Word g1 = 0, cpu::Word g2 = 0);
+
+
+  /**
+   * Why the last execution was stopped in a world instruction.
+   * @return the reason, YieldNone if it wasn't stopped.
+   */
+  Yield yielded() const { return this->yield_; }
+
+  /**
+   * Stop the execution in the current world instruction.
+   * The instruction is executed again in the next execution.
+   * @param yield why the execution is stopped.
+   * @return the update that stops the execution.
+   */
+  cpu::Update yield(Yield yield)
+  {
+    this->yield_ = yield;
+    return cpu::UpdateYield;
+  }
+
+
+  /**
+   * Execute some cycles without changing anything outside of the CPU.
+   * The execution is stopped before the first world instruction and the
+   * state of the CPU before the execution is kept until resume() or
+   * restore() are called.
+   * It can be called at the same time in the CPUs of different bugs.
+   * @param cycles number of cycles to execute.
    */
-  void interrupt(Uint8 code, cpu::Word g1 = 0, cpu::Word g2 = 0);
+  void speculate(Uint16 cycles);
+
+  /**
+   * Check if there is a execution of speculate() not resumed or restored.
+   * @return true if there is a execution, else false.
+   */
+  bool speculated() const
+  { return this->speculation_ != SpeculationNone and
+      this->speculation_ != SpeculationRunning; }
+
+  /**
+   * Check if speculate() is being executed.
+   * @return true if it's being executed, else false.
+   */
+  bool speculating() const
+  { return this->speculation_ == SpeculationRunning; }
+
+  /**
+   * Finish the execution started by speculate().
+   * The world instruction where the execution was stopped is executed with
+   * the rest of the cycles.
+   * The execution can be stopped again by the world instruction, see
+   * yielded().
+   * @exception CPUException if the CPU was stopped by a critical error.
+   */
+  void resume();
+
+  /**
+   * Discard the execution done by speculate(), if any.
+   */
+  void restore();
 
 
   Bug* bug;
+
+private:
+  /**
+   * State of the execution of speculate().
+   */
+  enum Speculation {
+    SpeculationNone,            /**< Not executed */
+    SpeculationRunning,         /**< Being executed */
+    SpeculationYielded,         /**< Stopped in a world instruction */
+    SpeculationFinished,        /**< All the cycles executed */
+    SpeculationFailed           /**< Stopped by a critical error */
+  };
+
+  Yield yield_;                 /**< Why the last execution was stopped */
+  Speculation speculation_;
+  Uint16 cycles_;               /**< Cycles not executed by speculate() */
+  std::string error_;           /**< Critical error found by speculate() */
+  cpu::Word saved_regs_[TOTAL_REGISTERS]; /**< Registers before speculate() */
+  bool saved_running_;          /**< State before speculate() */
+  cpu::Memory saved_memory_;    /**< Memory before speculate() */
+
+
+  /**
+   * Execute some cycles (or until a stop instruction is found or the
+   * execution is stopped by a world instruction).
+   * @param cycles number of cycles to execute, updated with the cycles
+   * remaining.
+   */
+  void execute_world_(Uint16& cycles);
 };
 
 }
@@ -21,10 +21,13 @@
 
 #ifdef DEBUG
 #include <iostream>
-#include <boost/format.hpp>
 #endif
 
-#include "codeerror.hpp"
+#include <boost/format.hpp>
+
+#include <simpleworld/config.hpp>
+
+#include "word.hpp"
 #include "memoryerror.hpp"
 #include "cpu.hpp"
 
@@ -40,12 +43,29 @@ namespace cpu
  * @param memory memory of the CPU.
  */
 CPU::CPU(const ISA& isa, Memory* registers, Memory* memory)
-  : isa_(isa), registers_(registers), memory_(memory), running_(true)
+  : isa_(isa), registers_(registers), memory_(memory), running_(true),
+    fault_code_(0), fault_data_(0)
 {
   // space for all the registers (global registers + windowed registers)
   Address min_size = (TOTAL_REGISTERS) * sizeof(Word);
   if (this->registers_->size() < min_size)
     this->registers_->resize(min_size);
+
+  this->load_registers();
+}
+
+
+/**
+ * Registers of the CPU.
+ * @return the registers.
+ */
+const Memory CPU::registers() const
+{
+  Memory registers(*this->registers_);
+  for (Uint8 i = 0; i < TOTAL_REGISTERS; i++)
+    registers.set_word(ADDRESS(i), this->regs_[i]);
+
+  return registers;
 }
 
 
@@ -56,6 +76,8 @@ void CPU::execute()
 {
   while (this->running())
     this->next();
+
+  this->save_registers();
 }
 
 /**
@@ -65,11 +87,8 @@ void CPU::execute()
  */
 Uint8 CPU::execute(Uint16 cycles)
 {
-  while (this->running() and (cycles > 0)) {
-    this->next();
-
-    cycles--;
-  }
+  this->execute_(cycles);
+  this->save_registers();
 
   return cycles;
 }
@@ -83,173 +102,54 @@ void CPU::next()
   if (not this->running_)
     throw EXCEPTION(CPUException, "CPU stopped");
 
-  Instruction instruction;
-  try {
-    instruction = this->fetch_instruction_();
-    InstructionInfo info = this->isa_.instruction_info(instruction.code);
-#ifdef DEBUG
-    std::cout << boost::str(boost::format("\
-Instruction info:\tcode: 0x%02X, name: %s, nregs: %d, has_i: %d")
-                            % static_cast<int>(info.code)
-                            % info.name
-                            % static_cast<int>(info.nregs)
-                            % static_cast<int>(info.has_inmediate))
-                            << std::endl;
-#endif
-
-    switch (info.func(*this, instruction)) {
-    case UpdatePC:
-      // Update PC
-      this->registers_->set_word(ADDRESS(REGISTER_PC),
-                                 this->registers_->get_word(ADDRESS(REGISTER_PC)) + sizeof(Word));
-      break;
-    case UpdateInterrupt:
-      // Throw a interrupt
-      break;
-    case UpdateStop:
-      this->running_ = false;
-      break;
-    case UpdateNone:
-      break;
-    }
-  } catch (const CodeError& exc) {
-    // If the pc or the ip are out of range, the error is critical and
-    // the CPU must be stopped
-    this->interrupt(INTERRUPT_INSTRUCTION,
-                    this->registers_->get_word(ADDRESS(REGISTER_PC)),
-                    instruction.code);
-  } catch (const MemoryError& exc) {
-    // If the pc or the ip are out of range, then the error is critical and
-    // the CPU must be stopped
-    this->interrupt(INTERRUPT_MEMORY,
-                    this->registers_->get_word(ADDRESS(REGISTER_PC)),
-                    exc.address);
-  }
+  Uint16 cycles = 1;
+  this->execute_(cycles);
+  this->save_registers();
 }
 
 
 /**
- * Get the value of a register.
- * @param reg the register.
- * @param system_endian if the address must be in the system endianness
- * @return the value of the register.
- */
-Word CPU::get_reg(Uint8 reg, bool system_endian) const
-{
-  if (reg >= GLOBAL_REGISTERS) {
-    Uint32 window = this->registers_->get_word(ADDRESS(REGISTER_WC));
-    if (window >= REGISTER_WINDOWS)
-      window = REGISTER_WINDOWS - 1;
-    reg += window * REGISTERS_PER_WINDOW;
-  }
-
-  return this->registers_->get_word(ADDRESS(reg), system_endian);
-}
-
-/**
- * Set the value of a register.
- * @param reg the register.
- * @param word the new value.
- * @param system_endian if the address must be in the system endianness
- */
-void CPU::set_reg(Uint8 reg, Word word, bool system_endian)
-{
-  if (reg >= GLOBAL_REGISTERS) {
-    Uint32 window = this->registers_->get_word(ADDRESS(REGISTER_WC));
-    if (window >= REGISTER_WINDOWS)
-      window = REGISTER_WINDOWS - 1;
-    reg += window * REGISTERS_PER_WINDOW;
-  }
-
-  this->registers_->set_word(ADDRESS(reg), word, system_endian); 
-}
-
-/**
- * Get the value of a address of memory.
- * @param addr the address of the memory.
- * @param system_endian if the address must be in the system endianness
- * @return the value of the address of memory.
- */
-Word CPU::get_mem(Address addr, bool system_endian) const
-{
-  return this->memory_->get_word(addr, system_endian);
-}
-
-/**
- * Get the value of a address of memory.
- * @param addr the address of the memory.
- * @param system_endian if the address must be in the system endianness
- * @return the value of the address of memory.
- */
-HalfWord CPU::get_halfmem(Address addr, bool system_endian) const
-{
-  return this->memory_->get_halfword(addr, system_endian);
-}
-
-/**
- * Get the value of a address of memory.
- * @param addr the address of the memory.
- * @return the value of the address of memory.
- */
-QuarterWord CPU::get_quartermem(Address addr) const
-{
-  return this->memory_->get_quarterword(addr);
-}
-
-/**
- * Set the value of a address of memory.
- * @param addr the address of the memory.
- * @param word the new value.
- * @param system_endian if the address must be in the system endianness
- */
-void CPU::set_mem(Address addr, Word word, bool system_endian)
-{
-  this->memory_->set_word(addr, word, system_endian);
-}
-
-/**
- * Set the value of a address of memory.
- * @param addr the address of the memory.
- * @param word the new value.
- * @param system_endian if the address must be in the system endianness
- */
-void CPU::set_halfmem(Address addr, HalfWord word, bool system_endian)
-{
-  this->memory_->set_halfword(addr, word, system_endian);
-}
-
-/**
- * Set the value of a address of memory.
- * @param addr the address of the memory.
- * @param word the new value.
+ * Throw a interrupt.
+ * @param code the code of the interrupt.
+ * @param g1 the word stored in g1.
+ * @param g2 the word stored in g2.
+ * @exception MemoryError if the ip or the stack are not valid.
  */
-void CPU::set_quartermem(Address addr, QuarterWord word)
+void CPU::interrupt(Uint8 code, Word g1, Word g2)
 {
-  this->memory_->set_quarterword(addr, word);
+  if (not this->try_interrupt(code, g1, g2))
+    throw EXCEPTION1(MemoryError, boost::str(boost::format("\
+Address 0x%08X is out of range")
+                                             % this->fault_data_),
+                     this->fault_data_);
 }
 
-
 /**
- * Throw a interrupt.
+ * Throw a interrupt without exceptions.
+ * If the ip or the stack are not valid a Invalid Memory Location fault is
+ * stored and false is returned.
  * @param code the code of the interrupt.
  * @param g1 the word stored in g1.
  * @param g2 the word stored in g2.
- * @exception MemoryError if the ip is not valid.
+ * @return true if the interrupt was thrown or it's disabled, false if not.
  */
-void CPU::interrupt(Uint8 code, Word g1, Word g2)
+bool CPU::try_interrupt(Uint8 code, Word g1, Word g2)
 {
   // If there isn't enough space in the stack to store all the registers,
-  // then a MemoryError exception is thrown.
-  // This error is critical because no more interrupts can be thrown, so
-  // the CPU must be stopped.
+  // then false is returned.
+  // This error is critical if the interrupt is thrown by the CPU because
+  // no more interrupts can be thrown, so the CPU must be stopped.
 
   // Update pc if the interrupt is thrown by a instruction.
   if (this->isa_.interrupt_info(code).thrown_by_inst)
-    this->registers_->set_word(ADDRESS(REGISTER_PC),
-                               this->registers_->get_word(ADDRESS(REGISTER_PC)) + sizeof(Word));
+    this->regs_[REGISTER_PC] += sizeof(Word);
+
 
+  Word handler;
+  if (not this->interrupt_handler_(code, &handler))
+    return false;
 
-  if (not this->interrupt_enabled(code)) {
+  if (handler == 0) {
 #ifdef DEBUG
     std::cout << boost::str(boost::format("\
 Interrupt couldn't be thrown:\tcode: 0x%02X, name: %s")
@@ -258,7 +158,7 @@ Interrupt couldn't be thrown:\tcode: 0x%02X, name: %s")
                             << std::endl;
 #endif
 
-    return;
+    return true;
   }
 
 #ifdef DEBUG
@@ -269,52 +169,56 @@ Interrupt thrown:\tcode: 0x%02X, name: %s")
             << std::endl;
 #endif
 
-  Word handler =
-    this->memory_->get_word(this->registers_->get_word(ADDRESS(REGISTER_IP)) +
-                            ADDRESS(code));
-
   // Save the global registers in the stack
-  Word sp = this->registers_->get_word(ADDRESS(REGISTER_SP));
-  this->memory_->set_word(sp, this->registers_->get_word(ADDRESS(REGISTER_IP)));
+  Word sp = this->regs_[REGISTER_SP];
+  if (not this->store_mem(sp, this->regs_[REGISTER_IP]))
+    return false;
   sp += sizeof(Word);
-  this->memory_->set_word(sp, this->registers_->get_word(ADDRESS(REGISTER_G0)));
+  if (not this->store_mem(sp, this->regs_[REGISTER_G0]))
+    return false;
   sp += sizeof(Word);
-  this->memory_->set_word(sp, this->registers_->get_word(ADDRESS(REGISTER_G1)));
+  if (not this->store_mem(sp, this->regs_[REGISTER_G1]))
+    return false;
   sp += sizeof(Word);
-  this->memory_->set_word(sp, this->registers_->get_word(ADDRESS(REGISTER_G2)));
+  if (not this->store_mem(sp, this->regs_[REGISTER_G2]))
+    return false;
   sp += sizeof(Word);
-  this->memory_->set_word(sp, this->registers_->get_word(ADDRESS(REGISTER_G3)));
+  if (not this->store_mem(sp, this->regs_[REGISTER_G3]))
+    return false;
   sp += sizeof(Word);
   // Update stack pointer
-  this->registers_->set_word(ADDRESS(REGISTER_SP), sp);
+  this->regs_[REGISTER_SP] = sp;
 
   // Update the wc register
-  Word wc = this->registers_->get_word(ADDRESS(REGISTER_WC));
+  Word wc = this->regs_[REGISTER_WC];
   if (wc >= (REGISTER_WINDOWS - 1))
     // Save the local registers in the stack
     for (Sint8 i = GLOBAL_REGISTERS;
          i < GLOBAL_REGISTERS + REGISTERS_PER_WINDOW;
          i++) {
       // Save the register in the top of the stack
-      this->memory_->set_word(sp, this->get_reg(i));
+      if (not this->store_mem(sp, this->get_reg(i)))
+        return false;
       // Update stack pointer
       sp += sizeof(Word);
     }
   // Update stack pointer
-  this->registers_->set_word(ADDRESS(REGISTER_SP), sp);
-  this->registers_->set_word(ADDRESS(REGISTER_WC), wc + 1);
+  this->regs_[REGISTER_SP] = sp;
+  this->set_reg(REGISTER_WC, wc + 1);
 
   // Update the link register and the frame pointer
-  this->set_reg(REGISTER_LR, this->registers_->get_word(ADDRESS(REGISTER_PC)));
-  this->set_reg(REGISTER_FP, this->registers_->get_word(ADDRESS(REGISTER_SP)));
+  this->set_reg(REGISTER_LR, this->regs_[REGISTER_PC]);
+  this->set_reg(REGISTER_FP, this->regs_[REGISTER_SP]);
 
   // Store the information of the interrupt
-  this->registers_->set_word(ADDRESS(REGISTER_G0), code);
-  this->registers_->set_word(ADDRESS(REGISTER_G1), g1);
-  this->registers_->set_word(ADDRESS(REGISTER_G2), g2);
+  this->regs_[REGISTER_G0] = code;
+  this->regs_[REGISTER_G1] = g1;
+  this->regs_[REGISTER_G2] = g2;
 
   // Execute the interrupt handler
-  this->registers_->set_word(ADDRESS(REGISTER_PC), handler);
+  this->regs_[REGISTER_PC] = handler;
+
+  return true;
 }
 
 /**
@@ -327,6 +231,85 @@ void CPU::timer_interrupt()
 }
 
 
+/**
+ * Discard the decoded instructions.
+ * It must be called when the memory is changed without using the CPU.
+ */
+void CPU::invalidate_cache()
+{
+  this->shared_.reset();
+  this->decoded_.clear();
+}
+
+/**
+ * Use instructions decoded by other CPU, or by decode(), with the same
+ * memory.
+ * The instructions are shared until the memory is changed using the
+ * CPU, then they are copied.
+ * @param decoded the instructions decoded.
+ */
+void CPU::share_cache(const boost::shared_ptr<const DecodedCode>& decoded)
+{
+  this->shared_ = decoded;
+  this->decoded_.clear();
+}
+
+/**
+ * Decode all the instructions of a memory.
+ * The words that are not valid instructions are not decoded.
+ * @param isa instruction set architecture.
+ * @param memory the memory.
+ * @param decoded where to store the instructions decoded.
+ */
+void CPU::decode(const ISA& isa, const Memory& memory, DecodedCode* decoded)
+{
+  decoded->resize(memory.size() / sizeof(Word));
+  for (Address index = 0; index < decoded->size(); index++) {
+    DecodedInstruction& entry = (*decoded)[index];
+    entry.instruction = Instruction(memory.get_word(ADDRESS(index)), true);
+    const InstructionInfo* info = isa.find_instruction(entry.instruction.code);
+    entry.func = info == NULL ? NULL : info->func;
+  }
+}
+
+
+/**
+ * Read the registers from the registers memory.
+ * It must be called when the registers memory is changed without using
+ * the CPU.
+ */
+void CPU::load_registers()
+{
+  for (Uint8 i = 0; i < TOTAL_REGISTERS; i++)
+    this->regs_[i] = this->registers_->get_word(ADDRESS(i));
+
+  this->update_window_();
+}
+
+/**
+ * Write the registers that have changed to the registers memory.
+ */
+void CPU::save_registers()
+{
+  for (Uint8 i = 0; i < TOTAL_REGISTERS; i++)
+    if (this->registers_->get_word(ADDRESS(i)) != this->regs_[i])
+      this->registers_->set_word(ADDRESS(i), this->regs_[i]);
+}
+
+
+/**
+ * Update the registers of the current window.
+ */
+void CPU::update_window_()
+{
+  Word window = this->regs_[REGISTER_WC];
+  if (window >= REGISTER_WINDOWS)
+    window = REGISTER_WINDOWS - 1;
+
+  this->window_ = this->regs_ + window * REGISTERS_PER_WINDOW;
+}
+
+
 /**
  * Decode the current instruction.
  * @return the current instruction decoded.
@@ -336,34 +319,217 @@ Instruction CPU::fetch_instruction_() const
 {
 #ifdef DEBUG
   std::cout << boost::str(boost::format("Instruction[0x%08X]: 0x%08X")
-    % this->registers_->get_word(ADDRESS(REGISTER_PC))
-    % this->memory_->get_word(this->registers_->get_word(ADDRESS(REGISTER_PC))))
+    % this->regs_[REGISTER_PC]
+    % this->memory_->get_word(this->regs_[REGISTER_PC]))
     << std::endl;
 #endif
-  return Instruction(this->memory_->get_word(this->registers_->get_word(ADDRESS(REGISTER_PC)), false));
+  return Instruction(this->memory_->get_word(this->regs_[REGISTER_PC]), true);
+}
+
+/**
+ * Decode the current instruction using the decoded instructions.
+ * If pc is out of range or the instruction is not found, the fault is
+ * stored and a operation that returns UpdateFault is returned.
+ * @param instruction where to store the current instruction.
+ * @return the function that executes the operation.
+ */
+Operation CPU::decode_instruction_(Instruction& instruction)
+{
+  Address pc = this->regs_[REGISTER_PC];
+  Address index = pc / sizeof(Word);
+  bool aligned = pc % sizeof(Word) == 0;
+
+  // The memory could be resized without using the CPU
+  Address words = this->memory_->size() / sizeof(Word);
+  if (this->shared_ and this->shared_->size() != words)
+    this->shared_.reset();
+  if (not this->shared_ and this->decoded_.size() != words) {
+    DecodedInstruction empty = {Instruction(), NULL};
+    this->decoded_.assign(words, empty);
+  }
+
+  const DecodedCode& decoded = this->shared_ ? *this->shared_ :
+    this->decoded_;
+  if (aligned and index < decoded.size() and decoded[index].func != NULL) {
+    instruction = decoded[index].instruction;
+    return decoded[index].func;
+  }
+
+  if (not this->check_mem(pc))
+    return CPU::fault_instruction_;
+
+  instruction = this->fetch_instruction_();
+  const InstructionInfo* info = this->isa_.find_instruction(instruction.code);
+  if (info == NULL) {
+    this->fault_(INTERRUPT_INSTRUCTION, instruction.code);
+    return CPU::fault_instruction_;
+  }
+#ifdef DEBUG
+  std::cout << boost::str(boost::format("\
+Instruction info:\tcode: 0x%02X, name: %s, nregs: %d, has_i: %d")
+                          % static_cast<int>(info->code)
+                          % info->name
+                          % static_cast<int>(info->nregs)
+                          % static_cast<int>(info->has_inmediate))
+                          << std::endl;
+#endif
+
+  // the shared instructions are not changed
+  if (aligned and not this->shared_) {
+    this->decoded_[index].instruction = instruction;
+    this->decoded_[index].func = info->func;
+  }
+
+  return info->func;
+}
+
+/**
+ * Operation of the instructions that couldn't be decoded.
+ * The CPU and the instruction are not used.
+ * @return UpdateFault.
+ */
+Update CPU::fault_instruction_(CPU&, Instruction)
+{
+  return UpdateFault;
+}
+
+/**
+ * Execute some cycles (or until a stop instruction is found or a
+ * instruction returns UpdateYield).
+ * The faults of the instructions are converted to interrupts without
+ * exceptions.
+ * @param cycles number of cycles to execute, updated with the cycles
+ * remaining.
+ * @exception MemoryError if the interrupt of a fault can't be thrown.
+ */
+void CPU::execute_(Uint16& cycles)
+{
+  Instruction instruction;
+
+#if defined(__GNUC__)
+  // Threaded code: jump directly to the code of the update
+  static void* const updates[] = {
+    &&update_none,              // UpdateNone
+    &&update_pc,                // UpdatePC
+    &&update_interrupt,         // UpdateInterrupt
+    &&update_stop,              // UpdateStop
+    &&update_fault,             // UpdateFault
+    &&update_yield              // UpdateYield
+  };
+
+  if (not this->running_)
+    return;
+
+ next:
+  if (cycles == 0)
+    return;
+  goto *updates[this->decode_instruction_(instruction)(*this, instruction)];
+
+ update_pc:
+  this->regs_[REGISTER_PC] += sizeof(Word);
+ update_interrupt:
+ update_none:
+  cycles--;
+  goto next;
+
+ update_fault:
+  // If the pc or the ip are out of range, then the error is critical and
+  // the CPU must be stopped
+  cycles--;
+  this->interrupt(this->fault_code_, this->regs_[REGISTER_PC],
+                  this->fault_data_);
+  if (this->running_)
+    goto next;
+  return;
+
+ update_stop:
+  cycles--;
+  this->running_ = false;
+ update_yield:
+  return;
+#else
+  while (this->running_ and cycles > 0) {
+    switch (this->decode_instruction_(instruction)(*this, instruction)) {
+    case UpdatePC:
+      // Update PC
+      this->regs_[REGISTER_PC] += sizeof(Word);
+      break;
+    case UpdateInterrupt:
+      // Throw a interrupt
+      break;
+    case UpdateStop:
+      cycles--;
+      this->running_ = false;
+      return;
+    case UpdateFault:
+      // If the pc or the ip are out of range, then the error is critical
+      // and the CPU must be stopped
+      this->interrupt(this->fault_code_, this->regs_[REGISTER_PC],
+                      this->fault_data_);
+      break;
+    case UpdateYield:
+      return;
+    case UpdateNone:
+      break;
+    }
+
+    cycles--;
+  }
+#endif
+}
+
+/**
+ * Discard the decoded instructions of a region of memory.
+ * @param addr the address of the memory.
+ * @param size size of the region.
+ */
+void CPU::invalidate_cache_(Address addr, Address size)
+{
+  Address last = (addr + size - 1) / sizeof(Word);
+
+  // copy the shared instructions only if a decoded one is changed
+  if (this->shared_) {
+    bool decoded = false;
+    for (Address index = addr / sizeof(Word);
+         index <= last and index < this->shared_->size();
+         index++)
+      if ((*this->shared_)[index].func != NULL)
+        decoded = true;
+    if (not decoded)
+      return;
+
+    this->decoded_ = *this->shared_;
+    this->shared_.reset();
+  }
+
+  for (Address index = addr / sizeof(Word);
+       index <= last and index < this->decoded_.size();
+       index++)
+    this->decoded_[index].func = NULL;
 }
 
 
 /**
- * Check if the interrupt is enabled.
+ * Get the handler of a interrupt.
  * @param code Interrupt to check.
- * @return true if the interrupt is enabled, not if not.
+ * @param handler where to store the address of the handler, 0 if the
+ * interrupt is not enabled.
+ * @return true if the ip is valid, false if a fault was stored.
  * @exception CPUexception if the interrupt is not found.
- * @exception MemoryError if the ip is not valid.
  */
-bool CPU::interrupt_enabled(Uint8 code) const
+bool CPU::interrupt_handler_(Uint8 code, Word* handler)
 {
-  // If the region pointed by the ip is not valid, then a MemoryError
-  // exception is thrown.
+  // If the region pointed by the ip is not valid, then false is returned.
   // This error is critical because no more interrupts can be thrown, so
   // the CPU must be stopped.
 
-  Word ip = this->registers_->get_word(ADDRESS(REGISTER_IP));
-  if (ip == 0)
-    return false;
+  Word ip = this->regs_[REGISTER_IP];
+  if (ip == 0) {
+    *handler = 0;
+    return true;
+  }
 
-  Word handler = this->memory_->get_word(ip + ADDRESS(code));
-  return handler != 0;
+  return this->load_mem(ip + ADDRESS(code), handler);
 }
 
 }
@@ -23,9 +23,14 @@
 #define SIMPLEWORLD_CPU_CPU_HPP
 
 #include <string>
+#include <vector>
 
+#include <boost/shared_ptr.hpp>
+
+#include <simpleworld/config.hpp>
 #include <simpleworld/ints.hpp>
 #include <simpleworld/cpu/types.hpp>
+#include <simpleworld/cpu/word.hpp>
 #include <simpleworld/cpu/instruction.hpp>
 #include <simpleworld/cpu/isa.hpp>
 #include <simpleworld/cpu/memory.hpp>
@@ -48,6 +53,21 @@ namespace cpu
 class CPU
 {
 public:
+  /**
+   * Instruction already decoded.
+   * func is NULL if the word has not been decoded.
+   */
+  struct DecodedInstruction {
+    Instruction instruction;    /**< Instruction */
+    Operation func;             /**< Function that execute the operation */
+  };
+
+  /**
+   * Instructions decoded, a entry for each word of the memory.
+   */
+  typedef std::vector<DecodedInstruction> DecodedCode;
+
+
   /**
    * Constructor.
    * @param isa instruction set architecture of the CPU.
@@ -72,7 +92,7 @@ public:
    * Registers of the CPU.
    * @return the registers.
    */
-  const Memory registers() const { return *this->registers_; }
+  const Memory registers() const;
 
   /**
    * Memory of the CPU.
@@ -87,6 +107,13 @@ public:
    */
   bool running() const { return this->running_; }
 
+  /**
+   * Set if the CPU is running.
+   * It's used to restore the state of a CPU that was stopped.
+   * @param running true if the CPU is running, false if not
+   */
+  void running(bool running) { this->running_ = running; }
+
 
   /**
    * Execute all the code until a stop instruction is found.
@@ -98,7 +125,7 @@ public:
    * @param cycles number of cycles to execute.
    * @return cycles remaining (> 0 if the CPU was stopped.
    */
-  Uint8 execute(Uint16 cycles);
+  virtual Uint8 execute(Uint16 cycles);
 
   /**
    * Execute the next instruction.
@@ -114,7 +141,18 @@ public:
    * @param system_endian if the address must be in the system endianness
    * @return the value of the register.
    */
-  Word get_reg(Uint8 reg, bool system_endian = true) const;
+  Word get_reg(Uint8 reg, bool system_endian = true) const
+  {
+    Word word = (reg >= GLOBAL_REGISTERS) ?
+      this->window_[reg] : this->regs_[reg];
+
+#ifdef IS_LITTLE_ENDIAN
+    if (not system_endian)
+      word = change_byte_order(word);
+#endif
+
+    return word;
+  }
 
   /**
    * Set the value of a register.
@@ -122,7 +160,21 @@ public:
    * @param word the new value.
    * @param system_endian if the address must be in the system endianness
    */
-  void set_reg(Uint8 reg, Word word, bool system_endian = true);
+  void set_reg(Uint8 reg, Word word, bool system_endian = true)
+  {
+#ifdef IS_LITTLE_ENDIAN
+    if (not system_endian)
+      word = change_byte_order(word);
+#endif
+
+    if (reg >= GLOBAL_REGISTERS)
+      this->window_[reg] = word;
+    else {
+      this->regs_[reg] = word;
+      if (reg == REGISTER_WC)
+        this->update_window_();
+    }
+  }
 
   /**
    * Get the value of a address of memory.
@@ -130,7 +182,8 @@ public:
    * @param system_endian if the address must be in the system endianness
    * @return the value of the address of memory.
    */
-  Word get_mem(Address addr, bool system_endian = true) const;
+  Word get_mem(Address addr, bool system_endian = true) const
+  { return this->memory_->get_word(addr, system_endian); }
 
   /**
    * Get the value of a address of memory.
@@ -138,14 +191,16 @@ public:
    * @param system_endian if the address must be in the system endianness
    * @return the value of the address of memory.
    */
-  HalfWord get_halfmem(Address addr, bool system_endian = true) const;
+  HalfWord get_halfmem(Address addr, bool system_endian = true) const
+  { return this->memory_->get_halfword(addr, system_endian); }
 
   /**
    * Get the value of a address of memory.
    * @param addr the address of the memory.
    * @return the value of the address of memory.
    */
-  QuarterWord get_quartermem(Address addr) const;
+  QuarterWord get_quartermem(Address addr) const
+  { return this->memory_->get_quarterword(addr); }
 
   /**
    * Set the value of a address of memory.
@@ -153,7 +208,11 @@ public:
    * @param word the new value.
    * @param system_endian if the address must be in the system endianness
    */
-  void set_mem(Address addr, Word word, bool system_endian = true);
+  void set_mem(Address addr, Word word, bool system_endian = true)
+  {
+    this->memory_->set_word(addr, word, system_endian);
+    this->invalidate_cache_(addr, sizeof(Word));
+  }
 
   /**
    * Set the value of a address of memory.
@@ -161,14 +220,162 @@ public:
    * @param word the new value.
    * @param system_endian if the address must be in the system endianness
    */
-  void set_halfmem(Address addr, HalfWord word, bool system_endian = true);
+  void set_halfmem(Address addr, HalfWord word, bool system_endian = true)
+  {
+    this->memory_->set_halfword(addr, word, system_endian);
+    this->invalidate_cache_(addr, sizeof(HalfWord));
+  }
 
   /**
    * Set the value of a address of memory.
    * @param addr the address of the memory.
    * @param word the new value.
    */
-  void set_quartermem(Address addr, QuarterWord word);
+  void set_quartermem(Address addr, QuarterWord word)
+  {
+    this->memory_->set_quarterword(addr, word);
+    this->invalidate_cache_(addr, sizeof(QuarterWord));
+  }
+
+
+  // Basic operations of the CPU without exceptions.
+  // If the address is out of range a Invalid Memory Location fault is
+  // stored and false is returned, the operation must stop and return
+  // UpdateFault.
+  /**
+   * Get the value of a register that is not a operand of 4 bits, like the
+   * one stored in the data of a instruction.
+   * The address of the register in the registers memory is stored in the
+   * fault if the register is out of range.
+   * @param reg the register.
+   * @param word where to store the value of the register.
+   * @return true if the register is valid, false if not.
+   */
+  bool load_reg(Uint8 reg, Word* word)
+  {
+    Uint32 index = (reg >= GLOBAL_REGISTERS) ?
+      static_cast<Uint32>(this->window_ - this->regs_) + reg : reg;
+    if (index >= TOTAL_REGISTERS) {
+      this->fault_(INTERRUPT_MEMORY, ADDRESS(index));
+      return false;
+    }
+
+    *word = this->regs_[index];
+    return true;
+  }
+
+  /**
+   * Check if a address of memory is valid.
+   * @param addr the address of the memory.
+   * @return true if the address is valid, false if not.
+   */
+  bool check_mem(Address addr)
+  {
+    if (not this->memory_->valid(addr, sizeof(Word))) {
+      this->fault_(INTERRUPT_MEMORY, addr);
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Get the value of a address of memory.
+   * @param addr the address of the memory.
+   * @param word where to store the value of the address of memory.
+   * @return true if the address is valid, false if not.
+   */
+  bool load_mem(Address addr, Word* word)
+  {
+    if (not this->check_mem(addr))
+      return false;
+
+    *word = this->memory_->get_word(addr);
+    return true;
+  }
+
+  /**
+   * Get the value of a address of memory.
+   * @param addr the address of the memory.
+   * @param word where to store the value of the address of memory.
+   * @return true if the address is valid, false if not.
+   */
+  bool load_halfmem(Address addr, HalfWord* word)
+  {
+    if (not this->memory_->valid(addr, sizeof(HalfWord))) {
+      this->fault_(INTERRUPT_MEMORY, addr);
+      return false;
+    }
+
+    *word = this->memory_->get_halfword(addr);
+    return true;
+  }
+
+  /**
+   * Get the value of a address of memory.
+   * @param addr the address of the memory.
+   * @param word where to store the value of the address of memory.
+   * @return true if the address is valid, false if not.
+   */
+  bool load_quartermem(Address addr, QuarterWord* word)
+  {
+    if (not this->memory_->valid(addr, sizeof(QuarterWord))) {
+      this->fault_(INTERRUPT_MEMORY, addr);
+      return false;
+    }
+
+    *word = this->memory_->get_quarterword(addr);
+    return true;
+  }
+
+  /**
+   * Set the value of a address of memory.
+   * @param addr the address of the memory.
+   * @param word the new value.
+   * @return true if the address is valid, false if not.
+   */
+  bool store_mem(Address addr, Word word)
+  {
+    if (not this->check_mem(addr))
+      return false;
+
+    this->set_mem(addr, word);
+    return true;
+  }
+
+  /**
+   * Set the value of a address of memory.
+   * @param addr the address of the memory.
+   * @param word the new value.
+   * @return true if the address is valid, false if not.
+   */
+  bool store_halfmem(Address addr, HalfWord word)
+  {
+    if (not this->memory_->valid(addr, sizeof(HalfWord))) {
+      this->fault_(INTERRUPT_MEMORY, addr);
+      return false;
+    }
+
+    this->set_halfmem(addr, word);
+    return true;
+  }
+
+  /**
+   * Set the value of a address of memory.
+   * @param addr the address of the memory.
+   * @param word the new value.
+   * @return true if the address is valid, false if not.
+   */
+  bool store_quartermem(Address addr, QuarterWord word)
+  {
+    if (not this->memory_->valid(addr, sizeof(QuarterWord))) {
+      this->fault_(INTERRUPT_MEMORY, addr);
+      return false;
+    }
+
+    this->set_quartermem(addr, word);
+    return true;
+  }
 
 
   /**
@@ -176,9 +383,20 @@ public:
    * @param code the code of the interrupt.
    * @param g1 the word stored in g1.
    * @param g2 the word stored in g2.
-   * @exception MemoryError if the ip is not valid.
+   * @exception MemoryError if the ip or the stack are not valid.
+   */
+  void interrupt(Uint8 code, Word g1 = 0, Word g2 = 0);
+
+  /**
+   * Throw a interrupt without exceptions.
+   * If the ip or the stack are not valid a Invalid Memory Location fault is
+   * stored and false is returned.
+   * @param code the code of the interrupt.
+   * @param g1 the word stored in g1.
+   * @param g2 the word stored in g2.
+   * @return true if the interrupt was thrown or it's disabled, false if not.
    */
-  virtual void interrupt(Uint8 code, Word g1 = 0, Word g2 = 0);
+  virtual bool try_interrupt(Uint8 code, Word g1 = 0, Word g2 = 0);
 
   /**
    * Throw the Timer Interrupt.
@@ -186,6 +404,45 @@ public:
    */
   void timer_interrupt();
 
+
+  /**
+   * Discard the decoded instructions.
+   * It must be called when the memory is changed without using the CPU.
+   */
+  void invalidate_cache();
+
+  /**
+   * Use instructions decoded by other CPU, or by decode(), with the same
+   * memory.
+   * The instructions are shared until the memory is changed using the
+   * CPU, then they are copied.
+   * @param decoded the instructions decoded.
+   */
+  void share_cache(const boost::shared_ptr<const DecodedCode>& decoded);
+
+  /**
+   * Decode all the instructions of a memory.
+   * The words that are not valid instructions are not decoded.
+   * @param isa instruction set architecture.
+   * @param memory the memory.
+   * @param decoded where to store the instructions decoded.
+   */
+  static void decode(const ISA& isa, const Memory& memory,
+                     DecodedCode* decoded);
+
+
+  /**
+   * Read the registers from the registers memory.
+   * It must be called when the registers memory is changed without using
+   * the CPU.
+   */
+  void load_registers();
+
+  /**
+   * Write the registers that have changed to the registers memory.
+   */
+  void save_registers();
+
 protected:
   const ISA& isa_;              /**< Instruction set */
   Memory* registers_;
@@ -193,6 +450,25 @@ protected:
 
   bool running_;
 
+  Word regs_[TOTAL_REGISTERS];  /**< Registers in the system endianness */
+  Word* window_;                /**< Registers of the current window */
+
+  DecodedCode decoded_;         /**< A entry for each word */
+  /**
+   * Instructions decoded shared with other CPUs, used instead of decoded_
+   * if it isn't NULL.
+   */
+  boost::shared_ptr<const DecodedCode> shared_;
+
+  Uint8 fault_code_;            /**< Interrupt of the last fault */
+  Word fault_data_;             /**< Word stored in g2 for the last fault */
+
+
+  /**
+   * Update the registers of the current window.
+   */
+  void update_window_();
+
 
   /**
    * Decode the current instruction.
@@ -201,15 +477,63 @@ protected:
    */
   Instruction fetch_instruction_() const;
 
+  /**
+   * Decode the current instruction using the decoded instructions.
+   * If pc is out of range or the instruction is not found, the fault is
+   * stored and a operation that returns UpdateFault is returned.
+   * @param instruction where to store the current instruction.
+   * @return the function that executes the operation.
+   */
+  Operation decode_instruction_(Instruction& instruction);
+
+  /**
+   * Operation of the instructions that couldn't be decoded.
+   * @param cpu the CPU.
+   * @param inst the instruction.
+   * @return UpdateFault.
+   */
+  static Update fault_instruction_(CPU& cpu, Instruction inst);
+
+  /**
+   * Execute some cycles (or until a stop instruction is found or a
+   * instruction returns UpdateYield).
+   * The faults of the instructions are converted to interrupts without
+   * exceptions.
+   * @param cycles number of cycles to execute, updated with the cycles
+   * remaining.
+   * @exception MemoryError if the interrupt of a fault can't be thrown.
+   */
+  void execute_(Uint16& cycles);
+
+  /**
+   * Discard the decoded instructions of a region of memory.
+   * @param addr the address of the memory.
+   * @param size size of the region.
+   */
+  void invalidate_cache_(Address addr, Address size);
+
 
   /**
-   * Check if the interrupt is enabled.
+   * Store a fault, thrown as a interrupt when the operation returns
+   * UpdateFault.
+   * @param code the code of the interrupt.
+   * @param data the word stored in g2.
+   */
+  void fault_(Uint8 code, Word data)
+  {
+    this->fault_code_ = code;
+    this->fault_data_ = data;
+  }
+
+  /**
+   * Get the handler of a interrupt.
    * @param code Interrupt to check.
-   * @return true if the interrupt is enabled, not if not.
+   * @param handler where to store the address of the handler, 0 if the
+   * interrupt is not enabled.
+   * @return true if the ip is valid, false if a fault was stored.
    * @exception CPUexception if the interrupt is not found.
-   * @exception MemoryError if the ip is not valid.
    */
-  bool interrupt_enabled(Uint8 code) const;
+  bool interrupt_handler_(Uint8 code, Word* handler);
 };
 
 }
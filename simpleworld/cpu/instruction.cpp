@@ -36,12 +36,14 @@ Instruction::Instruction()
 }
 
 /**
- * Constructor that decodes a word (in big endian).
- * @param word word to decode (in big endian).
+ * Constructor that decodes a word.
+ * In big endian systems the system_endian parameter does nothing.
+ * @param word word to decode.
+ * @param system_endian if the word is in the system endianness.
  */
-Instruction::Instruction(Word word)
+Instruction::Instruction(Word word, bool system_endian)
 {
-  this->decode(word);
+  this->decode(word, system_endian);
 }
 
 
@@ -70,26 +72,25 @@ Word Instruction::encode() const
 }
 
 /**
- * Decode the instruction (in big endian).
- * @param word word to decode (in big endian).
+ * Decode the instruction.
+ * In big endian systems the system_endian parameter does nothing.
+ * @param word word to decode.
+ * @param system_endian if the word is in the system endianness.
  */
-void Instruction::decode(Word word)
+void Instruction::decode(Word word, bool system_endian)
 {
-  this->code = get_byte(word, 0);
-  this->first = get_byte(word, 1) >> 4;
-  this->second = get_byte(word, 1) & 0x0f;
-
-  Word data = static_cast<Word>(this->data);
 #if defined(IS_BIG_ENDIAN)
-  set_byte(&data, 2, get_byte(word, 2));
-  set_byte(&data, 3, get_byte(word, 3));
 #elif defined(IS_LITTLE_ENDIAN)
-  set_byte(&data, 0, get_byte(word, 3));
-  set_byte(&data, 1, get_byte(word, 2));
+  if (not system_endian)
+    word = change_byte_order(word);
 #else
 #error endianness not specified
 #endif
-  this->data = data;
+
+  this->code = word >> 24;
+  this->first = (word >> 20) & 0x0f;
+  this->second = (word >> 16) & 0x0f;
+  this->data = word & 0xffff;
 }
 
 }
@@ -41,10 +41,12 @@ public:
   Instruction();
 
   /**
-   * Constructor that decodes a word (in big endian).
-   * @param word word to decode (in big endian).
+   * Constructor that decodes a word.
+   * In big endian systems the system_endian parameter does nothing.
+   * @param word word to decode.
+   * @param system_endian if the word is in the system endianness.
    */
-  Instruction(Word word);
+  Instruction(Word word, bool system_endian = false);
 
 
   /**
@@ -54,10 +56,12 @@ public:
   Word encode() const;
 
   /**
-   * Decode the instruction (in big endian).
-   * @param word word to decode (in big endian).
+   * Decode the instruction.
+   * In big endian systems the system_endian parameter does nothing.
+   * @param word word to decode.
+   * @param system_endian if the word is in the system endianness.
    */
-  void decode(Word word);
+  void decode(Word word, bool system_endian = false);
 
 
   // data
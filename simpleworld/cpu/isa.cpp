@@ -234,7 +234,7 @@ std::vector<Uint8> ISA::interrupt_codes() const
  * @return the info about the instruction.
  * @exception CodeError if the instruction is not found.
  */
-InstructionInfo ISA::instruction_info(Uint8 code) const
+const InstructionInfo& ISA::instruction_info(Uint8 code) const
 {
   if (this->instructions_[code] == NULL)
     throw EXCEPTION(CodeError, boost::str(boost::format("\
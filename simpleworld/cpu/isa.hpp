@@ -73,7 +73,11 @@ enum Update {
   UpdateNone,                   /**< Do nothing */
   UpdatePC,                     /**< Update the program counter */
   UpdateInterrupt,              /**< Interrupt request */
-  UpdateStop                    /**< Stop the CPU */
+  UpdateStop,                   /**< Stop the CPU */
+  UpdateFault,                  /**< Throw the interrupt of the fault
+                                     stored in the CPU */
+  UpdateYield                   /**< Return to the caller of execute()
+                                     without finishing the instruction */
 };
 
 
@@ -153,7 +157,15 @@ public:
    * @return the info about the instruction.
    * @exception CodeError if the instruction is not found.
    */
-  InstructionInfo instruction_info(Uint8 code) const;
+  const InstructionInfo& instruction_info(Uint8 code) const;
+
+  /**
+   * Info about the instruction.
+   * @param code code of the instruction.
+   * @return the info about the instruction or NULL if it's not found.
+   */
+  const InstructionInfo* find_instruction(Uint8 code) const
+  { return this->instructions_[code]; }
 
   /**
    * Code of the instruction.
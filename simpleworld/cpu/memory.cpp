@@ -20,8 +20,10 @@
 
 #include <algorithm>
 #include <cstring>
+#include <cassert>
 
 #include <boost/format.hpp>
+#include <boost/make_shared.hpp>
 
 #include <simpleworld/config.hpp>
 
@@ -41,29 +43,32 @@ namespace cpu
  * @param size bytes of the memory
  */
 Memory::Memory(Address size)
-  : size_(0), memory_(NULL)
+  : size_(0)
 {
   this->resize(size);
 }
 
+/**
+ * Constructor.
+ * @param data bytes of the memory.
+ * @param size bytes of the memory.
+ */
 Memory::Memory(const void* data, Address size)
-  : size_(0), memory_(NULL)
+  : size_(0)
 {
   this->resize(size);
 
-  std::memcpy(this->memory_, data, size);
+  this->write_(0, data, size);
 }
 
 /**
  * Copy constructor.
+ * The pages are shared until they are written.
  * @param memory memory to copy.
  */
 Memory::Memory(const Memory& memory)
-  : size_(0), memory_(NULL)
+  : size_(memory.size_), pages_(memory.pages_)
 {
-  this->resize(memory.size_);
-
-  std::memcpy(this->memory_, memory.memory_, this->size_);
 }
 
 /**
@@ -71,8 +76,6 @@ Memory::Memory(const Memory& memory)
  */
 Memory::~Memory()
 {
-  if (this->memory_ != NULL)
-    delete[] this->memory_;
 }
 
 
@@ -83,190 +86,371 @@ Memory::~Memory()
  */
 void Memory::resize(Address size)
 {
-  Uint8* tmp = NULL;
-  if (size != 0)
-    tmp = new Uint8[size];
-
-  Address limit = std::min(this->size_, size);
-  // Copy old memory
-  std::memcpy(tmp, this->memory_, limit);
-  // Zeroed new memory
-  std::memset(tmp + limit, 0, size - limit);
-
+  // the bytes after the end of the last page are already zeroed
+  this->pages_.resize((size + MEMORY_PAGE_SIZE - 1) / MEMORY_PAGE_SIZE);
+  for (std::vector<boost::shared_ptr<Page> >::iterator page =
+         this->pages_.begin();
+       page != this->pages_.end();
+       ++page)
+    if (page->get() == NULL)
+      *page = boost::make_shared<Page>();
+
+  Address old_size = this->size_;
   this->size_ = size;
-  if (this->memory_ != NULL)
-    delete[] this->memory_;
-  this->memory_ = tmp;
-}
 
+  // zero the end of the last page
+  if (size < old_size and size % MEMORY_PAGE_SIZE != 0)
+    this->write_(size, NULL,
+                 std::min(old_size, static_cast<Address>(this->pages_.size() *
+                                                         MEMORY_PAGE_SIZE))
+                 - size);
+}
 
 /**
- * Get a word.
- * In big endian systems the system_endian parameter does nothing.
- * In little endian systems the word is returned in little endian if
- * system_endian is true and in big endian if system_endian is false.
- * @param address address of the word
- * @param system_endian if the word must be in the system endianness
- * @return the word
- * @exception MemoryError if address > (size - 4)
+ * Insert zeroed bytes in the memory.
+ * The bytes after address are moved to the end.
+ * @param address where the bytes are inserted.
+ * @param size number of bytes.
+ * @exception MemoryError if address > size of the memory
  */
-Word Memory::get_word(Address address, bool system_endian) const
+void Memory::insert(Address address, Address size)
 {
-  if (address > this->size_ or address + sizeof(Word) > this->size_)
+  if (address > this->size_)
     throw EXCEPTION1(MemoryError, boost::str(boost::format("\
 Address 0x%08X is out of range")
                                             % address), address);
 
-#if defined(IS_BIG_ENDIAN)
-  return *(reinterpret_cast<Word*>(&this->memory_[address]));
-#elif defined(IS_LITTLE_ENDIAN)
-  if (system_endian)
-    return change_byte_order(*(reinterpret_cast<Word*>(&this->memory_[address])));
-  else
-    return *(reinterpret_cast<Word*>(&this->memory_[address]));
-#else
-#error endianness not specified
-#endif
+  // the bytes after address are moved by the bytes that are not a whole
+  // page, and the whole pages are inserted without moving any byte
+  Address rest = size % MEMORY_PAGE_SIZE;
+  if (rest > 0) {
+    Address moved = this->size_ - address;
+    Memory::resize(this->size_ + rest);
+    this->move_(address + rest, address, moved);
+    this->write_(address, NULL, rest);
+  }
+  this->insert_pages_(address, size / MEMORY_PAGE_SIZE);
 }
 
 /**
- * Get a half word.
- * In big endian systems the system_endian parameter does nothing.
- * In little endian systems the word is returned in little endian if
- * system_endian is true and in big endian if system_endian is false.
- * @param address address of the half word
- * @param system_endian if the half word must be in the system endianness
- * @return the half word
- * @exception MemoryError if address > (size - 2)
+ * Remove bytes from the memory.
+ * The bytes after the removed ones are moved to address.
+ * @param address first byte removed.
+ * @param size number of bytes.
+ * @exception MemoryError if address + size > size of the memory
  */
-HalfWord Memory::get_halfword(Address address, bool system_endian) const
+void Memory::erase(Address address, Address size)
 {
-  if (address > this->size_ or address + sizeof(HalfWord) > this->size_)
+  if (address > this->size_ or address + size > this->size_)
     throw EXCEPTION1(MemoryError, boost::str(boost::format("\
 Address 0x%08X is out of range")
                                             % address), address);
 
-#if defined(IS_BIG_ENDIAN)
-  return *(reinterpret_cast<HalfWord*>(&this->memory_[address]));
-#elif defined(IS_LITTLE_ENDIAN)
-  if (system_endian)
-    return change_byte_order(*(reinterpret_cast<HalfWord*>(&this->memory_[address])));
-  else
-    return *(reinterpret_cast<HalfWord*>(&this->memory_[address]));
-#else
-#error endianness not specified
-#endif
+  // the whole pages are removed without moving any byte, and the bytes
+  // after them are moved by the rest
+  this->erase_pages_(address, size / MEMORY_PAGE_SIZE);
+  Address rest = size % MEMORY_PAGE_SIZE;
+  if (rest > 0) {
+    this->move_(address, address + rest, this->size_ - address - rest);
+    Memory::resize(this->size_ - rest);
+  }
 }
 
 /**
- * Get a quarter word.
- * @param address address of the word
- * @return the quarter word
- * @exception MemoryError if address > (size - 1)
+ * Copy bytes of the memory.
+ * The words are in big endian.
+ * @param data where to copy the bytes.
+ * @param size number of bytes.
+ * @param address first byte copied.
+ * @exception MemoryError if address + size > size of the memory
  */
-QuarterWord Memory::get_quarterword(Address address) const
+void Memory::read(void* data, Address size, Address address) const
 {
-  if (address > this->size_ or address + sizeof(QuarterWord) > this->size_)
+  if (address > this->size_ or address + size > this->size_)
     throw EXCEPTION1(MemoryError, boost::str(boost::format("\
 Address 0x%08X is out of range")
                                             % address), address);
 
-  return *(reinterpret_cast<QuarterWord*>(&this->memory_[address]));
+  this->read_(address, data, size);
 }
 
-
 /**
- * Set the value of a word.
- * In big endian systems the system_endian parameter does nothing.
- * In little endian systems the word is supposed to be in little endian if
- * system_endian is true and in big endian if system_endian is false.
- * @param address address of the word
- * @param value value of the word
- * @param system_endian if the word is in the systen endianness
- * @exception MemoryError if address > (size - 4)
+ * Change bytes of the memory.
+ * The words are in big endian.
+ * @param data new bytes.
+ * @param size number of bytes.
+ * @param address first byte changed.
+ * @exception MemoryError if address + size > size of the memory
  */
-void Memory::set_word(Address address, Word value, bool system_endian)
+void Memory::write(const void* data, Address size, Address address)
 {
-  if (address > this->size_ or address + sizeof(Word) > this->size_)
+  if (address > this->size_ or address + size > this->size_)
     throw EXCEPTION1(MemoryError, boost::str(boost::format("\
 Address 0x%08X is out of range")
                                             % address), address);
 
+  this->write_(address, data, size);
+}
+
+
+/**
+ * Copy the content of other Memory class.
+ * The pages are shared until they are written.
+ * @param memory memory to copy.
+ * @return a reference to this object.
+ */
+Memory& Memory::assign(const Memory& memory)
+{
+  // the subclasses are notified of the new size
+  this->resize(memory.size_);
+
+  this->pages_ = memory.pages_;
 
-#if defined(IS_BIG_ENDIAN)
-  *(reinterpret_cast<Word*>(&this->memory_[address])) = value;
-#elif defined(IS_LITTLE_ENDIAN)
-  if (system_endian)
-    *(reinterpret_cast<Word*>(&this->memory_[address])) =
-      change_byte_order(value);
-  else
-    *(reinterpret_cast<Word*>(&this->memory_[address])) = value;
-#else
-#error endianness not specified
-#endif
+  return *this;
 }
 
 /**
- * Set the value of a half word.
- * In big endian systems the system_endian parameter does nothing.
- * In little endian systems the word is supposed to be in little endian if
- * system_endian is true and in big endian if system_endian is false.
- * @param address address of the half word
- * @param value value of the half word
- * @param system_endian if the half word is in the systen endianness
- * @exception MemoryError if address > (size - 2)
+ * Copy the content and the size of other Memory class.
+ * The pages are shared until they are written and the subclasses are
+ * not notified of the change.
+ * @param memory memory to copy.
+ */
+void Memory::copy(const Memory& memory)
+{
+  this->size_ = memory.size_;
+  this->pages_ = memory.pages_;
+}
+
+
+/**
+ * Get a value of any alignment byte by byte.
+ * @param address address of the value.
+ * @param size bytes of the value.
+ * @return the value in the system endianness.
+ * @exception MemoryError if address + size > size of the memory
  */
-void Memory::set_halfword(Address address, HalfWord value, bool system_endian)
+Word Memory::load_(Address address, Address size) const
 {
-  if (address > this->size_ or address + sizeof(HalfWord) > this->size_)
+  if (address > this->size_ or address + size > this->size_)
     throw EXCEPTION1(MemoryError, boost::str(boost::format("\
 Address 0x%08X is out of range")
                                             % address), address);
 
+  Uint8 bytes[sizeof(Word)];
+  this->read_(address, bytes, size);
 
-#if defined(IS_BIG_ENDIAN)
-  *(reinterpret_cast<HalfWord*>(&this->memory_[address])) = value;
-#elif defined(IS_LITTLE_ENDIAN)
-  if (system_endian)
-    *(reinterpret_cast<HalfWord*>(&this->memory_[address])) =
-      change_byte_order(value);
-  else
-    *(reinterpret_cast<HalfWord*>(&this->memory_[address])) = value;
-#else
-#error endianness not specified
-#endif
+  Word value = 0;
+  for (Address i = 0; i < size; i++)
+    value = value << 8 | bytes[i];
+
+  return value;
 }
 
 /**
- * Set the value of a quarter word.
- * @param address address of the quarter word
- * @param value value of the quarter word
- * @exception MemoryError if address > (size - 1)
+ * Set a value of any alignment byte by byte.
+ * @param address address of the value.
+ * @param value the value in the system endianness.
+ * @param size bytes of the value.
+ * @exception MemoryError if address + size > size of the memory
  */
-void Memory::set_quarterword(Address address, QuarterWord value)
+void Memory::store_(Address address, Word value, Address size)
 {
-  if (address > this->size_ or address + sizeof(QuarterWord) > this->size_)
+  if (address > this->size_ or address + size > this->size_)
     throw EXCEPTION1(MemoryError, boost::str(boost::format("\
 Address 0x%08X is out of range")
                                             % address), address);
 
+  Uint8 bytes[sizeof(Word)];
+  for (Address i = 0; i < size; i++)
+    bytes[i] = value >> (8 * (size - 1 - i));
 
-  *(reinterpret_cast<QuarterWord*>(&this->memory_[address])) = value;
+  this->write_(address, bytes, size);
 }
 
+/**
+ * Copy bytes of the memory without checking the range.
+ * The words are converted to big endian.
+ * @param address first byte copied.
+ * @param data where to copy the bytes.
+ * @param size number of bytes.
+ */
+void Memory::read_(Address address, void* data, Address size) const
+{
+  assert(address + size <= this->size_);
+
+  Uint8* bytes = static_cast<Uint8*>(data);
+  while (size > 0) {
+    Address offset = address % MEMORY_PAGE_SIZE;
+    Address n = std::min(size, static_cast<Address>(MEMORY_PAGE_SIZE -
+                                                    offset));
+    const Page* page = this->pages_[address / MEMORY_PAGE_SIZE].get();
+    for (Address i = 0; i < n; i++)
+      bytes[i] = page->bytes[MEMORY_OFFSET(offset + i, 1)];
+
+    bytes += n;
+    address += n;
+    size -= n;
+  }
+}
 
 /**
- * Copy the content of other Memory class.
- * @param memory memory to copy.
- * @return a reference to this object.
+ * Change bytes of the memory without checking the range.
+ * The words are converted from big endian.
+ * @param address first byte changed.
+ * @param data new bytes, or NULL to zero them.
+ * @param size number of bytes.
  */
-Memory& Memory::assign(const Memory& memory)
+void Memory::write_(Address address, const void* data, Address size)
 {
-  this->resize(memory.size_);
+  assert(address + size <= this->pages_.size() * MEMORY_PAGE_SIZE);
+
+  const Uint8* bytes = static_cast<const Uint8*>(data);
+  while (size > 0) {
+    Address offset = address % MEMORY_PAGE_SIZE;
+    Address n = std::min(size, static_cast<Address>(MEMORY_PAGE_SIZE -
+                                                    offset));
+    Page* page = this->writable_(address / MEMORY_PAGE_SIZE);
+    for (Address i = 0; i < n; i++)
+      page->bytes[MEMORY_OFFSET(offset + i, 1)] =
+        bytes == NULL ? 0 : bytes[i];
+
+    if (bytes != NULL)
+      bytes += n;
+    address += n;
+    size -= n;
+  }
+}
+
+/**
+ * Move bytes inside of the memory without checking the range.
+ * The bytes are moved page by page, so they are not copied outside of the
+ * memory, and the words are moved as a whole if the bytes are moved by
+ * whole words.
+ * @param to first byte of the destination.
+ * @param from first byte moved.
+ * @param size number of bytes.
+ */
+void Memory::move_(Address to, Address from, Address size)
+{
+  assert(to + size <= this->size_ and from + size <= this->size_);
+
+  // the words are stored in the same order in the source and the
+  // destination, so they can be copied without converting them
+  bool words = to % sizeof(Word) == 0 and from % sizeof(Word) == 0 and
+    size % sizeof(Word) == 0;
+  // the bytes are moved from the end if the destination is after the
+  // source, so the source is not overwritten before it's read
+  bool backwards = to > from;
+  while (size > 0) {
+    Address n;
+    Address to_chunk;
+    Address from_chunk;
+    if (backwards) {
+      n = std::min(size, std::min((to + size - 1) % MEMORY_PAGE_SIZE + 1,
+                                  (from + size - 1) % MEMORY_PAGE_SIZE + 1));
+      to_chunk = to + size - n;
+      from_chunk = from + size - n;
+    } else {
+      n = std::min(size,
+                   static_cast<Address>(MEMORY_PAGE_SIZE - std::max(
+                                          to % MEMORY_PAGE_SIZE,
+                                          from % MEMORY_PAGE_SIZE)));
+      to_chunk = to;
+      from_chunk = from;
+      to += n;
+      from += n;
+    }
+    size -= n;
+
+    // the source is got after the destination, it could be the same page
+    Uint8* dst = this->writable_(to_chunk / MEMORY_PAGE_SIZE)->bytes;
+    const Uint8* src = this->pages_[from_chunk / MEMORY_PAGE_SIZE]->bytes;
+    Address dst_offset = to_chunk % MEMORY_PAGE_SIZE;
+    Address src_offset = from_chunk % MEMORY_PAGE_SIZE;
+    if (words)
+      std::memmove(dst + dst_offset, src + src_offset, n);
+    else if (backwards)
+      for (Address i = n; i > 0; i--)
+        dst[MEMORY_OFFSET(dst_offset + i - 1, 1)] =
+          src[MEMORY_OFFSET(src_offset + i - 1, 1)];
+    else
+      for (Address i = 0; i < n; i++)
+        dst[MEMORY_OFFSET(dst_offset + i, 1)] =
+          src[MEMORY_OFFSET(src_offset + i, 1)];
+  }
+}
 
-  std::memcpy(this->memory_, memory.memory_, this->size_);
+/**
+ * Insert zeroed pages in the memory without checking the range.
+ * Only the page with address is split, the pages after it are moved
+ * without changing them.
+ * @param address where the pages are inserted.
+ * @param pages number of pages.
+ */
+void Memory::insert_pages_(Address address, Address pages)
+{
+  if (pages == 0)
+    return;
+
+  Address page = address / MEMORY_PAGE_SIZE;
+  Address offset = address % MEMORY_PAGE_SIZE;
+  std::vector<boost::shared_ptr<Page> > inserted(pages);
+  for (Address i = 0; i < pages; i++)
+    inserted[i] = boost::make_shared<Page>();
+  // the bytes before address are kept in the first page inserted
+  if (offset != 0)
+    *inserted[0] = *this->pages_[page];
+
+  this->pages_.insert(this->pages_.begin() + page, inserted.begin(),
+                      inserted.end());
+  this->size_ += pages * MEMORY_PAGE_SIZE;
+
+  if (offset != 0) {
+    this->write_(address, NULL, MEMORY_PAGE_SIZE - offset);
+    this->write_((page + pages) * MEMORY_PAGE_SIZE, NULL, offset);
+  }
+}
 
-  return *this;
+/**
+ * Remove pages from the memory without checking the range.
+ * Only the page after the removed ones is merged with the bytes before
+ * address, the pages after it are moved without changing them.
+ * @param address first byte removed.
+ * @param pages number of pages.
+ */
+void Memory::erase_pages_(Address address, Address pages)
+{
+  if (pages == 0)
+    return;
+
+  Address page = address / MEMORY_PAGE_SIZE;
+  Address offset = address % MEMORY_PAGE_SIZE;
+  // the bytes before address are moved to the page after the removed ones
+  if (offset != 0) {
+    Uint8* last = this->writable_(page + pages)->bytes;
+    const Uint8* first = this->pages_[page]->bytes;
+    for (Address i = 0; i < offset; i++)
+      last[MEMORY_OFFSET(i, 1)] = first[MEMORY_OFFSET(i, 1)];
+  }
+
+  this->pages_.erase(this->pages_.begin() + page,
+                     this->pages_.begin() + page + pages);
+  this->size_ -= pages * MEMORY_PAGE_SIZE;
+}
+
+/**
+ * Get a page that can be written, copying it if it's shared.
+ * @param page index of the page.
+ * @return the page.
+ */
+Memory::Page* Memory::writable_(Address page)
+{
+  // only this memory has a reference to a unique page, so no other thread
+  // can share it while it's written
+  if (not this->pages_[page].unique())
+    this->pages_[page] = boost::make_shared<Page>(*this->pages_[page]);
+
+  return this->pages_[page].get();
 }
 
 }
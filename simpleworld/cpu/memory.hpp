@@ -21,8 +21,33 @@
 #ifndef SIMPLEWORLD_CPU_MEMORY_HPP
 #define SIMPLEWORLD_CPU_MEMORY_HPP
 
+#include <vector>
+#include <cstring>
+
+#include <boost/shared_ptr.hpp>
+
+#include <simpleworld/config.hpp>
 #include <simpleworld/ints.hpp>
 #include <simpleworld/cpu/types.hpp>
+#include <simpleworld/cpu/word.hpp>
+
+/**
+ * Size of the pages of the memory.
+ */
+#define MEMORY_PAGE_SIZE 256
+
+/**
+ * Offset in a page of a aligned word, half word or quarter word.
+ * The words are stored in the system endianness, so in little endian
+ * systems the bytes of each word are in the reverse order.
+ */
+#if defined(IS_BIG_ENDIAN)
+#define MEMORY_OFFSET(offset, size) (offset)
+#elif defined(IS_LITTLE_ENDIAN)
+#define MEMORY_OFFSET(offset, size) ((offset) ^ (sizeof(Word) - (size)))
+#else
+#error endianness not specified
+#endif
 
 namespace simpleworld
 {
@@ -31,7 +56,17 @@ namespace cpu
 
 /**
  * Memory array addressable in words.
- * The words are stored in big endian.
+ * The words are addressed in big endian, but they are stored in the
+ * system endianness, so only the words not aligned need to be converted.
+ * The bytes are converted to big endian by read() and write().
+ *
+ * The bytes are kept in pages of MEMORY_PAGE_SIZE bytes that are shared
+ * between the copies of the memory until they are written (copy on
+ * write), so copying a memory only copies the references to its pages.
+ *
+ * The words are accessed without virtual calls, so the accesses of the
+ * CPU can be inlined. The subclasses find the changes comparing the pages
+ * with a copy of the memory (see shares_page()).
  */
 class Memory
 {
@@ -44,10 +79,16 @@ public:
    */
   Memory(Address size = 0);
 
+  /**
+   * Constructor.
+   * @param data bytes of the memory.
+   * @param size bytes of the memory.
+   */
   Memory(const void* data, Address size);
 
   /**
    * Copy constructor.
+   * The pages are shared until they are written.
    * @param memory memory to copy.
    */
   Memory(const Memory& memory);
@@ -64,6 +105,15 @@ public:
    */
   Address size() const { return this->size_; }
 
+  /**
+   * Check if a range of bytes is inside the memory.
+   * @param address first byte.
+   * @param size number of bytes.
+   * @return true if address + size <= size of the memory, else false.
+   */
+  bool valid(Address address, Address size) const
+  { return address <= this->size_ and size <= this->size_ - address; }
+
   /**
    * Set the size of the memory.
    * The new memory is zeroed.
@@ -71,6 +121,58 @@ public:
    */
   virtual void resize(Address size);
 
+  /**
+   * Insert zeroed bytes in the memory.
+   * The bytes after address are moved to the end.
+   * @param address where the bytes are inserted.
+   * @param size number of bytes.
+   * @exception MemoryError if address > size of the memory
+   */
+  virtual void insert(Address address, Address size);
+
+  /**
+   * Remove bytes from the memory.
+   * The bytes after the removed ones are moved to address.
+   * @param address first byte removed.
+   * @param size number of bytes.
+   * @exception MemoryError if address + size > size of the memory
+   */
+  virtual void erase(Address address, Address size);
+
+  /**
+   * Copy bytes of the memory.
+   * The words are in big endian.
+   * @param data where to copy the bytes.
+   * @param size number of bytes.
+   * @param address first byte copied.
+   * @exception MemoryError if address + size > size of the memory
+   */
+  void read(void* data, Address size, Address address = 0) const;
+
+  /**
+   * Change bytes of the memory.
+   * The words are in big endian.
+   * @param data new bytes.
+   * @param size number of bytes.
+   * @param address first byte changed.
+   * @exception MemoryError if address + size > size of the memory
+   */
+  void write(const void* data, Address size, Address address = 0);
+
+  /**
+   * Check if a page is shared with other memory.
+   * A page written after the memory was copied is not shared with the
+   * copy any more.
+   * @param memory the other memory.
+   * @param page index of the page.
+   * @return true if the page is shared, else false.
+   */
+  bool shares_page(const Memory& memory, Address page) const
+  {
+    return page < this->pages_.size() and page < memory.pages_.size() and
+      this->pages_[page] == memory.pages_[page];
+  }
+
 
   /**
    * Get a word.
@@ -82,7 +184,16 @@ public:
    * @return the word
    * @exception MemoryError if address > (size - 4)
    */
-  virtual Word get_word(Address address, bool system_endian = true) const;
+  Word get_word(Address address, bool system_endian = true) const
+  {
+    Word word = this->get_<Word>(address);
+#ifdef IS_LITTLE_ENDIAN
+    if (not system_endian)
+      word = change_byte_order(word);
+#endif
+
+    return word;
+  }
 
   /**
    * Get a half word.
@@ -94,8 +205,16 @@ public:
    * @return the half word
    * @exception MemoryError if address > (size - 2)
    */
-  virtual HalfWord get_halfword(Address address,
-                                bool system_endian = true) const;
+  HalfWord get_halfword(Address address, bool system_endian = true) const
+  {
+    HalfWord halfword = this->get_<HalfWord>(address);
+#ifdef IS_LITTLE_ENDIAN
+    if (not system_endian)
+      halfword = change_byte_order(halfword);
+#endif
+
+    return halfword;
+  }
 
   /**
    * Get a quarter word.
@@ -103,7 +222,8 @@ public:
    * @return the quarter word
    * @exception MemoryError if address > (size - 1)
    */
-  virtual QuarterWord get_quarterword(Address address) const;
+  QuarterWord get_quarterword(Address address) const
+  { return this->get_<QuarterWord>(address); }
 
   /**
    * Set the value of a word.
@@ -115,7 +235,14 @@ public:
    * @param system_endian if the word is in the systen endianness
    * @exception MemoryError if address > (size - 4)
    */
-  virtual void set_word(Address address, Word value, bool system_endian = true);
+  void set_word(Address address, Word value, bool system_endian = true)
+  {
+#ifdef IS_LITTLE_ENDIAN
+    if (not system_endian)
+      value = change_byte_order(value);
+#endif
+    this->set_<Word>(address, value);
+  }
 
   /**
    * Set the value of a half word.
@@ -127,8 +254,15 @@ public:
    * @param system_endian if the half word is in the systen endianness
    * @exception MemoryError if address > (size - 2)
    */
-  virtual void set_halfword(Address address, HalfWord value,
-                            bool system_endian = true);
+  void set_halfword(Address address, HalfWord value,
+                    bool system_endian = true)
+  {
+#ifdef IS_LITTLE_ENDIAN
+    if (not system_endian)
+      value = change_byte_order(value);
+#endif
+    this->set_<HalfWord>(address, value);
+  }
 
   /**
    * Set the value of a quarter word.
@@ -136,7 +270,8 @@ public:
    * @param value value of the quarter word
    * @exception MemoryError if address > (size - 1)
    */
-  virtual void set_quarterword(Address address, QuarterWord value);
+  void set_quarterword(Address address, QuarterWord value)
+  { this->set_<QuarterWord>(address, value); }
 
 
   /**
@@ -154,6 +289,7 @@ public:
 
   /**
    * Copy the content of other Memory class.
+   * The pages are shared until they are written.
    * @param memory memory to copy.
    * @return a reference to this object.
    */
@@ -166,9 +302,142 @@ public:
    */
   Memory& operator =(const Memory& memory) { return this->assign(memory); }
 
+  /**
+   * Copy the content and the size of other Memory class.
+   * The pages are shared until they are written and the subclasses are
+   * not notified of the change.
+   * @param memory memory to copy.
+   */
+  void copy(const Memory& memory);
+
 protected:
+  /**
+   * Page of the memory.
+   * The bytes after the end of the memory are zeroed.
+   */
+  struct Page
+  {
+    Uint8 bytes[MEMORY_PAGE_SIZE];
+  };
+
   Address size_;
-  Uint8* memory_;
+  std::vector<boost::shared_ptr<Page> > pages_;
+
+  /**
+   * Get a word, half word or quarter word in the system endianness.
+   * The aligned values are read inline, the rest by load_().
+   * @param address address of the value.
+   * @return the value.
+   * @exception MemoryError if address + size of T > size of the memory
+   */
+  template <typename T>
+  T get_(Address address) const
+  {
+    if (address % sizeof(T) != 0 or address >= this->size_ or
+        this->size_ - address < sizeof(T))
+      return static_cast<T>(this->load_(address, sizeof(T)));
+
+    T value;
+    std::memcpy(&value, this->pages_[address / MEMORY_PAGE_SIZE]->bytes +
+                MEMORY_OFFSET(address % MEMORY_PAGE_SIZE, sizeof(T)),
+                sizeof(T));
+    return value;
+  }
+
+  /**
+   * Set a word, half word or quarter word in the system endianness.
+   * The aligned values in a page not shared are written inline, the rest
+   * by store_().
+   * @param address address of the value.
+   * @param value the value.
+   * @exception MemoryError if address + size of T > size of the memory
+   */
+  template <typename T>
+  void set_(Address address, T value)
+  {
+    if (address % sizeof(T) != 0 or address >= this->size_ or
+        this->size_ - address < sizeof(T) or
+        not this->pages_[address / MEMORY_PAGE_SIZE].unique()) {
+      this->store_(address, value, sizeof(T));
+      return;
+    }
+
+    std::memcpy(this->pages_[address / MEMORY_PAGE_SIZE]->bytes +
+                MEMORY_OFFSET(address % MEMORY_PAGE_SIZE, sizeof(T)),
+                &value, sizeof(T));
+  }
+
+  /**
+   * Get a value of any alignment byte by byte.
+   * @param address address of the value.
+   * @param size bytes of the value.
+   * @return the value in the system endianness.
+   * @exception MemoryError if address + size > size of the memory
+   */
+  Word load_(Address address, Address size) const;
+
+  /**
+   * Set a value of any alignment byte by byte.
+   * @param address address of the value.
+   * @param value the value in the system endianness.
+   * @param size bytes of the value.
+   * @exception MemoryError if address + size > size of the memory
+   */
+  void store_(Address address, Word value, Address size);
+
+  /**
+   * Copy bytes of the memory without checking the range.
+   * The words are converted to big endian.
+   * @param address first byte copied.
+   * @param data where to copy the bytes.
+   * @param size number of bytes.
+   */
+  void read_(Address address, void* data, Address size) const;
+
+  /**
+   * Change bytes of the memory without checking the range.
+   * The words are converted from big endian.
+   * @param address first byte changed.
+   * @param data new bytes, or NULL to zero them.
+   * @param size number of bytes.
+   */
+  void write_(Address address, const void* data, Address size);
+
+  /**
+   * Move bytes inside of the memory without checking the range.
+   * The bytes are moved page by page, so they are not copied outside of
+   * the memory, and the words are moved as a whole if the bytes are moved
+   * by whole words.
+   * @param to first byte of the destination.
+   * @param from first byte moved.
+   * @param size number of bytes.
+   */
+  void move_(Address to, Address from, Address size);
+
+  /**
+   * Insert zeroed pages in the memory without checking the range.
+   * Only the page with address is split, the pages after it are moved
+   * without changing them.
+   * @param address where the pages are inserted.
+   * @param pages number of pages.
+   */
+  void insert_pages_(Address address, Address pages);
+
+  /**
+   * Remove pages from the memory without checking the range.
+   * Only the page after the removed ones is merged with the bytes before
+   * address, the pages after it are moved without changing them.
+   * @param address first byte removed.
+   * @param pages number of pages.
+   */
+  void erase_pages_(Address address, Address pages);
+
+  /**
+   * Get a page that can be written, copying it if it's shared.
+   * @param page index of the page.
+   * @return the page.
+   */
+  Page* writable_(Address page);
 };
 
 }
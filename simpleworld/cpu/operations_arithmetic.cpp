@@ -38,7 +38,11 @@ namespace cpu
  */
 Update add(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first, cpu.get_reg(inst.second) + cpu.get_reg(inst.data));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  cpu.set_reg(inst.first, cpu.get_reg(inst.second) + data);
 
   return UpdatePC;
 }
@@ -68,7 +72,11 @@ Update addi(CPU& cpu, Instruction inst)
  */
 Update sub(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first, cpu.get_reg(inst.second) - cpu.get_reg(inst.data));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  cpu.set_reg(inst.first, cpu.get_reg(inst.second) - data);
 
   return UpdatePC;
 }
@@ -98,7 +106,11 @@ Update subi(CPU& cpu, Instruction inst)
  */
 Update mult(CPU& cpu, Instruction inst)
 {
-  Sint64 result = cpu.get_reg(inst.second) * cpu.get_reg(inst.data);
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  Sint64 result = cpu.get_reg(inst.second) * data;
   cpu.set_reg(inst.first, result & LOWBITS_64BITS);
 
   return UpdatePC;
@@ -130,8 +142,12 @@ Update multi(CPU& cpu, Instruction inst)
  */
 Update multh(CPU& cpu, Instruction inst)
 {
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
   Sint64 result = static_cast<Sint32>(cpu.get_reg(inst.second)) *
-    static_cast<Sint32>(cpu.get_reg(inst.data));
+    static_cast<Sint32>(data);
   cpu.set_reg(inst.first, static_cast<Sint32>(result >> 32));
 
   return UpdatePC;
@@ -164,8 +180,11 @@ Update multhi(CPU& cpu, Instruction inst)
  */
 Update multhu(CPU& cpu, Instruction inst)
 {
-  Uint64 result = static_cast<Uint64>(cpu.get_reg(inst.second)) *
-    cpu.get_reg(inst.data);
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  Uint64 result = static_cast<Uint64>(cpu.get_reg(inst.second)) * data;
   cpu.set_reg(inst.first, static_cast<Uint32>(result >> 32));
 
   return UpdatePC;
@@ -198,9 +217,14 @@ Update multhui(CPU& cpu, Instruction inst)
 Update div(CPU& cpu, Instruction inst)
 {
   Word dividend = cpu.get_reg(inst.second);
-  Word divisor = cpu.get_reg(inst.data);
+  Word divisor;
+  if (not cpu.load_reg(inst.data, &divisor))
+    return UpdateFault;
+
   if (divisor == 0) {
-    cpu.interrupt(INTERRUPT_DIVISION, cpu.get_reg(REGISTER_PC), dividend);
+    if (not cpu.try_interrupt(INTERRUPT_DIVISION, cpu.get_reg(REGISTER_PC),
+                              dividend))
+      return UpdateFault;
 
     return UpdateInterrupt;
   } else {
@@ -223,7 +247,9 @@ Update divi(CPU& cpu, Instruction inst)
   Word dividend = cpu.get_reg(inst.second);
   Word divisor = inst.data;
   if (divisor == 0) {
-    cpu.interrupt(INTERRUPT_DIVISION, cpu.get_reg(REGISTER_PC), dividend);
+    if (not cpu.try_interrupt(INTERRUPT_DIVISION, cpu.get_reg(REGISTER_PC),
+                              dividend))
+      return UpdateFault;
 
     return UpdateInterrupt;
   } else {
@@ -244,9 +270,14 @@ Update divi(CPU& cpu, Instruction inst)
 Update mod(CPU& cpu, Instruction inst)
 {
   Word dividend = cpu.get_reg(inst.second);
-  Word divisor = cpu.get_reg(inst.data);
+  Word divisor;
+  if (not cpu.load_reg(inst.data, &divisor))
+    return UpdateFault;
+
   if (divisor == 0) {
-    cpu.interrupt(INTERRUPT_DIVISION, cpu.get_reg(REGISTER_PC), dividend);
+    if (not cpu.try_interrupt(INTERRUPT_DIVISION, cpu.get_reg(REGISTER_PC),
+                              dividend))
+      return UpdateFault;
 
     return UpdateInterrupt;
   } else {
@@ -269,7 +300,9 @@ Update modi(CPU& cpu, Instruction inst)
   Word dividend = cpu.get_reg(inst.second);
   Word divisor = inst.data;
   if (divisor == 0) {
-    cpu.interrupt(INTERRUPT_DIVISION, cpu.get_reg(REGISTER_PC), dividend);
+    if (not cpu.try_interrupt(INTERRUPT_DIVISION, cpu.get_reg(REGISTER_PC),
+                              dividend))
+      return UpdateFault;
 
     return UpdateInterrupt;
   } else {
@@ -42,7 +42,8 @@ Update b(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   cpu.set_reg(REGISTER_PC, address);
 
@@ -61,7 +62,8 @@ Update bz(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (cpu.get_reg(inst.first) == 0) {
     cpu.set_reg(REGISTER_PC, address);
@@ -83,7 +85,8 @@ Update bnz(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (cpu.get_reg(inst.first) != 0) {
     cpu.set_reg(REGISTER_PC, address);
@@ -105,7 +108,8 @@ Update beq(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (cpu.get_reg(inst.first) == cpu.get_reg(inst.second)) {
     cpu.set_reg(REGISTER_PC, address);
@@ -127,7 +131,8 @@ Update bne(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (cpu.get_reg(inst.first) != cpu.get_reg(inst.second)) {
     cpu.set_reg(REGISTER_PC, address);
@@ -149,7 +154,8 @@ Update blt(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (static_cast<Sint32>(cpu.get_reg(inst.first)) <
       static_cast<Sint32>(cpu.get_reg(inst.second))) {
@@ -172,7 +178,8 @@ Update bltu(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (cpu.get_reg(inst.first) < cpu.get_reg(inst.second)) {
     cpu.set_reg(REGISTER_PC, address);
@@ -194,7 +201,8 @@ Update bgt(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (static_cast<Sint32>(cpu.get_reg(inst.first)) >
       static_cast<Sint32>(cpu.get_reg(inst.second))) {
@@ -217,7 +225,8 @@ Update bgtu(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (cpu.get_reg(inst.first) > cpu.get_reg(inst.second)) {
     cpu.set_reg(REGISTER_PC, address);
@@ -239,7 +248,8 @@ Update ble(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (static_cast<Sint32>(cpu.get_reg(inst.first)) <=
       static_cast<Sint32>(cpu.get_reg(inst.second))) {
@@ -262,7 +272,8 @@ Update bleu(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (cpu.get_reg(inst.first) <= cpu.get_reg(inst.second)) {
     cpu.set_reg(REGISTER_PC, address);
@@ -284,7 +295,8 @@ Update bge(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (static_cast<Sint32>(cpu.get_reg(inst.first)) >=
       static_cast<Sint32>(cpu.get_reg(inst.second))) {
@@ -307,7 +319,8 @@ Update bgeu(CPU& cpu, Instruction inst)
 {
   // Check if the address is valid.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
   if (cpu.get_reg(inst.first) >= cpu.get_reg(inst.second)) {
     cpu.set_reg(REGISTER_PC, address);
@@ -30,8 +30,9 @@ namespace cpu
  * Push the local registers in the stack.
  *
  * @param cpu the CPU.
+ * @return true if the stack is valid, false if a fault was stored.
  */
-static inline void push_locals(CPU& cpu)
+static inline bool push_locals(CPU& cpu)
 {
   Word sp = cpu.get_reg(REGISTER_SP);
 
@@ -39,20 +40,24 @@ static inline void push_locals(CPU& cpu)
        i < GLOBAL_REGISTERS + REGISTERS_PER_WINDOW;
        i++) {
     // Save the register in the top of the stack
-    cpu.set_mem(sp, cpu.get_reg(i));
+    if (not cpu.store_mem(sp, cpu.get_reg(i)))
+      return false;
     sp += sizeof(Word);
   }
 
   // Update stack pointer
   cpu.set_reg(REGISTER_SP, sp);
+
+  return true;
 }
 
 /**
  * Pop the local registers from the stack.
  *
  * @param cpu the CPU.
+ * @return true if the stack is valid, false if a fault was stored.
  */
-static inline void pop_locals(CPU& cpu)
+static inline bool pop_locals(CPU& cpu)
 {
   Word sp = cpu.get_reg(REGISTER_SP);
 
@@ -61,62 +66,76 @@ static inline void pop_locals(CPU& cpu)
        i--) {
     sp -= sizeof(Word);
     // Restore the register
-    cpu.set_reg(i, cpu.get_mem(sp));
+    Word word;
+    if (not cpu.load_mem(sp, &word))
+      return false;
+    cpu.set_reg(i, word);
   }
 
   // Update stack pointer
   cpu.set_reg(REGISTER_SP, sp);
+
+  return true;
 }
 
 /**
  * Pop the global registers from the stack.
  *
  * @param cpu the CPU.
+ * @return true if the stack is valid, false if a fault was stored.
  */
-static inline void pop_globals(CPU& cpu)
+static inline bool pop_globals(CPU& cpu)
 {
+  static const Uint8 registers[] = {
+    REGISTER_G3, REGISTER_G2, REGISTER_G1, REGISTER_G0, REGISTER_IP
+  };
   Word sp = cpu.get_reg(REGISTER_SP);
 
   // Restore the registers
-  sp -= sizeof(Word);
-  cpu.set_reg(REGISTER_G3, cpu.get_mem(sp));
-  sp -= sizeof(Word);
-  cpu.set_reg(REGISTER_G2, cpu.get_mem(sp));
-  sp -= sizeof(Word);
-  cpu.set_reg(REGISTER_G1, cpu.get_mem(sp));
-  sp -= sizeof(Word);
-  cpu.set_reg(REGISTER_G0, cpu.get_mem(sp));
-  sp -= sizeof(Word);
-  cpu.set_reg(REGISTER_IP, cpu.get_mem(sp));
+  for (Uint8 i = 0; i < sizeof(registers); i++) {
+    sp -= sizeof(Word);
+    Word word;
+    if (not cpu.load_mem(sp, &word))
+      return false;
+    cpu.set_reg(registers[i], word);
+  }
 
   // Update stack pointer
   cpu.set_reg(REGISTER_SP, sp);
+
+  return true;
 }
 
 /**
  * Increase the register window.
  *
  * @param cpu the CPU.
+ * @return true if the stack is valid, false if a fault was stored.
  */
-static inline void increase_window(CPU& cpu)
+static inline bool increase_window(CPU& cpu)
 {
   Word wc = cpu.get_reg(REGISTER_WC);
-  if (wc >= (REGISTER_WINDOWS - 1))
-    push_locals(cpu);
+  if (wc >= (REGISTER_WINDOWS - 1) and not push_locals(cpu))
+    return false;
   cpu.set_reg(REGISTER_WC, wc + 1);
+
+  return true;
 }
 
 /**
  * Decrease the register window.
  *
  * @param cpu the CPU.
+ * @return true if the stack is valid, false if a fault was stored.
  */
-static inline void decrease_window(CPU& cpu)
+static inline bool decrease_window(CPU& cpu)
 {
   Word wc = cpu.get_reg(REGISTER_WC) - 1;
   cpu.set_reg(REGISTER_WC, wc);
   if (wc >= (REGISTER_WINDOWS - 1))
-    pop_locals(cpu);
+    return pop_locals(cpu);
+
+  return true;
 }
 
 
@@ -133,9 +152,11 @@ Update call(CPU& cpu, Instruction inst)
   // If the address is out of range, a Invalid Memory location is raised
   // giving this instruction as data.
   Address address = cpu.get_reg(REGISTER_PC) + inst.offset;
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
-  increase_window(cpu);
+  if (not increase_window(cpu))
+    return UpdateFault;
 
   // Update the link register and the frame pointer
   cpu.set_reg(REGISTER_LR, cpu.get_reg(REGISTER_PC));
@@ -160,9 +181,11 @@ Update callr(CPU& cpu, Instruction inst)
   // If the address is out of range, a Invalid Memory location is raised
   // giving this instruction as data.
   Address address = cpu.get_reg(inst.first);
-  cpu.get_mem(address);
+  if (not cpu.check_mem(address))
+    return UpdateFault;
 
-  increase_window(cpu);
+  if (not increase_window(cpu))
+    return UpdateFault;
 
   // Update the link register and the frame pointer
   cpu.set_reg(REGISTER_LR, cpu.get_reg(REGISTER_PC));
@@ -183,9 +206,10 @@ Update callr(CPU& cpu, Instruction inst)
  */
 Update interrupt(CPU& cpu, Instruction inst)
 {
-  // It's not needed to increase the register window because cpu.interrupt()
-  // already does it if the interrupts are enabled
-  cpu.interrupt(INTERRUPT_SOFTWARE, inst.data);
+  // It's not needed to increase the register window because
+  // cpu.try_interrupt() already does it if the interrupts are enabled
+  if (not cpu.try_interrupt(INTERRUPT_SOFTWARE, inst.data))
+    return UpdateFault;
 
   return UpdateInterrupt;
 }
@@ -203,7 +227,8 @@ Update ret(CPU& cpu, Instruction inst)
   cpu.set_reg(REGISTER_PC, cpu.get_reg(REGISTER_LR));
   cpu.set_reg(REGISTER_SP, cpu.get_reg(REGISTER_FP));
 
-  decrease_window(cpu);
+  if (not decrease_window(cpu))
+    return UpdateFault;
 
   return UpdatePC;
 }
@@ -221,10 +246,12 @@ Update reti(CPU& cpu, Instruction inst)
   cpu.set_reg(REGISTER_PC, cpu.get_reg(REGISTER_LR));
   cpu.set_reg(REGISTER_SP, cpu.get_reg(REGISTER_FP));
 
-  decrease_window(cpu);
+  if (not decrease_window(cpu))
+    return UpdateFault;
 
   // Restore the global registers
-  pop_globals(cpu);
+  if (not pop_globals(cpu))
+    return UpdateFault;
 
   // It's not needed to update the pc because it already udpated by
   // CPU::interrupt()
@@ -50,7 +50,11 @@ Update lnot(CPU& cpu, Instruction inst)
  */
 Update lor(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first, cpu.get_reg(inst.second) | cpu.get_reg(inst.data));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  cpu.set_reg(inst.first, cpu.get_reg(inst.second) | data);
 
   return UpdatePC;
 }
@@ -80,7 +84,11 @@ Update lori(CPU& cpu, Instruction inst)
  */
 Update land(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first, cpu.get_reg(inst.second) & cpu.get_reg(inst.data));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  cpu.set_reg(inst.first, cpu.get_reg(inst.second) & data);
 
   return UpdatePC;
 }
@@ -110,7 +118,11 @@ Update landi(CPU& cpu, Instruction inst)
  */
 Update lxor(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first, cpu.get_reg(inst.second) ^ cpu.get_reg(inst.data));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  cpu.set_reg(inst.first, cpu.get_reg(inst.second) ^ data);
 
   return UpdatePC;
 }
@@ -73,7 +73,10 @@ Update swap(CPU& cpu, Instruction inst)
  */
 Update load(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first, cpu.get_mem(cpu.get_reg(REGISTER_PC) + inst.offset));
+  Word word;
+  if (not cpu.load_mem(cpu.get_reg(REGISTER_PC) + inst.offset, &word))
+    return UpdateFault;
+  cpu.set_reg(inst.first, word);
 
   return UpdatePC;
 }
@@ -88,8 +91,14 @@ Update load(CPU& cpu, Instruction inst)
  */
 Update loadrr(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first,
-              cpu.get_mem(cpu.get_reg(inst.second) + cpu.get_reg(inst.data)));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  Word word;
+  if (not cpu.load_mem(cpu.get_reg(inst.second) + data, &word))
+    return UpdateFault;
+  cpu.set_reg(inst.first, word);
 
   return UpdatePC;
 }
@@ -104,7 +113,10 @@ Update loadrr(CPU& cpu, Instruction inst)
  */
 Update loadri(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first, cpu.get_mem(cpu.get_reg(inst.second) + inst.offset));
+  Word word;
+  if (not cpu.load_mem(cpu.get_reg(inst.second) + inst.offset, &word))
+    return UpdateFault;
+  cpu.set_reg(inst.first, word);
 
   return UpdatePC;
 }
@@ -119,8 +131,10 @@ Update loadri(CPU& cpu, Instruction inst)
  */
 Update loadh(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first,
-              cpu.get_halfmem(cpu.get_reg(REGISTER_PC) + inst.offset));
+  HalfWord word;
+  if (not cpu.load_halfmem(cpu.get_reg(REGISTER_PC) + inst.offset, &word))
+    return UpdateFault;
+  cpu.set_reg(inst.first, word);
 
   return UpdatePC;
 }
@@ -135,9 +149,14 @@ Update loadh(CPU& cpu, Instruction inst)
  */
 Update loadhrr(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first,
-              cpu.get_halfmem(cpu.get_reg(inst.second) +
-                              cpu.get_reg(inst.data)));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  HalfWord word;
+  if (not cpu.load_halfmem(cpu.get_reg(inst.second) + data, &word))
+    return UpdateFault;
+  cpu.set_reg(inst.first, word);
 
   return UpdatePC;
 }
@@ -152,8 +171,10 @@ Update loadhrr(CPU& cpu, Instruction inst)
  */
 Update loadhri(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first,
-              cpu.get_halfmem(cpu.get_reg(inst.second) + inst.offset));
+  HalfWord word;
+  if (not cpu.load_halfmem(cpu.get_reg(inst.second) + inst.offset, &word))
+    return UpdateFault;
+  cpu.set_reg(inst.first, word);
 
   return UpdatePC;
 }
@@ -168,8 +189,10 @@ Update loadhri(CPU& cpu, Instruction inst)
  */
 Update loadq(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first,
-              cpu.get_quartermem(cpu.get_reg(REGISTER_PC) + inst.offset));
+  QuarterWord word;
+  if (not cpu.load_quartermem(cpu.get_reg(REGISTER_PC) + inst.offset, &word))
+    return UpdateFault;
+  cpu.set_reg(inst.first, word);
 
   return UpdatePC;
 }
@@ -184,9 +207,14 @@ Update loadq(CPU& cpu, Instruction inst)
  */
 Update loadqrr(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first,
-              cpu.get_quartermem(cpu.get_reg(inst.second) +
-                                 cpu.get_reg(inst.data)));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  QuarterWord word;
+  if (not cpu.load_quartermem(cpu.get_reg(inst.second) + data, &word))
+    return UpdateFault;
+  cpu.set_reg(inst.first, word);
 
   return UpdatePC;
 }
@@ -201,8 +229,10 @@ Update loadqrr(CPU& cpu, Instruction inst)
  */
 Update loadqri(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first,
-              cpu.get_quartermem(cpu.get_reg(inst.second) + inst.offset));
+  QuarterWord word;
+  if (not cpu.load_quartermem(cpu.get_reg(inst.second) + inst.offset, &word))
+    return UpdateFault;
+  cpu.set_reg(inst.first, word);
 
   return UpdatePC;
 }
@@ -270,7 +300,9 @@ Update loada(CPU& cpu, Instruction inst)
  */
 Update store(CPU& cpu, Instruction inst)
 {
-  cpu.set_mem(cpu.get_reg(REGISTER_PC) + inst.offset, cpu.get_reg(inst.first));
+  if (not cpu.store_mem(cpu.get_reg(REGISTER_PC) + inst.offset,
+                        cpu.get_reg(inst.first)))
+    return UpdateFault;
 
   return UpdatePC;
 }
@@ -285,8 +317,13 @@ Update store(CPU& cpu, Instruction inst)
  */
 Update storerr(CPU& cpu, Instruction inst)
 {
-  cpu.set_mem(cpu.get_reg(inst.first) + cpu.get_reg(inst.data),
-              cpu.get_reg(inst.second));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  if (not cpu.store_mem(cpu.get_reg(inst.first) + data,
+                        cpu.get_reg(inst.second)))
+    return UpdateFault;
 
   return UpdatePC;
 }
@@ -301,7 +338,9 @@ Update storerr(CPU& cpu, Instruction inst)
  */
 Update storeri(CPU& cpu, Instruction inst)
 {
-  cpu.set_mem(cpu.get_reg(inst.first) + inst.offset, cpu.get_reg(inst.second));
+  if (not cpu.store_mem(cpu.get_reg(inst.first) + inst.offset,
+                        cpu.get_reg(inst.second)))
+    return UpdateFault;
 
   return UpdatePC;
 }
@@ -316,8 +355,9 @@ Update storeri(CPU& cpu, Instruction inst)
  */
 Update storeh(CPU& cpu, Instruction inst)
 {
-  cpu.set_halfmem(cpu.get_reg(REGISTER_PC) + inst.offset,
-                  static_cast<HalfWord>(cpu.get_reg(inst.first)));
+  if (not cpu.store_halfmem(cpu.get_reg(REGISTER_PC) + inst.offset,
+                            static_cast<HalfWord>(cpu.get_reg(inst.first))))
+    return UpdateFault;
 
   return UpdatePC;
 }
@@ -332,8 +372,13 @@ Update storeh(CPU& cpu, Instruction inst)
  */
 Update storehrr(CPU& cpu, Instruction inst)
 {
-  cpu.set_halfmem(cpu.get_reg(inst.first) + cpu.get_reg(inst.data),
-                  static_cast<HalfWord>(cpu.get_reg(inst.second)));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  if (not cpu.store_halfmem(cpu.get_reg(inst.first) + data,
+                            static_cast<HalfWord>(cpu.get_reg(inst.second))))
+    return UpdateFault;
 
   return UpdatePC;
 }
@@ -348,8 +393,9 @@ Update storehrr(CPU& cpu, Instruction inst)
  */
 Update storehri(CPU& cpu, Instruction inst)
 {
-  cpu.set_halfmem(cpu.get_reg(inst.first) + inst.offset,
-                  static_cast<HalfWord>(cpu.get_reg(inst.second)));
+  if (not cpu.store_halfmem(cpu.get_reg(inst.first) + inst.offset,
+                            static_cast<HalfWord>(cpu.get_reg(inst.second))))
+    return UpdateFault;
 
   return UpdatePC;
 }
@@ -364,8 +410,9 @@ Update storehri(CPU& cpu, Instruction inst)
  */
 Update storeq(CPU& cpu, Instruction inst)
 {
-  cpu.set_quartermem(cpu.get_reg(REGISTER_PC) + inst.offset,
-                     static_cast<QuarterWord>(cpu.get_reg(inst.first)));
+  QuarterWord word = static_cast<QuarterWord>(cpu.get_reg(inst.first));
+  if (not cpu.store_quartermem(cpu.get_reg(REGISTER_PC) + inst.offset, word))
+    return UpdateFault;
 
   return UpdatePC;
 }
@@ -380,8 +427,13 @@ Update storeq(CPU& cpu, Instruction inst)
  */
 Update storeqrr(CPU& cpu, Instruction inst)
 {
-  cpu.set_quartermem(cpu.get_reg(inst.first) + cpu.get_reg(inst.data),
-                     static_cast<QuarterWord>(cpu.get_reg(inst.second)));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  QuarterWord word = static_cast<QuarterWord>(cpu.get_reg(inst.second));
+  if (not cpu.store_quartermem(cpu.get_reg(inst.first) + data, word))
+    return UpdateFault;
 
   return UpdatePC;
 }
@@ -396,8 +448,9 @@ Update storeqrr(CPU& cpu, Instruction inst)
  */
 Update storeqri(CPU& cpu, Instruction inst)
 {
-  cpu.set_quartermem(cpu.get_reg(inst.first) + inst.offset,
-                     static_cast<QuarterWord>(cpu.get_reg(inst.second)));
+  QuarterWord word = static_cast<QuarterWord>(cpu.get_reg(inst.second));
+  if (not cpu.store_quartermem(cpu.get_reg(inst.first) + inst.offset, word))
+    return UpdateFault;
 
   return UpdatePC;
 }
@@ -414,7 +467,8 @@ Update storeqri(CPU& cpu, Instruction inst)
 Update push(CPU& cpu, Instruction inst)
 {
   // Save the register in the top of the stack
-  cpu.set_mem(cpu.get_reg(REGISTER_SP), cpu.get_reg(inst.first));
+  if (not cpu.store_mem(cpu.get_reg(REGISTER_SP), cpu.get_reg(inst.first)))
+    return UpdateFault;
   // Update stack pointer
   cpu.set_reg(REGISTER_SP, cpu.get_reg(REGISTER_SP) + sizeof(Word));
 
@@ -432,7 +486,10 @@ Update pop(CPU& cpu, Instruction inst)
   // Update stack pointer
   cpu.set_reg(REGISTER_SP, cpu.get_reg(REGISTER_SP) - sizeof(Word));
   // Restore the register
-  cpu.set_reg(inst.first, cpu.get_mem(cpu.get_reg(REGISTER_SP)));
+  Word word;
+  if (not cpu.load_mem(cpu.get_reg(REGISTER_SP), &word))
+    return UpdateFault;
+  cpu.set_reg(inst.first, word);
 
   return UpdatePC;
 }
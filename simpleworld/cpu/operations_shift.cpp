@@ -35,7 +35,11 @@ namespace cpu
  */
 Update sll(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first, cpu.get_reg(inst.second) << cpu.get_reg(inst.data));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  cpu.set_reg(inst.first, cpu.get_reg(inst.second) << data);
 
   return UpdatePC;
 }
@@ -65,7 +69,11 @@ Update slli(CPU& cpu, Instruction inst)
  */
 Update srl(CPU& cpu, Instruction inst)
 {
-  cpu.set_reg(inst.first, cpu.get_reg(inst.second) >> cpu.get_reg(inst.data));
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
+  cpu.set_reg(inst.first, cpu.get_reg(inst.second) >> data);
 
   return UpdatePC;
 }
@@ -95,9 +103,13 @@ Update srli(CPU& cpu, Instruction inst)
  */
 Update sra(CPU& cpu, Instruction inst)
 {
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
   Uint32 sign = cpu.get_reg(inst.second) & 0x80000000;
   cpu.set_reg(inst.first,
-              (cpu.get_reg(inst.second) >> cpu.get_reg(inst.data)) | sign);
+              (cpu.get_reg(inst.second) >> data) | sign);
 
   return UpdatePC;
 }
@@ -128,10 +140,13 @@ Update srai(CPU& cpu, Instruction inst)
  */
 Update rl(CPU& cpu, Instruction inst)
 {
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
   cpu.set_reg(inst.first,
-              cpu.get_reg(inst.second) << cpu.get_reg(inst.data) |
-              cpu.get_reg(inst.second) >> (32 -
-                                           (cpu.get_reg(inst.data) % 32)));
+              cpu.get_reg(inst.second) << data |
+              cpu.get_reg(inst.second) >> (32 - (data % 32)));
 
   return UpdatePC;
 }
@@ -163,10 +178,13 @@ Update rli(CPU& cpu, Instruction inst)
  */
 Update rr(CPU& cpu, Instruction inst)
 {
+  Word data;
+  if (not cpu.load_reg(inst.data, &data))
+    return UpdateFault;
+
   cpu.set_reg(inst.first,
-              cpu.get_reg(inst.second) >> cpu.get_reg(inst.data) |
-              cpu.get_reg(inst.second) << (32 -
-                                           (cpu.get_reg(inst.data) % 32)));
+              cpu.get_reg(inst.second) >> data |
+              cpu.get_reg(inst.second) << (32 - (data % 32)));
 
   return UpdatePC;
 }
@@ -19,6 +19,7 @@
  */
 
 #include <cstring>
+#include <string>
 
 #include <boost/format.hpp>
 
@@ -66,12 +67,10 @@ AliveBug::AliveBug(DB* db, ID bug_id)
 ID AliveBug::insert(DB* db, ID bug_id, ID world_id, Time birth, Energy energy,
                     ID registers_id, ID memory_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO AliveBug(bug_id, world_id, birth, energy, registers_id,\n\
                      memory_id)\n\
-VALUES(?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?, ?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int64(stmt, 2, world_id);
   sqlite3_bind_int(stmt, 3, birth);
@@ -80,7 +79,7 @@ VALUES(?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
   sqlite3_bind_int64(stmt, 6, memory_id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -100,12 +99,10 @@ ID AliveBug::insert(DB* db, Egg* egg, Time birth)
   ID registers_id = Registers::insert(db);
 
   // Insert the alive bug
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO AliveBug(bug_id, world_id, birth, energy, registers_id,\n\
                      memory_id)\n\
-VALUES(?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?, ?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, egg->id());
   sqlite3_bind_int64(stmt, 2, egg->world_id());
   sqlite3_bind_int(stmt, 3, birth);
@@ -114,7 +111,7 @@ VALUES(?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
   sqlite3_bind_int64(stmt, 6, egg->memory_id());
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
   ID id = sqlite3_last_insert_rowid(db->db());
 
   Egg::remove(db, egg->id());
@@ -130,15 +127,13 @@ VALUES(?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
  */
 void AliveBug::remove(DB*db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM AliveBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -149,17 +144,15 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 void AliveBug::bug_id(ID bug_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE AliveBug\n\
 SET bug_id = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = bug_id;
 }
@@ -172,19 +165,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 ID AliveBug::world_id() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT world_id\n\
 FROM AliveBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table AliveBug")
                                             % this->id_));
   ID world_id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return world_id;
 }
@@ -195,17 +186,15 @@ id %1% not found in table AliveBug")
  */
 void AliveBug::world_id(ID world_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE AliveBug\n\
 SET world_id = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, world_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -215,19 +204,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 Time AliveBug::birth() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT birth\n\
 FROM AliveBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table AliveBug")
                                             % this->id_));
   Time birth = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return birth;
 }
@@ -239,17 +226,15 @@ id %1% not found in table AliveBug")
  */
 void AliveBug::birth(Time birth)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE AliveBug\n\
 SET birth = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int(stmt, 1, birth);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -259,19 +244,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 Energy AliveBug::energy() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT energy\n\
 FROM AliveBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table AliveBug")
                                             % this->id_));
   Energy energy = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return energy;
 }
@@ -283,17 +266,15 @@ id %1% not found in table AliveBug")
  */
 void AliveBug::energy(Energy energy)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE AliveBug\n\
 SET energy = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int(stmt, 1, energy);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -305,19 +286,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 Time AliveBug::time_last_action() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT time_last_action\n\
 FROM AliveBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table AliveBug")
                                             % this->id_));
   Time time_last_action = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return time_last_action;
 }
@@ -329,17 +308,15 @@ id %1% not found in table AliveBug")
  */
 void AliveBug::time_last_action(Time time_last_action)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE AliveBug\n\
 SET time_last_action = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int(stmt, 1, time_last_action);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -350,19 +327,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 Time AliveBug::action_time() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT action_time\n\
 FROM AliveBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table AliveBug")
                                             % this->id_));
   Time action_time = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return action_time;
 }
@@ -374,17 +349,15 @@ id %1% not found in table AliveBug")
  */
 void AliveBug::action_time(Time action_time)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE AliveBug\n\
 SET action_time = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int(stmt, 1, action_time);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -395,19 +368,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 ID AliveBug::registers_id() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT registers_id\n\
 FROM AliveBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table AliveBug")
     % this->id_));
   ID registers_id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return registers_id;
 }
@@ -419,17 +390,15 @@ id %1% not found in table AliveBug")
  */
 void AliveBug::registers_id(ID registers_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE AliveBug\n\
 SET registers_id = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, registers_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -439,19 +408,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 ID AliveBug::memory_id() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT memory_id\n\
 FROM AliveBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table AliveBug")
     % this->id_));
   ID memory_id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return memory_id;
 }
@@ -463,17 +430,85 @@ id %1% not found in table AliveBug")
  */
 void AliveBug::memory_id(ID memory_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE AliveBug\n\
 SET memory_id = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, memory_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+}
+
+
+/**
+ * Set several columns of the bug with only one UPDATE.
+ * A statement is prepared for each combination of columns.
+ * @param columns the columns to set (a mask of Column).
+ * @param energy the new energy.
+ * @param time_last_action the new time of the last action.
+ * @param time_last_action_null if time_last_action must be set as NULL.
+ * @param action_time the new time when the action will be finished.
+ * @param action_time_null if action_time must be set as NULL.
+ * @param memory_id the new id of the memory.
+ * @exception DBException if there is an error with the update.
+ */
+void AliveBug::update(unsigned columns, Energy energy,
+                      Time time_last_action, bool time_last_action_null,
+                      Time action_time, bool action_time_null,
+                      ID memory_id)
+{
+  if (columns == 0)
+    return;
+
+  // the names of the columns in the order of the bits of Column
+  static const char* const names[] = {
+    "energy",
+    "time_last_action",
+    "action_time",
+    "memory_id"
+  };
+
+  // DB::prepare() caches the statement by its SQL, so there is a statement
+  // for each mask
+  std::string sql("\
+UPDATE AliveBug\n\
+SET ");
+  bool first = true;
+  for (unsigned i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+    if (columns & (1 << i)) {
+      if (not first)
+        sql += ", ";
+      sql += names[i];
+      sql += " = ?";
+      first = false;
+    }
+  sql += "\n\
+WHERE bug_id = ?;";
+
+  sqlite3_stmt* stmt = this->db_->prepare(sql);
+  int param = 1;
+  if (columns & ColumnEnergy)
+    sqlite3_bind_int(stmt, param++, energy);
+  if (columns & ColumnTimeLastAction) {
+    if (time_last_action_null)
+      sqlite3_bind_null(stmt, param++);
+    else
+      sqlite3_bind_int(stmt, param++, time_last_action);
+  }
+  if (columns & ColumnActionTime) {
+    if (action_time_null)
+      sqlite3_bind_null(stmt, param++);
+    else
+      sqlite3_bind_int(stmt, param++, action_time);
+  }
+  if (columns & ColumnMemoryId)
+    sqlite3_bind_int64(stmt, param++, memory_id);
+  sqlite3_bind_int64(stmt, param, this->id_);
+  if (sqlite3_step(stmt) != SQLITE_DONE)
+    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+  sqlite3_reset(stmt);
 }
 
 }
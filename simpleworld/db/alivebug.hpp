@@ -198,6 +198,34 @@ public:
    * @exception DBException if there is an error with the update.
    */
   void memory_id(ID memory_id);
+
+
+  /**
+   * Columns that can be set with update().
+   */
+  enum Column {
+    ColumnEnergy = 1 << 0,
+    ColumnTimeLastAction = 1 << 1,
+    ColumnActionTime = 1 << 2,
+    ColumnMemoryId = 1 << 3
+  };
+
+  /**
+   * Set several columns of the bug with only one UPDATE.
+   * A statement is prepared for each combination of columns.
+   * @param columns the columns to set (a mask of Column).
+   * @param energy the new energy.
+   * @param time_last_action the new time of the last action.
+   * @param time_last_action_null if time_last_action must be set as NULL.
+   * @param action_time the new time when the action will be finished.
+   * @param action_time_null if action_time must be set as NULL.
+   * @param memory_id the new id of the memory.
+   * @exception DBException if there is an error with the update.
+   */
+  void update(unsigned columns, Energy energy,
+              Time time_last_action, bool time_last_action_null,
+              Time action_time, bool action_time_null,
+              ID memory_id);
 };
 
 }
@@ -62,10 +62,7 @@ FROM %2%\n\
 WHERE _ROWID_ = ?;")
                                % this->column_
                                % this->table_));
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), query.c_str(), query.size(), &stmt,
-                         NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+  sqlite3_stmt* stmt = this->db_->prepare(query);
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
@@ -73,7 +70,7 @@ id %1% not found in table %2%")
                                             % this->id_
                                             % this->table_));
   Uint32 size = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return size;
 }
@@ -94,10 +91,7 @@ FROM %2%\n\
 WHERE _ROWID_ = ?;")
                                % this->column_
                                % this->table_));
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), query.c_str(), query.size(), &stmt,
-                         NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+  sqlite3_stmt* stmt = this->db_->prepare(query);
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
@@ -108,7 +102,7 @@ id %1% not found in table %2%")
   int s = sqlite3_column_bytes(stmt, 0);
   boost::shared_array<Uint8> data(new Uint8[s]);
   std::memcpy(data.get(), blob, s);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
   *size = s;
   return data;
 }
@@ -156,15 +150,12 @@ SET %2% = ?\n\
 WHERE _ROWID_ = ?;")
                                % this->table_
                                % this->column_));
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), query.c_str(), query.size(), &stmt,
-                         NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+  sqlite3_stmt* stmt = this->db_->prepare(query);
   sqlite3_bind_blob(stmt, 1, data, size, SQLITE_TRANSIENT);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
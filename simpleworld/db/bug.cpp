@@ -56,17 +56,15 @@ Bug::Bug(DB* db, ID id)
  */
 ID Bug::insert(DB* db, ID code_id, Time creation, ID father_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Bug(code_id, creation, father_id)\n\
-VALUES(?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, code_id);
   sqlite3_bind_int(stmt, 2, creation);
   sqlite3_bind_int64(stmt, 3, father_id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -81,16 +79,14 @@ VALUES(?, ?, ?);", -1, &stmt, NULL))
  */
 ID Bug::insert(DB* db, ID code_id, Time creation)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Bug(code_id, creation)\n\
-VALUES(?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?);");
   sqlite3_bind_int64(stmt, 1, code_id);
   sqlite3_bind_int(stmt, 2, creation);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -103,15 +99,13 @@ VALUES(?, ?);", -1, &stmt, NULL))
  */
 void Bug::remove(DB* db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM Bug\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -122,17 +116,15 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void Bug::id(ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Bug\n\
 SET id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = id;
 }
@@ -145,19 +137,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 ID Bug::code_id() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT code_id\n\
 FROM Bug\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table AliveBug")
     % this->id_));
   ID code_id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return code_id;
 }
@@ -169,17 +159,15 @@ id %1% not found in table AliveBug")
  */
 void Bug::code_id(ID code_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Bug\n\
 SET code_id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, code_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -190,19 +178,17 @@ WHERE id = ?;", -1, &stmt, NULL))
 */
 Time Bug::creation() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT creation\n\
 FROM Bug\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Bug")
                                             % this->id_));
   Time creation = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return creation;
 }
@@ -214,17 +200,15 @@ id %1% not found in table Bug")
 */
 void Bug::creation(Time creation)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Bug\n\
 SET creation = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, creation);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -236,19 +220,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 ID Bug::father_id() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT father_id\n\
 FROM Bug\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Bug")
                                             % this->id_));
   ID id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return id;
 }
@@ -260,17 +242,15 @@ id %1% not found in table Bug")
  */
 void Bug::father_id(ID father_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Bug\n\
 SET father_id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, father_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -300,12 +280,10 @@ std::vector<ID> Bug::ancestors() const
  */
 std::vector<ID> Bug::mutations() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT id\n\
 FROM Mutation\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
 
   bool done = false;
@@ -322,7 +300,7 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
       throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
     }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return ids;
 }
@@ -338,12 +316,10 @@ std::vector<ID> Bug::all_mutations() const
 
   std::vector<ID> ancestors = this->ancestors();
   std::vector<ID>::const_iterator iter = ancestors.begin();
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT id\n\
 FROM Mutation\n\
-WHERE bug_id = ? AND time < ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ? AND time < ?;");
   sqlite3_bind_int(stmt, 2, this->creation());
   while (iter != ancestors.end()) {
     sqlite3_bind_int64(stmt, 1, *iter);
@@ -365,7 +341,7 @@ WHERE bug_id = ? AND time < ?;", -1, &stmt, NULL))
 
     ++iter;
   }
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   std::vector<ID> mutations = this->mutations();
   ids.insert(ids.begin(), mutations.begin(), mutations.end());
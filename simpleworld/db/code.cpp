@@ -44,52 +44,100 @@ Code::Code(DB* db, ID id)
 
 
 /**
- * Insert the code of a bug.
+ * Hash of the code (64 bits FNV-1a).
+ * @param data code of the bug.
+ * @param size size of the code.
+ * @return the hash.
+ */
+static Uint64 code_hash(const void* data, Uint32 size)
+{
+  const Uint8* bytes = static_cast<const Uint8*>(data);
+  Uint64 hash = 0xcbf29ce484222325ULL;
+  for (Uint32 i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+
+  return hash;
+}
+
+/**
+ * Find a row with the same code.
  * @param db database.
+ * @param hash hash of the code.
  * @param data code of the bug.
  * @param size size of the code.
- * @return the id of the new row.
- * @exception DBException if there is an error with the insertion.
+ * @param id where to store the id of the row.
+ * @return true if the row was found, else false.
+ * @exception DBException if there is an error with the query.
  */
-ID Code::insert(DB* db, const void* data, Uint32 size)
+static bool code_find(DB* db, Uint64 hash, const void* data, Uint32 size,
+                      ID* id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
-INSERT INTO Code(data)\n\
-VALUES(?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_bind_blob(stmt, 1, data, size, SQLITE_TRANSIENT);
-  if (sqlite3_step(stmt) != SQLITE_DONE)
+  sqlite3_stmt* stmt = db->prepare("\
+SELECT id\n\
+FROM Code\n\
+WHERE hash = ? AND size = ? AND data = ?;");
+  sqlite3_bind_int64(stmt, 1, static_cast<Sint64>(hash));
+  sqlite3_bind_int(stmt, 2, size);
+  sqlite3_bind_blob(stmt, 3, data, size, SQLITE_STATIC);
+  int result = sqlite3_step(stmt);
+  if (result == SQLITE_ROW)
+    *id = sqlite3_column_int64(stmt, 0);
+  sqlite3_reset(stmt);
+  if (result != SQLITE_ROW and result != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
 
-  return sqlite3_last_insert_rowid(db->db());
+  return result == SQLITE_ROW;
 }
 
 /**
- * Copy the code of a bug.
+ * Insert a new row with the code.
  * @param db database.
- * @param code_id the id of the original code.
+ * @param hash hash of the code.
+ * @param data code of the bug.
+ * @param size size of the code.
  * @return the id of the new row.
  * @exception DBException if there is an error with the insertion.
  */
-ID Code::insert(DB* db, ID code_id)
+static ID code_insert(DB* db, Uint64 hash, const void* data, Uint32 size)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
-INSERT INTO Code(data)\n\
-SELECT data\n\
-FROM Code\n\
-WHERE id = ?", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_bind_int64(stmt, 1, code_id);
+  sqlite3_stmt* stmt = db->prepare("\
+INSERT INTO Code(hash, size, data)\n\
+VALUES(?, ?, ?);");
+  sqlite3_bind_int64(stmt, 1, static_cast<Sint64>(hash));
+  sqlite3_bind_int(stmt, 2, size);
+  sqlite3_bind_blob(stmt, 3, data, size, SQLITE_TRANSIENT);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
 
+
+/**
+ * Insert the code of a bug.
+ * The code is stored only once: if there is already a row with the same
+ * data its id is returned.
+ * A new row has no references and it's deleted when the last row that
+ * uses it is deleted.
+ * @param db database.
+ * @param data code of the bug.
+ * @param size size of the code.
+ * @return the id of the row with the code.
+ * @exception DBException if there is an error with the insertion.
+ */
+ID Code::insert(DB* db, const void* data, Uint32 size)
+{
+  Uint64 hash = code_hash(data, size);
+  ID id;
+  if (code_find(db, hash, data, size, &id))
+    return id;
+
+  return code_insert(db, hash, data, size);
+}
+
 /**
  * Delete the code of a bug.
  * @param db database.
@@ -98,15 +146,13 @@ WHERE id = ?", -1, &stmt, NULL))
  */
 void Code::remove(DB* db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM Code\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -117,17 +163,15 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void Code::id(ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Code\n\
 SET id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = id;
 }
@@ -135,6 +179,8 @@ WHERE id = ?;", -1, &stmt, NULL))
 
 /**
  * Get the code of the bug.
+ * The hash and the size are not updated when the blob is written, the
+ * code must be changed with update().
  * @return the code.
  * @exception DBException if there is an error with the query.
  */
@@ -143,5 +189,107 @@ Blob Code::data() const
   return Blob(this->db_, "Code", "data", this->id_);
 }
 
+/**
+ * Change the code of the bug.
+ * The code is copied on write: if other rows use the code a new row is
+ * inserted and the id of the object changes to the new row. The rows
+ * that use the code must be changed to the new id.
+ * @param data the new code.
+ * @param size size of the new code.
+ * @return the id of the row with the new code.
+ * @exception DBException if there is an error with the update.
+ */
+ID Code::update(const void* data, Uint32 size)
+{
+  Uint64 hash = code_hash(data, size);
+  ID id;
+  if (code_find(this->db_, hash, data, size, &id))
+    this->id_ = id;
+  else if (this->refs() > 1)
+    this->id_ = code_insert(this->db_, hash, data, size);
+  else {
+    sqlite3_stmt* stmt = this->db_->prepare("\
+UPDATE Code\n\
+SET hash = ?, size = ?, data = ?\n\
+WHERE id = ?;");
+    sqlite3_bind_int64(stmt, 1, static_cast<Sint64>(hash));
+    sqlite3_bind_int(stmt, 2, size);
+    sqlite3_bind_blob(stmt, 3, data, size, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 4, this->id_);
+    if (sqlite3_step(stmt) != SQLITE_DONE)
+      throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    sqlite3_reset(stmt);
+  }
+
+  return this->id_;
+}
+
+/**
+ * Get the size of the code.
+ * The blob is not loaded.
+ * @return the size of the code.
+ * @exception DBException if there is an error with the query.
+ */
+Uint32 Code::size() const
+{
+  sqlite3_stmt* stmt = this->db_->prepare("\
+SELECT size\n\
+FROM Code\n\
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, this->id_);
+  if (sqlite3_step(stmt) != SQLITE_ROW)
+    throw EXCEPTION(DBException, boost::str(boost::format("\
+id %1% not found in table Code")
+                                            % this->id_));
+  Uint32 size = sqlite3_column_int(stmt, 0);
+  sqlite3_reset(stmt);
+
+  return size;
+}
+
+/**
+ * Get the hash of the code.
+ * @return the hash of the code.
+ * @exception DBException if there is an error with the query.
+ */
+Uint64 Code::hash() const
+{
+  sqlite3_stmt* stmt = this->db_->prepare("\
+SELECT hash\n\
+FROM Code\n\
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, this->id_);
+  if (sqlite3_step(stmt) != SQLITE_ROW)
+    throw EXCEPTION(DBException, boost::str(boost::format("\
+id %1% not found in table Code")
+                                            % this->id_));
+  Uint64 hash = sqlite3_column_int64(stmt, 0);
+  sqlite3_reset(stmt);
+
+  return hash;
+}
+
+/**
+ * Get the number of rows that use the code.
+ * @return the number of references.
+ * @exception DBException if there is an error with the query.
+ */
+Uint32 Code::refs() const
+{
+  sqlite3_stmt* stmt = this->db_->prepare("\
+SELECT refs\n\
+FROM Code\n\
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, this->id_);
+  if (sqlite3_step(stmt) != SQLITE_ROW)
+    throw EXCEPTION(DBException, boost::str(boost::format("\
+id %1% not found in table Code")
+                                            % this->id_));
+  Uint32 refs = sqlite3_column_int(stmt, 0);
+  sqlite3_reset(stmt);
+
+  return refs;
+}
+
 }
 }
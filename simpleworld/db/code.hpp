@@ -33,6 +33,8 @@ namespace db
 
 /**
  * Information about the code of a bug.
+ * The code is shared using its id in other rows, the references are
+ * counted by the triggers of the database.
  */
 class Code: public Table
 {
@@ -49,23 +51,18 @@ public:
 
   /**
    * Insert the code of a bug.
+   * The code is stored only once: if there is already a row with the same
+   * data its id is returned.
+   * A new row has no references and it's deleted when the last row that
+   * uses it is deleted.
    * @param db database.
    * @param data code of the bug.
    * @param size size of the code.
-   * @return the id of the new row.
+   * @return the id of the row with the code.
    * @exception DBException if there is an error with the insertion.
    */
   static ID insert(DB* db, const void* data, Uint32 size);
 
-  /**
-   * Copy the code of a bug.
-   * @param db database.
-   * @param code_id the id of the original code.
-   * @return the id of the new row.
-   * @exception DBException if there is an error with the insertion.
-   */
-  static ID insert(DB* db, ID code_id);
-
   /**
    * Delete the code of a bug.
    * @param db database.
@@ -92,10 +89,46 @@ public:
 
   /**
    * Get the code of the bug.
+   * The hash and the size are not updated when the blob is written, the
+   * code must be changed with update().
    * @return the code.
    * @exception DBException if there is an error with the query.
    */
   Blob data() const;
+
+  /**
+   * Change the code of the bug.
+   * The code is copied on write: if other rows use the code a new row is
+   * inserted and the id of the object changes to the new row. The rows
+   * that use the code must be changed to the new id.
+   * @param data the new code.
+   * @param size size of the new code.
+   * @return the id of the row with the new code.
+   * @exception DBException if there is an error with the update.
+   */
+  ID update(const void* data, Uint32 size);
+
+  /**
+   * Get the size of the code.
+   * The blob is not loaded.
+   * @return the size of the code.
+   * @exception DBException if there is an error with the query.
+   */
+  Uint32 size() const;
+
+  /**
+   * Get the hash of the code.
+   * @return the hash of the code.
+   * @exception DBException if there is an error with the query.
+   */
+  Uint64 hash() const;
+
+  /**
+   * Get the number of rows that use the code.
+   * @return the number of references.
+   * @exception DBException if there is an error with the query.
+   */
+  Uint32 refs() const;
 };
 
 }
@@ -30,7 +30,7 @@ namespace fs = boost::filesystem;
 #include "default.hpp"
 #include "environment.hpp"
 
-#define DATABASE_VERSION 6
+#define DATABASE_VERSION 9
 
 namespace simpleworld
 {
@@ -58,6 +58,8 @@ CREATE TABLE Environment\n\
   -- the rest of the rows shouldn't change\n\
   size_x INTEGER NOT NULL,\n\
   size_y INTEGER NOT NULL,\n\
+\n\
+  seed INTEGER NOT NULL,                -- Seed of the random numbers\n\
 \n\
 time_rot INTEGER NOT NULL,\n\
 size_rot INTEGER NOT NULL,\n\
@@ -93,6 +95,7 @@ size_rot INTEGER NOT NULL,\n\
   PRIMARY KEY(id),\n\
   CHECK(time >= 0),\n\
   CHECK(size_x > 0 AND size_y > 0),\n\
+  CHECK(seed >= 0),\n\
   CHECK(time_rot >= 0),\n\
   CHECK(size_rot >= 0),\n\
   CHECK(mutations_probability >= 0 AND mutations_probability <= 1),\n\
@@ -226,13 +229,33 @@ END;",
     "\
 CREATE TABLE Code(\n\
   id INTEGER NOT NULL,\n\
+\n\
+  hash INTEGER NOT NULL,                -- FNV-1a hash of the data\n\
+  size INTEGER NOT NULL,                -- size of the data\n\
+  refs INTEGER NOT NULL DEFAULT 0,      -- rows that use the code\n\
 \n\
   data BLOB NOT NULL,\n\
 \n\
   PRIMARY KEY(id),\n\
-  CHECK(length(data) > 0 AND (length(data) % 4 = 0))\n\
+  CHECK(length(data) > 0 AND (length(data) % 4 = 0)),\n\
+  CHECK(refs >= 0)\n\
 );",
 
+    "\
+CREATE INDEX Code_index ON Code(hash);",
+
+    /* Delete the code when it isn't used anymore */
+    "\
+CREATE TRIGGER Code_update_refs\n\
+AFTER UPDATE OF refs\n\
+ON Code\n\
+FOR EACH ROW\n\
+WHEN NEW.refs = 0\n\
+BEGIN\n\
+  DELETE FROM Code\n\
+  WHERE id = NEW.id;\n\
+END;",
+
 
     /*******************
      * Spawn
@@ -263,6 +286,47 @@ CREATE TABLE Spawn(\n\
   CHECK(energy > 0)\n\
 );",
 
+    /* Count the references to the code */
+    "\
+CREATE TRIGGER Spawn_insert_code_id\n\
+AFTER INSERT\n\
+ON Spawn\n\
+FOR EACH ROW\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs + 1\n\
+  WHERE id = NEW.code_id;\n\
+END;",
+
+    "\
+CREATE TRIGGER Spawn_delete_code_id\n\
+AFTER DELETE\n\
+ON Spawn\n\
+FOR EACH ROW\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs - 1\n\
+  WHERE id = OLD.code_id;\n\
+END;",
+
+    /* Move the reference (nothing to do if Code(id) was updated) */
+    "\
+CREATE TRIGGER Spawn_update_code_id\n\
+AFTER UPDATE OF code_id\n\
+ON Spawn\n\
+FOR EACH ROW\n\
+WHEN EXISTS(SELECT 1\n\
+            FROM Code\n\
+            WHERE id = OLD.code_id)\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs + 1\n\
+  WHERE id = NEW.code_id;\n\
+  UPDATE Code\n\
+  SET refs = refs - 1\n\
+  WHERE id = OLD.code_id;\n\
+END;",
+
     /* regions must be inside the world */
     "\
 CREATE TRIGGER Spawn_insert\n\
@@ -473,6 +537,47 @@ CREATE TABLE Bug\n\
   CHECK(creation >= 0)\n\
 );",
 
+    /* Count the references to the code */
+    "\
+CREATE TRIGGER Bug_insert_code_id\n\
+AFTER INSERT\n\
+ON Bug\n\
+FOR EACH ROW\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs + 1\n\
+  WHERE id = NEW.code_id;\n\
+END;",
+
+    "\
+CREATE TRIGGER Bug_delete_code_id\n\
+AFTER DELETE\n\
+ON Bug\n\
+FOR EACH ROW\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs - 1\n\
+  WHERE id = OLD.code_id;\n\
+END;",
+
+    /* Move the reference (nothing to do if Code(id) was updated) */
+    "\
+CREATE TRIGGER Bug_update_code_id\n\
+AFTER UPDATE OF code_id\n\
+ON Bug\n\
+FOR EACH ROW\n\
+WHEN EXISTS(SELECT 1\n\
+            FROM Code\n\
+            WHERE id = OLD.code_id)\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs + 1\n\
+  WHERE id = NEW.code_id;\n\
+  UPDATE Code\n\
+  SET refs = refs - 1\n\
+  WHERE id = OLD.code_id;\n\
+END;",
+
     "\
 CREATE INDEX Bug_index ON Bug(father_id);",
 
@@ -507,10 +612,50 @@ CREATE TABLE Egg\n\
   FOREIGN KEY(world_id) REFERENCES World(id) ON UPDATE CASCADE ON DELETE CASCADE,\n\
   FOREIGN KEY(memory_id) REFERENCES Code(id) ON UPDATE CASCADE ON DELETE CASCADE,\n\
   UNIQUE(world_id),\n\
-  UNIQUE(memory_id),\n\
   CHECK(energy > 0)\n\
 );",
 
+    /* Count the references to the code */
+    "\
+CREATE TRIGGER Egg_insert_memory_id\n\
+AFTER INSERT\n\
+ON Egg\n\
+FOR EACH ROW\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs + 1\n\
+  WHERE id = NEW.memory_id;\n\
+END;",
+
+    "\
+CREATE TRIGGER Egg_delete_memory_id\n\
+AFTER DELETE\n\
+ON Egg\n\
+FOR EACH ROW\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs - 1\n\
+  WHERE id = OLD.memory_id;\n\
+END;",
+
+    /* Move the reference (nothing to do if Code(id) was updated) */
+    "\
+CREATE TRIGGER Egg_update_memory_id\n\
+AFTER UPDATE OF memory_id\n\
+ON Egg\n\
+FOR EACH ROW\n\
+WHEN EXISTS(SELECT 1\n\
+            FROM Code\n\
+            WHERE id = OLD.memory_id)\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs + 1\n\
+  WHERE id = NEW.memory_id;\n\
+  UPDATE Code\n\
+  SET refs = refs - 1\n\
+  WHERE id = OLD.memory_id;\n\
+END;",
+
 
     /*******************
      * Registers
@@ -520,9 +665,11 @@ CREATE TABLE Registers(\n\
   id INTEGER NOT NULL,\n\
 \n\
   data BLOB NOT NULL,\n\
+  running INTEGER NOT NULL DEFAULT 1,   -- 0 if the CPU was stopped\n\
 \n\
   PRIMARY KEY(id),\n\
-  CHECK(length(data) = 544)\n\
+  CHECK(length(data) = 544),\n\
+  CHECK(running IN (0, 1))\n\
 );",
 
 
@@ -552,13 +699,53 @@ CREATE TABLE AliveBug\n\
   FOREIGN KEY(memory_id) REFERENCES Code(id) ON UPDATE CASCADE ON DELETE CASCADE,\n\
   UNIQUE(world_id),\n\
   UNIQUE(registers_id),\n\
-  UNIQUE(memory_id),\n\
   CHECK(time_last_action IS NULL OR time_last_action >= 0),\n\
   CHECK(action_time IS NULL OR action_time > 0),\n\
   CHECK(birth >= 0),\n\
   CHECK(energy > 0)\n\
 );",
 
+    /* Count the references to the code */
+    "\
+CREATE TRIGGER AliveBug_insert_memory_id\n\
+AFTER INSERT\n\
+ON AliveBug\n\
+FOR EACH ROW\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs + 1\n\
+  WHERE id = NEW.memory_id;\n\
+END;",
+
+    "\
+CREATE TRIGGER AliveBug_delete_memory_id\n\
+AFTER DELETE\n\
+ON AliveBug\n\
+FOR EACH ROW\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs - 1\n\
+  WHERE id = OLD.memory_id;\n\
+END;",
+
+    /* Move the reference (nothing to do if Code(id) was updated) */
+    "\
+CREATE TRIGGER AliveBug_update_memory_id\n\
+AFTER UPDATE OF memory_id\n\
+ON AliveBug\n\
+FOR EACH ROW\n\
+WHEN EXISTS(SELECT 1\n\
+            FROM Code\n\
+            WHERE id = OLD.memory_id)\n\
+BEGIN\n\
+  UPDATE Code\n\
+  SET refs = refs + 1\n\
+  WHERE id = NEW.memory_id;\n\
+  UPDATE Code\n\
+  SET refs = refs - 1\n\
+  WHERE id = OLD.memory_id;\n\
+END;",
+
     /* Check that the time_last_action isn't in the future */
     "\
 CREATE TRIGGER AliveBug_insert_time_last_action\n\
@@ -758,14 +945,42 @@ CREATE TABLE Stats\n\
 }
 
 
+/**
+ * Copy a database to other connection.
+ * @param destination connection where the database is copied.
+ * @param source connection of the database.
+ * @exception DBException if the database can't be copied.
+ */
+static void copy_db(sqlite3* destination, sqlite3* source)
+{
+  sqlite3_backup* backup = sqlite3_backup_init(destination, "main",
+                                               source, "main");
+  if (backup == NULL)
+    throw EXCEPTION(DBException, sqlite3_errmsg(destination));
+
+  // all the pages are copied in a step, so the copy is a transaction
+  int result = sqlite3_backup_step(backup, -1);
+  if (sqlite3_backup_finish(backup) != SQLITE_OK)
+    throw EXCEPTION(DBException, sqlite3_errmsg(destination));
+  // a busy or locked database is not a error of the backup, but the
+  // pages are not copied
+  if (result != SQLITE_DONE)
+    throw EXCEPTION(DBException, sqlite3_errstr(result));
+}
+
+
 /**
  * Constructor.
+ * If memory is true the database is copied to memory and the changes
+ * are only written to the file by checkpoint().
  * @param filename File name of the database.
+ * @param memory if the database is kept in memory.
  * @exception DBException if the database can't be opened.
  * @exception DBException if there is a error in the database.
  * @exception WrongVersion if the database version is not supported.
  */
-DB::DB(std::string filename)
+DB::DB(std::string filename, bool memory)
+  : file_(NULL)
 {
   if (sqlite3_open_v2(filename.c_str(), &this->db_, SQLITE_OPEN_READWRITE,
                       NULL))
@@ -799,6 +1014,16 @@ Database version %1% not supported")
 
   sqlite3_exec(this->db_, "PRAGMA journal_mode = WAL;", NULL, NULL, NULL);
   sqlite3_exec(this->db_, "PRAGMA synchronous = NORMAL;", NULL, NULL, NULL);
+
+  if (memory) {
+    // the connection to the file is only used by the checkpoints
+    this->file_ = this->db_;
+    if (sqlite3_open_v2(":memory:", &this->db_,
+                        SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL))
+      throw EXCEPTION(DBException, sqlite3_errmsg(this->db_));
+    copy_db(this->db_, this->file_);
+  }
+
   sqlite3_exec(this->db_, "PRAGMA foreign_keys = ON;", NULL, NULL, NULL);
 }
 
@@ -807,7 +1032,14 @@ Database version %1% not supported")
  */
 DB::~DB()
 {
+  for (std::map<std::string, sqlite3_stmt*>::iterator iter =
+         this->statements_.begin();
+       iter != this->statements_.end();
+       ++iter)
+    sqlite3_finalize(iter->second);
+
   sqlite3_close(this->db_);
+  sqlite3_close(this->file_);
 }
 
 
@@ -821,6 +1053,7 @@ void DB::create(std::string filename)
   DB::create(filename, 0,
              default_environment.size_x,
              default_environment.size_y,
+             default_environment.seed,
              default_environment.time_rot,
              default_environment.size_rot,
              default_environment.mutations_probability,
@@ -855,6 +1088,7 @@ void DB::create(std::string filename)
  * @param time time passed since the creation of the World.
  * @param size_x size of the World (x coord).
  * @param size_y size of the World (y coord).
+ * @param seed seed of the random numbers.
  * @param time_rot time needed to rot the food.
  * @param size_rot size that is substracted to the food.
  * @param mutations_probability probability (0.0-1.0) that the code mutates.
@@ -884,7 +1118,7 @@ void DB::create(std::string filename)
  * @exception DBException if there is an error with the creation.
  */
 void DB::create(std::string filename,
-                Time time, Coord size_x, Coord size_y,
+                Time time, Coord size_x, Coord size_y, Uint32 seed,
                 Time time_rot, Energy size_rot,
                 double mutations_probability, Time time_birth,
                 Time time_mutate, Time time_laziness,
@@ -913,7 +1147,7 @@ void DB::create(std::string filename,
 
   DB db(filename);
   create_tables(&db);
-  Environment::insert(&db, time, size_x, size_y, time_rot, size_rot,
+  Environment::insert(&db, time, size_x, size_y, seed, time_rot, size_rot,
                       mutations_probability, time_birth, time_mutate,
                       time_laziness, energy_laziness, attack_multiplier,
                       time_nothing, time_myself, time_detect, time_info,
@@ -924,6 +1158,68 @@ void DB::create(std::string filename,
 }
 
 
+/**
+ * Write the database in memory to the file in a transaction.
+ * Nothing is done if the database is not in memory.
+ * The changes made in the file by other connections are lost.
+ * It must be called outside of a transaction.
+ * @exception DBException if there is a error in the database.
+ */
+void DB::checkpoint()
+{
+  if (this->file_ != NULL)
+    copy_db(this->file_, this->db_);
+}
+
+/**
+ * Version of the data.
+ * The version only changes when other connection commits changes in the
+ * database.
+ * @return the version.
+ * @exception DBException if there is a error in the database.
+ */
+Uint32 DB::data_version()
+{
+  sqlite3_stmt* stmt = this->prepare("PRAGMA data_version;");
+  if (sqlite3_step(stmt) != SQLITE_ROW)
+    throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
+  Uint32 data_version = sqlite3_column_int(stmt, 0);
+  sqlite3_reset(stmt);
+
+  return data_version;
+}
+
+/**
+ * Get a prepared statement.
+ * The statement is compiled the first time that the SQL is used and it's
+ * cached until the database is closed. The statement returned is reset and
+ * its bindings are cleared.
+ * The statement must be reset after being used.
+ * @param sql SQL of the statement.
+ * @return the statement.
+ * @exception DBException if the statement can't be prepared.
+ */
+sqlite3_stmt* DB::prepare(const std::string& sql)
+{
+  std::map<std::string, sqlite3_stmt*>::iterator iter =
+    this->statements_.lower_bound(sql);
+  if (iter != this->statements_.end() and iter->first == sql) {
+    // the statement could have been left in use if an exception was thrown
+    sqlite3_reset(iter->second);
+    sqlite3_clear_bindings(iter->second);
+
+    return iter->second;
+  }
+
+  sqlite3_stmt* stmt;
+  if (sqlite3_prepare_v2(this->db_, sql.c_str(), sql.size(), &stmt, NULL))
+    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_));
+  this->statements_.insert(iter, std::make_pair(sql, stmt));
+
+  return stmt;
+}
+
+
 /**
  * List of all the environments (changes), ordered by it's time.
  * @return the list of environments.
@@ -931,12 +1227,10 @@ void DB::create(std::string filename,
  */
 std::vector<ID> DB::environments()
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db(), "\
+  sqlite3_stmt* stmt = this->prepare("\
 SELECT id\n\
 FROM Environment\n\
-ORDER BY time;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
+ORDER BY time;");
 
   bool done = false;
   std::vector<ID> ids;
@@ -952,7 +1246,7 @@ ORDER BY time;", -1, &stmt, NULL))
       throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
     }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return ids;
 }
@@ -965,19 +1259,17 @@ ORDER BY time;", -1, &stmt, NULL))
  */
 ID DB::last_environment()
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db(), "\
+  sqlite3_stmt* stmt = this->prepare("\
 SELECT id\n\
 FROM Environment\n\
 WHERE time = (SELECT max(time)\n\
               FROM Environment)\n\
 ORDER BY id DESC\n\
-LIMIT 1;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
+LIMIT 1;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, "Table Environment is empty");
   ID id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return id;
 }
@@ -990,11 +1282,9 @@ LIMIT 1;", -1, &stmt, NULL))
  */
 std::vector<ID> DB::spawns()
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db(), "\
+  sqlite3_stmt* stmt = this->prepare("\
 SELECT id\n\
-FROM Spawn;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
+FROM Spawn;");
 
   bool done = false;
   std::vector<ID> ids;
@@ -1010,7 +1300,7 @@ FROM Spawn;", -1, &stmt, NULL))
       throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
     }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return ids;
 }
@@ -1022,11 +1312,9 @@ FROM Spawn;", -1, &stmt, NULL))
  */
 std::vector<ID> DB::resources()
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db(), "\
+  sqlite3_stmt* stmt = this->prepare("\
 SELECT id\n\
-FROM Resource;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
+FROM Resource;");
 
   bool done = false;
   std::vector<ID> ids;
@@ -1042,7 +1330,7 @@ FROM Resource;", -1, &stmt, NULL))
       throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
     }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return ids;
 }
@@ -1055,12 +1343,10 @@ FROM Resource;", -1, &stmt, NULL))
  */
 std::vector<ID> DB::eggs()
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db(), "\
+  sqlite3_stmt* stmt = this->prepare("\
 SELECT bug_id\n\
 FROM Egg\n\
-ORDER BY bug_id;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
+ORDER BY bug_id;");
 
   bool done = false;
   std::vector<ID> ids;
@@ -1076,7 +1362,7 @@ ORDER BY bug_id;", -1, &stmt, NULL))
       throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
     }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return ids;
 }
@@ -1088,12 +1374,10 @@ ORDER BY bug_id;", -1, &stmt, NULL))
  */
 std::vector<ID> DB::alive_bugs()
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db(), "\
+  sqlite3_stmt* stmt = this->prepare("\
 SELECT bug_id\n\
 FROM AliveBug\n\
-ORDER BY birth, bug_id;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
+ORDER BY birth, bug_id;");
 
   bool done = false;
   std::vector<ID> ids;
@@ -1109,7 +1393,7 @@ ORDER BY birth, bug_id;", -1, &stmt, NULL))
       throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
     }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return ids;
 }
@@ -1121,12 +1405,10 @@ ORDER BY birth, bug_id;", -1, &stmt, NULL))
  */
 std::vector<ID> DB::dead_bugs()
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db(), "\
+  sqlite3_stmt* stmt = this->prepare("\
 SELECT bug_id\n\
 FROM DeadBug\n\
-ORDER BY death, bug_id;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
+ORDER BY death, bug_id;");
 
   bool done = false;
   std::vector<ID> ids;
@@ -1142,7 +1424,7 @@ ORDER BY death, bug_id;", -1, &stmt, NULL))
       throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
     }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return ids;
 }
@@ -1155,12 +1437,10 @@ ORDER BY death, bug_id;", -1, &stmt, NULL))
  */
 std::vector<ID> DB::food()
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db(), "\
+  sqlite3_stmt* stmt = this->prepare("\
 SELECT id\n\
 FROM Food\n\
-ORDER BY id;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
+ORDER BY id;");
 
   bool done = false;
   std::vector<ID> ids;
@@ -1176,7 +1456,7 @@ ORDER BY id;", -1, &stmt, NULL))
       throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
     }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return ids;
 }
@@ -1189,12 +1469,10 @@ ORDER BY id;", -1, &stmt, NULL))
  */
 std::vector<ID> DB::stats()
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db(), "\
+  sqlite3_stmt* stmt = this->prepare("\
 SELECT id\n\
 FROM Stats\n\
-ORDER BY id;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
+ORDER BY id;");
 
   bool done = false;
   std::vector<ID> ids;
@@ -1210,7 +1488,7 @@ ORDER BY id;", -1, &stmt, NULL))
       throw EXCEPTION(DBException, sqlite3_errmsg(this->db()));
     }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return ids;
 }
@@ -23,6 +23,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 
 #include <sqlite3.h>
 
@@ -46,12 +47,15 @@ class DB
 public:
   /**
    * Constructor.
+   * If memory is true the database is copied to memory and the changes
+   * are only written to the file by checkpoint().
    * @param filename File name of the database.
+   * @param memory if the database is kept in memory.
    * @exception DBException if the database can't be opened.
    * @exception DBException if there is a error in the database.
    * @exception WrongVersion if the database version is not supported.
    */
-  DB(std::string filename);
+  DB(std::string filename, bool memory = false);
 
   /**
    * Destructor.
@@ -72,6 +76,7 @@ public:
    * @param time time passed since the creation of the World.
    * @param size_x size of the World (x coord).
    * @param size_y size of the World (y coord).
+   * @param seed seed of the random numbers.
    * @param time_rot time needed to rot the food.
    * @param size_rot size that is substracted to the food.
    * @param mutations_probability probability (0.0-1.0) that the code mutates.
@@ -101,7 +106,7 @@ public:
    * @exception DBException if there is an error with the creation.
    */
   static void create(std::string filename,
-                     Time time, Coord size_x, Coord size_y,
+                     Time time, Coord size_x, Coord size_y, Uint32 seed,
                      Time time_rot, Energy size_rot,
                      double mutations_probability, Time time_birth,
                      Time time_mutate, Time time_laziness,
@@ -121,12 +126,48 @@ public:
    */
   sqlite3* db() const { return this->db_; }
 
+  /**
+   * Check if the database is kept in memory.
+   * @return true if the database is in memory, else false.
+   */
+  bool memory() const { return this->file_ != NULL; }
+
+  /**
+   * Write the database in memory to the file in a transaction.
+   * Nothing is done if the database is not in memory.
+   * The changes made in the file by other connections are lost.
+   * It must be called outside of a transaction.
+   * @exception DBException if there is a error in the database.
+   */
+  void checkpoint();
+
   /**
    * Version of the data base.
    * @return The version.
    */
   Uint8 version() const { return this->version_; }
 
+  /**
+   * Version of the data.
+   * The version only changes when other connection commits changes in the
+   * database.
+   * @return the version.
+   * @exception DBException if there is a error in the database.
+   */
+  Uint32 data_version();
+
+  /**
+   * Get a prepared statement.
+   * The statement is compiled the first time that the SQL is used and it's
+   * cached until the database is closed. The statement returned is reset and
+   * its bindings are cleared.
+   * The statement must be reset after being used.
+   * @param sql SQL of the statement.
+   * @return the statement.
+   * @exception DBException if the statement can't be prepared.
+   */
+  sqlite3_stmt* prepare(const std::string& sql);
+
 
   /**
    * List of all the environments (changes), ordered by it's time.
@@ -197,7 +238,11 @@ public:
 
 private:
   sqlite3* db_;                 /**< Database connection */
+  sqlite3* file_;               /**< Connection to the file, if in memory */
   Uint8 version_;               /**< Version of the database */
+
+  /** Prepared statements indexed by its SQL */
+  std::map<std::string, sqlite3_stmt*> statements_;
 };
 
 }
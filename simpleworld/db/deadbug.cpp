@@ -25,7 +25,6 @@
 #include <sqlite3.h>
 
 #include "exception.hpp"
-#include "code.hpp"
 #include "deadbug.hpp"
 
 namespace simpleworld
@@ -56,16 +55,14 @@ DeadBug::DeadBug(DB* db, ID bug_id)
  */
 ID DeadBug::insert(DB* db, ID bug_id, Time death)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO DeadBug(bug_id, death)\n\
-VALUES(?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int(stmt, 2, death);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -81,17 +78,15 @@ VALUES(?, ?);", -1, &stmt, NULL))
  */
 ID DeadBug::insert(DB* db, ID bug_id, Time birth, Time death)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO DeadBug(bug_id, birth, death)\n\
-VALUES(?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int(stmt, 2, birth);
   sqlite3_bind_int(stmt, 3, death);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -107,17 +102,15 @@ VALUES(?, ?, ?);", -1, &stmt, NULL))
  */
 ID DeadBug::insert(DB* db, ID bug_id, Time death, ID killer_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO DeadBug(bug_id, death, killer_id)\n\
-VALUES(?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int(stmt, 2, death);
   sqlite3_bind_int64(stmt, 3, killer_id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -134,18 +127,16 @@ VALUES(?, ?, ?);", -1, &stmt, NULL))
  */
 ID DeadBug::insert(DB* db, ID bug_id, Time birth, Time death, ID killer_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO DeadBug(bug_id, birth, death, killer_id)\n\
-VALUES(?, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int(stmt, 2, birth);
   sqlite3_bind_int(stmt, 3, death);
   sqlite3_bind_int64(stmt, 4, killer_id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -161,20 +152,18 @@ VALUES(?, ?, ?, ?);", -1, &stmt, NULL))
  */
 ID DeadBug::insert(DB* db, Egg* egg, Time death)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO DeadBug(bug_id, death)\n\
-VALUES(?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?);");
   sqlite3_bind_int64(stmt, 1, egg->bug_id());
   sqlite3_bind_int(stmt, 2, death);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
   ID id = sqlite3_last_insert_rowid(db->db());
 
-  // The egg is removed by the foreign key constraint
-  Code::remove(db, egg->memory_id());
+  // The code is removed by a trigger when it isn't used anymore
+  Egg::remove(db, egg->bug_id());
 
   return id;
 }
@@ -191,21 +180,19 @@ VALUES(?, ?);", -1, &stmt, NULL))
  */
 ID DeadBug::insert(DB* db, Egg* egg, Time death, ID killer_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO DeadBug(bug_id, death, killer_id)\n\
-VALUES(?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, egg->bug_id());
   sqlite3_bind_int(stmt, 2, death);
   sqlite3_bind_int64(stmt, 3, killer_id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
   ID id = sqlite3_last_insert_rowid(db->db());
 
-  // The egg is removed by the foreign key constraint
-  Code::remove(db, egg->memory_id());
+  // The code is removed by a trigger when it isn't used anymore
+  Egg::remove(db, egg->bug_id());
 
   return id;
 }
@@ -221,21 +208,19 @@ VALUES(?, ?, ?);", -1, &stmt, NULL))
  */
 ID DeadBug::insert(DB* db, AliveBug* alivebug, Time death)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO DeadBug(bug_id, birth, death)\n\
-VALUES(?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, alivebug->bug_id());
   sqlite3_bind_int(stmt, 2, alivebug->birth());
   sqlite3_bind_int(stmt, 3, death);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
   ID id = sqlite3_last_insert_rowid(db->db());
 
-  // The bug is removed by the foreign key constraint
-  Code::remove(db, alivebug->memory_id());
+  // The code is removed by a trigger when it isn't used anymore
+  AliveBug::remove(db, alivebug->bug_id());
 
   return id;
 }
@@ -252,22 +237,20 @@ VALUES(?, ?, ?);", -1, &stmt, NULL))
  */
 ID DeadBug::insert(DB* db, AliveBug* alivebug, Time death, ID killer_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO DeadBug(bug_id, birth, death, killer_id)\n\
-VALUES(?, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, alivebug->bug_id());
   sqlite3_bind_int(stmt, 2, alivebug->birth());
   sqlite3_bind_int(stmt, 3, death);
   sqlite3_bind_int64(stmt, 4, killer_id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
   ID id = sqlite3_last_insert_rowid(db->db());
 
-  // The bug is removed by the foreign key constraint
-  Code::remove(db, alivebug->memory_id());
+  // The code is removed by a trigger when it isn't used anymore
+  AliveBug::remove(db, alivebug->bug_id());
 
   return id;
 }
@@ -280,15 +263,13 @@ VALUES(?, ?, ?, ?);", -1, &stmt, NULL))
  */
 void DeadBug::remove(DB* db, ID bug_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM DeadBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, bug_id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -299,17 +280,15 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 void DeadBug::bug_id(ID bug_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE DeadBug\n\
 SET bug_id = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -321,19 +300,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 Time DeadBug::birth() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT birth\n\
 FROM DeadBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table DeadBug")
                                             % this->id_));
   Time birth = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return birth;
 }
@@ -345,17 +322,15 @@ id %1% not found in table DeadBug")
  */
 void DeadBug::birth(Time birth)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE DeadBug\n\
 SET birth = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int(stmt, 1, birth);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -365,19 +340,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 Time DeadBug::death() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT death\n\
 FROM DeadBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table DeadBug")
                                             % this->id_));
   Time death = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return death;
 }
@@ -389,17 +362,15 @@ id %1% not found in table DeadBug")
  */
 void DeadBug::death(Time death)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE DeadBug\n\
 SET death = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int(stmt, 1, death);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -410,19 +381,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 ID DeadBug::killer_id() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT killer_id\n\
 FROM DeadBug\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table DeadBug")
                                             % this->id_));
   ID killer_id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return killer_id;
 }
@@ -434,17 +403,15 @@ id %1% not found in table DeadBug")
  */
 void DeadBug::killer_id(ID killer_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE DeadBug\n\
 SET killer_id = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, killer_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 }
@@ -23,6 +23,7 @@
 
 #define DEFAULT_SIZE_X 16
 #define DEFAULT_SIZE_Y 16
+#define DEFAULT_SEED 0
 #define DEFAULT_TIME_ROT 64
 #define DEFAULT_SIZE_ROT 64
 #define DEFAULT_MUTATIONS_PROBABILITY 0.001
@@ -59,6 +60,8 @@ namespace db
 DefaultEnvironment default_environment = { DEFAULT_SIZE_X,
                                            DEFAULT_SIZE_Y,
 
+                                           DEFAULT_SEED,
+
                                            DEFAULT_TIME_ROT,
                                            DEFAULT_SIZE_ROT,
 
@@ -36,6 +36,8 @@ struct DefaultEnvironment
   Coord size_x;
   Coord size_y;
 
+  Uint32 seed;
+
   Time time_rot;
   Energy size_rot;
 
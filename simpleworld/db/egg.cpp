@@ -57,18 +57,16 @@ Egg::Egg(DB* db, ID bug_id)
  */
 ID Egg::insert(DB* db, ID bug_id, ID world_id, Energy energy, ID memory_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Egg(bug_id, world_id, energy, memory_id)\n\
-VALUES(?, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int64(stmt, 2, world_id);
   sqlite3_bind_int(stmt, 3, energy);
   sqlite3_bind_int64(stmt, 4, memory_id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -81,15 +79,13 @@ VALUES(?, ?, ?, ?);", -1, &stmt, NULL))
  */
 void Egg::remove(DB* db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM Egg\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -110,17 +106,15 @@ ID Egg::bug_id() const
  */
 void Egg::bug_id(ID bug_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Egg\n\
 SET bug_id = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = bug_id;
 }
@@ -133,19 +127,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 ID Egg::world_id() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT world_id\n\
 FROM Egg\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Egg")
                                             % this->id_));
   ID world_id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return world_id;
 }
@@ -157,17 +149,15 @@ id %1% not found in table Egg")
  */
 void Egg::world_id(ID world_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Egg\n\
 SET world_id = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, world_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -178,19 +168,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 Energy Egg::energy() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT energy\n\
 FROM Egg\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Egg")
                                             % this->id_));
   Energy energy = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return energy;
 }
@@ -202,17 +190,15 @@ id %1% not found in table Egg")
  */
 void Egg::energy(Energy energy)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Egg\n\
 SET energy = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int(stmt, 1, energy);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -223,19 +209,17 @@ WHERE bug_id = ?;", -1, &stmt, NULL))
  */
 ID Egg::memory_id() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT memory_id\n\
 FROM Egg\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table AliveBug")
     % this->id_));
   ID memory_id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return memory_id;
 }
@@ -247,17 +231,15 @@ id %1% not found in table AliveBug")
  */
 void Egg::memory_id(ID memory_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Egg\n\
 SET memory_id = ?\n\
-WHERE bug_id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE bug_id = ?;");
   sqlite3_bind_int64(stmt, 1, memory_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 }
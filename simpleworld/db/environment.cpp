@@ -37,11 +37,12 @@ namespace db
  * Constructor.
  * It's not checked if the id is in the table, only when accessing the data
  * the id is checked.
+ * The row is read only once, when the first column is accessed.
  * @param db database.
  * @param id id of the environment.
  */
 Environment::Environment(DB* db, ID id)
-  : Table("Environment", db, id)
+  : Table("Environment", db, id), loaded_(false)
 {
 }
 
@@ -52,6 +53,7 @@ Environment::Environment(DB* db, ID id)
  * @param time time passed since the creation of the World.
  * @param size_x size of the World (x coord).
  * @param size_y size of the World (y coord).
+ * @param seed seed of the random numbers.
  * @param time_rot time needed to rot the food.
  * @param size_rot size that is substracted to the food.
  * @param mutations_probability probability (0.0-1.0) that the code mutates.
@@ -82,7 +84,7 @@ Environment::Environment(DB* db, ID id)
  * @exception DBException if there is an error with the insertion.
  */
 ID Environment::insert(DB* db, Time time, Coord size_x, Coord size_y,
-                       Time time_rot, Energy size_rot,
+                       Uint32 seed, Time time_rot, Energy size_rot,
                        double mutations_probability, Time time_birth,
                        Time time_mutate, Time time_laziness,
                        Energy energy_laziness, double attack_multiplier,
@@ -95,9 +97,8 @@ ID Environment::insert(DB* db, Time time, Coord size_x, Coord size_y,
                        Energy energy_attack, Energy energy_eat,
                        Energy energy_egg)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
-INSERT INTO Environment(time, size_x, size_y,\n\
+  sqlite3_stmt* stmt = db->prepare("\
+INSERT INTO Environment(time, size_x, size_y, seed,\n\
                         time_rot, size_rot, mutations_probability,\n\
                         time_birth, time_mutate, time_laziness,\n\
                         energy_laziness, attack_multiplier,\n\
@@ -108,45 +109,42 @@ INSERT INTO Environment(time, size_x, size_y,\n\
                         energy_info, energy_move, energy_turn,\n\
                         energy_attack, energy_eat, energy_egg)\n\
 VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?,\n\
-       ?, ?, ?, ?, ?, ?);", -1,
-                         &stmt, NULL)) {
-    std::cout << sqlite3_errmsg(db->db()) << std::endl;
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  }
+       ?, ?, ?, ?, ?, ?, ?);");
   sqlite3_bind_int(stmt, 1, time);
-  sqlite3_bind_int(stmt, 2, size_x);
-  sqlite3_bind_int(stmt, 3, size_y);
-  sqlite3_bind_int(stmt, 4, time_rot);
-  sqlite3_bind_int(stmt, 5, size_rot);
-  sqlite3_bind_double(stmt, 6, mutations_probability);
-  sqlite3_bind_int(stmt, 7, time_birth);
-  sqlite3_bind_int(stmt, 8, time_mutate);
-  sqlite3_bind_int(stmt, 9, time_laziness);
-  sqlite3_bind_int(stmt, 10, energy_laziness);
-  sqlite3_bind_double(stmt, 11, attack_multiplier);
-  sqlite3_bind_int(stmt, 12, time_nothing);
-  sqlite3_bind_int(stmt, 13, time_myself);
-  sqlite3_bind_int(stmt, 14, time_detect);
-  sqlite3_bind_int(stmt, 15, time_info);
-  sqlite3_bind_int(stmt, 16, time_move);
-  sqlite3_bind_int(stmt, 17, time_turn);
-  sqlite3_bind_int(stmt, 18, time_attack);
-  sqlite3_bind_int(stmt, 19, time_eat);
-  sqlite3_bind_int(stmt, 20, time_egg);
-  sqlite3_bind_int(stmt, 21, energy_nothing);
-  sqlite3_bind_int(stmt, 22, energy_myself);
-  sqlite3_bind_int(stmt, 23, energy_detect);
-  sqlite3_bind_int(stmt, 24, energy_info);
-  sqlite3_bind_int(stmt, 25, energy_move);
-  sqlite3_bind_int(stmt, 26, energy_turn);
-  sqlite3_bind_int(stmt, 27, energy_attack);
-  sqlite3_bind_int(stmt, 28, energy_eat);
-  sqlite3_bind_int(stmt, 29, energy_egg);
+  sqlite3_bind_int64(stmt, 2, size_x);
+  sqlite3_bind_int64(stmt, 3, size_y);
+  sqlite3_bind_int64(stmt, 4, seed);
+  sqlite3_bind_int(stmt, 5, time_rot);
+  sqlite3_bind_int(stmt, 6, size_rot);
+  sqlite3_bind_double(stmt, 7, mutations_probability);
+  sqlite3_bind_int(stmt, 8, time_birth);
+  sqlite3_bind_int(stmt, 9, time_mutate);
+  sqlite3_bind_int(stmt, 10, time_laziness);
+  sqlite3_bind_int(stmt, 11, energy_laziness);
+  sqlite3_bind_double(stmt, 12, attack_multiplier);
+  sqlite3_bind_int(stmt, 13, time_nothing);
+  sqlite3_bind_int(stmt, 14, time_myself);
+  sqlite3_bind_int(stmt, 15, time_detect);
+  sqlite3_bind_int(stmt, 16, time_info);
+  sqlite3_bind_int(stmt, 17, time_move);
+  sqlite3_bind_int(stmt, 18, time_turn);
+  sqlite3_bind_int(stmt, 19, time_attack);
+  sqlite3_bind_int(stmt, 20, time_eat);
+  sqlite3_bind_int(stmt, 21, time_egg);
+  sqlite3_bind_int(stmt, 22, energy_nothing);
+  sqlite3_bind_int(stmt, 23, energy_myself);
+  sqlite3_bind_int(stmt, 24, energy_detect);
+  sqlite3_bind_int(stmt, 25, energy_info);
+  sqlite3_bind_int(stmt, 26, energy_move);
+  sqlite3_bind_int(stmt, 27, energy_turn);
+  sqlite3_bind_int(stmt, 28, energy_attack);
+  sqlite3_bind_int(stmt, 29, energy_eat);
+  sqlite3_bind_int(stmt, 30, energy_egg);
   if (sqlite3_step(stmt) != SQLITE_DONE) {
     std::cout << sqlite3_errmsg(db->db()) << std::endl;;
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   }
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -159,15 +157,13 @@ VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?,\n\
  */
 void Environment::remove(DB* db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -178,17 +174,15 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void Environment::id(ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = id;
 }
@@ -201,21 +195,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Time Environment::time() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT time\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Time time = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time;
+  return this->time_;
 }
 
 /**
@@ -225,17 +208,17 @@ id %1% not found in table Environment")
  */
 void Environment::time(Time time)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET time = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_ = time;
 }
 
 
@@ -246,21 +229,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Coord Environment::size_x() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT size_x\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Coord size_x = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return size_x;
+  return this->size_x_;
 }
 
 /**
@@ -270,21 +242,10 @@ id %1% not found in table Environment")
  */
 Coord Environment::size_y() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT size_y\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Coord size_y = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return size_y;
+  return this->size_y_;
 }
 
 /**
@@ -294,17 +255,17 @@ id %1% not found in table Environment")
  */
 void Environment::size_x(Coord size_x)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET size_x = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, size_x);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, size_x);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->size_x_ = size_x;
 }
 
 /**
@@ -314,17 +275,51 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void Environment::size_y(Coord size_y)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET size_y = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, size_y);
+  sqlite3_bind_int64(stmt, 2, this->id_);
+  if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, size_y);
+  sqlite3_reset(stmt);
+
+  this->size_y_ = size_y;
+}
+
+
+/**
+ * Get the seed of the random numbers.
+ * @return the seed.
+ * @exception DBException if there is an error with the query.
+ */
+Uint32 Environment::seed() const
+{
+  if (not this->loaded_)
+    this->load_();
+
+  return this->seed_;
+}
+
+/**
+ * Set the seed of the random numbers.
+ * @param seed the new seed.
+ * @exception DBException if there is an error with the update.
+ */
+void Environment::seed(Uint32 seed)
+{
+  sqlite3_stmt* stmt = this->db_->prepare("\
+UPDATE Environment\n\
+SET seed = ?\n\
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, seed);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->seed_ = seed;
 }
 
 
@@ -335,23 +330,10 @@ WHERE id = ?;", -1, &stmt, NULL))
 */
 Time Environment::time_rot() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT time_rot\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL)) {
-    std::cout << sqlite3_errmsg(this->db_->db()) << std::endl;
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  }
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Time time_rot = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_rot;
+  return this->time_rot_;
 }
 
 /**
@@ -361,21 +343,19 @@ Time Environment::time_rot() const
 */
 void Environment::time_rot(Time time_rot)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET time_rot = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL)) {
-    std::cout << sqlite3_errmsg(this->db_->db()) << std::endl;
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  }
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_rot);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE) {
     std::cout << sqlite3_errmsg(this->db_->db()) << std::endl;
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
   }
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_rot_ = time_rot;
 }
 
 /**
@@ -385,21 +365,10 @@ void Environment::time_rot(Time time_rot)
 */
 Energy Environment::size_rot() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT size_rot\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Energy size_rot = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return size_rot;
+  return this->size_rot_;
 }
 
 /**
@@ -409,17 +378,17 @@ Energy Environment::size_rot() const
 */
 void Environment::size_rot(Energy size_rot)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET size_rot = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, size_rot);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->size_rot_ = size_rot;
 }
 
 
@@ -430,21 +399,10 @@ void Environment::size_rot(Energy size_rot)
  */
 double Environment::mutations_probability() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT mutations_probability\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  double mutations_probability = sqlite3_column_double(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return mutations_probability;
+  return this->mutations_probability_;
 }
 
 /**
@@ -454,17 +412,17 @@ id %1% not found in table Environment")
  */
 void Environment::mutations_probability(double mutations_probability)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET mutations_probability = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_double(stmt, 1, mutations_probability);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->mutations_probability_ = mutations_probability;
 }
 
 
@@ -475,21 +433,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Time Environment::time_birth() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT time_birth\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Time time_birth = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_birth;
+  return this->time_birth_;
 }
 
 /**
@@ -499,17 +446,17 @@ id %1% not found in table Environment")
  */
 void Environment::time_birth(Time time_birth)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET time_birth = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_birth);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_birth_ = time_birth;
 }
 
 
@@ -520,21 +467,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Time Environment::time_mutate() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT time_mutate\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Time time_mutate = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_mutate;
+  return this->time_mutate_;
 }
 
 /**
@@ -544,17 +480,17 @@ id %1% not found in table Environment")
  */
 void Environment::time_mutate(Time time_mutate)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET time_mutate = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_mutate);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_mutate_ = time_mutate;
 }
 
 
@@ -565,21 +501,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Time Environment::time_laziness() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT time_laziness\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Time time_laziness = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_laziness;
+  return this->time_laziness_;
 }
 
 /**
@@ -589,17 +514,17 @@ id %1% not found in table Environment")
  */
 void Environment::time_laziness(Time time_laziness)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET time_laziness = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_laziness);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_laziness_ = time_laziness;
 }
 
 
@@ -610,21 +535,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Environment::energy_laziness() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy_laziness\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Energy energy_laziness = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy_laziness;
+  return this->energy_laziness_;
 }
 
 /**
@@ -634,17 +548,17 @@ id %1% not found in table Environment")
  */
 void Environment::energy_laziness(Energy energy_laziness)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET energy_laziness = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy_laziness);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_laziness_ = energy_laziness;
 }
 
 
@@ -655,21 +569,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 double Environment::attack_multiplier() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT attack_multiplier\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  double attack_multiplier = sqlite3_column_double(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return attack_multiplier;
+  return this->attack_multiplier_;
 }
 
 /**
@@ -679,17 +582,17 @@ id %1% not found in table Environment")
  */
 void Environment::attack_multiplier(double attack_multiplier)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET attack_multiplier = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_double(stmt, 1, attack_multiplier);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->attack_multiplier_ = attack_multiplier;
 }
 
 
@@ -700,21 +603,10 @@ WHERE id = ?;", -1, &stmt, NULL))
 */
 Time Environment::time_nothing() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT time_nothing\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Time time_nothing = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_nothing;
+  return this->time_nothing_;
 }
 
 /**
@@ -724,17 +616,17 @@ Time Environment::time_nothing() const
 */
 void Environment::time_nothing(Time time_nothing)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET time_nothing = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_nothing);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_nothing_ = time_nothing;
 }
 
 
@@ -745,21 +637,10 @@ void Environment::time_nothing(Time time_nothing)
 */
 Time Environment::time_myself() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT time_myself\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Time time_myself = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_myself;
+  return this->time_myself_;
 }
 
 /**
@@ -769,17 +650,17 @@ Time Environment::time_myself() const
 */
 void Environment::time_myself(Time time_myself)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET time_myself = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_myself);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_myself_ = time_myself;
 }
 
 
@@ -790,21 +671,10 @@ void Environment::time_myself(Time time_myself)
 */
 Time Environment::time_detect() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT time_detect\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Time time_detect = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_detect;
+  return this->time_detect_;
 }
 
 /**
@@ -814,17 +684,17 @@ Time Environment::time_detect() const
 */
 void Environment::time_detect(Time time_detect)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET time_detect = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_detect);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_detect_ = time_detect;
 }
 
 
@@ -835,21 +705,10 @@ void Environment::time_detect(Time time_detect)
 */
 Time Environment::time_info() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT time_info\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Time time_info = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_info;
+  return this->time_info_;
 }
 
 /**
@@ -859,17 +718,17 @@ Time Environment::time_info() const
 */
 void Environment::time_info(Time time_info)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET time_info = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_info);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_info_ = time_info;
 }
 
 
@@ -880,21 +739,10 @@ void Environment::time_info(Time time_info)
 */
 Time Environment::time_move() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT time_move\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Time time_move = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_move;
+  return this->time_move_;
 }
 
 /**
@@ -904,17 +752,17 @@ Time Environment::time_move() const
 */
 void Environment::time_move(Time time_move)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET time_move = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_move);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_move_ = time_move;
 }
 
 
@@ -925,21 +773,10 @@ void Environment::time_move(Time time_move)
 */
 Time Environment::time_turn() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT time_turn\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Time time_turn = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_turn;
+  return this->time_turn_;
 }
 
 /**
@@ -949,17 +786,17 @@ Time Environment::time_turn() const
 */
 void Environment::time_turn(Time time_turn)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET time_turn = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_turn);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_turn_ = time_turn;
 }
 
 
@@ -970,21 +807,10 @@ void Environment::time_turn(Time time_turn)
 */
 Time Environment::time_attack() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT time_attack\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Time time_attack = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_attack;
+  return this->time_attack_;
 }
 
 /**
@@ -994,17 +820,17 @@ Time Environment::time_attack() const
 */
 void Environment::time_attack(Time time_attack)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET time_attack = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_attack);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_attack_ = time_attack;
 }
 
 
@@ -1015,21 +841,10 @@ void Environment::time_attack(Time time_attack)
 */
 Time Environment::time_eat() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT time_eat\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Time time_eat = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_eat;
+  return this->time_eat_;
 }
 
 /**
@@ -1039,17 +854,17 @@ Time Environment::time_eat() const
 */
 void Environment::time_eat(Time time_eat)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET time_eat = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_eat);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_eat_ = time_eat;
 }
 
 
@@ -1060,21 +875,10 @@ void Environment::time_eat(Time time_eat)
 */
 Time Environment::time_egg() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-    SELECT time_egg\n\
-    FROM Environment\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-    id %1% not found in table Environment")
-    % this->id_));
-  Time time_egg = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return time_egg;
+  return this->time_egg_;
 }
 
 /**
@@ -1084,17 +888,17 @@ Time Environment::time_egg() const
 */
 void Environment::time_egg(Time time_egg)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
     UPDATE Environment\n\
     SET time_egg = ?\n\
-    WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+    WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time_egg);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->time_egg_ = time_egg;
 }
 
 
@@ -1105,21 +909,10 @@ void Environment::time_egg(Time time_egg)
  */
 Energy Environment::energy_nothing() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy_nothing\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Energy energy_nothing = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy_nothing;
+  return this->energy_nothing_;
 }
 
 /**
@@ -1129,17 +922,17 @@ id %1% not found in table Environment")
  */
 void Environment::energy_nothing(Energy energy_nothing)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET energy_nothing = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy_nothing);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_nothing_ = energy_nothing;
 }
 
 
@@ -1150,21 +943,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Environment::energy_myself() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy_myself\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Energy energy_myself = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy_myself;
+  return this->energy_myself_;
 }
 
 /**
@@ -1174,17 +956,17 @@ id %1% not found in table Environment")
  */
 void Environment::energy_myself(Energy energy_myself)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET energy_myself = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy_myself);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_myself_ = energy_myself;
 }
 
 
@@ -1195,21 +977,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Environment::energy_detect() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy_detect\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Energy energy_detect = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy_detect;
+  return this->energy_detect_;
 }
 
 /**
@@ -1219,17 +990,17 @@ id %1% not found in table Environment")
  */
 void Environment::energy_detect(Energy energy_detect)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET energy_detect = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy_detect);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_detect_ = energy_detect;
 }
 
 
@@ -1240,21 +1011,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Environment::energy_info() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy_info\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Energy energy_info = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy_info;
+  return this->energy_info_;
 }
 
 /**
@@ -1264,17 +1024,17 @@ id %1% not found in table Environment")
  */
 void Environment::energy_info(Energy energy_info)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET energy_info = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy_info);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_info_ = energy_info;
 }
 
 
@@ -1285,21 +1045,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Environment::energy_move() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy_move\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Energy energy_move = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy_move;
+  return this->energy_move_;
 }
 
 /**
@@ -1309,17 +1058,17 @@ id %1% not found in table Environment")
  */
 void Environment::energy_move(Energy energy_move)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET energy_move = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy_move);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_move_ = energy_move;
 }
 
 
@@ -1330,21 +1079,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Environment::energy_turn() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy_turn\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Energy energy_turn = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy_turn;
+  return this->energy_turn_;
 }
 
 /**
@@ -1354,17 +1092,17 @@ id %1% not found in table Environment")
  */
 void Environment::energy_turn(Energy energy_turn)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET energy_turn = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy_turn);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_turn_ = energy_turn;
 }
 
 
@@ -1375,21 +1113,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Environment::energy_attack() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy_attack\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Energy energy_attack = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy_attack;
+  return this->energy_attack_;
 }
 
 /**
@@ -1399,17 +1126,17 @@ id %1% not found in table Environment")
  */
 void Environment::energy_attack(Energy energy_attack)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET energy_attack = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy_attack);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_attack_ = energy_attack;
 }
 
 
@@ -1420,21 +1147,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Environment::energy_eat() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy_eat\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Energy energy_eat = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy_eat;
+  return this->energy_eat_;
 }
 
 /**
@@ -1444,17 +1160,17 @@ id %1% not found in table Environment")
  */
 void Environment::energy_eat(Energy energy_eat)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET energy_eat = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy_eat);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_eat_ = energy_eat;
 }
 
 
@@ -1465,21 +1181,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Environment::energy_egg() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy_egg\n\
-FROM Environment\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Environment")
-                                            % this->id_));
-  Energy energy_egg = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy_egg;
+  return this->energy_egg_;
 }
 
 /**
@@ -1489,17 +1194,73 @@ id %1% not found in table Environment")
  */
 void Environment::energy_egg(Energy energy_egg)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Environment\n\
 SET energy_egg = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy_egg);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_egg_ = energy_egg;
+}
+
+
+/**
+ * Read the columns of the environment.
+ * @exception DBException if there is an error with the query.
+ */
+void Environment::load_() const
+{
+  sqlite3_stmt* stmt = this->db_->prepare("\
+SELECT time, size_x, size_y, seed, time_rot, size_rot, mutations_probability,\n\
+       time_birth, time_mutate, time_laziness, energy_laziness,\n\
+       attack_multiplier, time_nothing, time_myself, time_detect,\n\
+       time_info, time_move, time_turn, time_attack, time_eat, time_egg,\n\
+       energy_nothing, energy_myself, energy_detect, energy_info,\n\
+       energy_move, energy_turn, energy_attack, energy_eat, energy_egg\n\
+FROM Environment\n\
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, this->id_);
+  if (sqlite3_step(stmt) != SQLITE_ROW)
+    throw EXCEPTION(DBException, boost::str(boost::format("\
+id %1% not found in table Environment")
+                                            % this->id_));
+  this->time_ = sqlite3_column_int(stmt, 0);
+  this->size_x_ = sqlite3_column_int64(stmt, 1);
+  this->size_y_ = sqlite3_column_int64(stmt, 2);
+  this->seed_ = sqlite3_column_int64(stmt, 3);
+  this->time_rot_ = sqlite3_column_int(stmt, 4);
+  this->size_rot_ = sqlite3_column_int(stmt, 5);
+  this->mutations_probability_ = sqlite3_column_double(stmt, 6);
+  this->time_birth_ = sqlite3_column_int(stmt, 7);
+  this->time_mutate_ = sqlite3_column_int(stmt, 8);
+  this->time_laziness_ = sqlite3_column_int(stmt, 9);
+  this->energy_laziness_ = sqlite3_column_int(stmt, 10);
+  this->attack_multiplier_ = sqlite3_column_double(stmt, 11);
+  this->time_nothing_ = sqlite3_column_int(stmt, 12);
+  this->time_myself_ = sqlite3_column_int(stmt, 13);
+  this->time_detect_ = sqlite3_column_int(stmt, 14);
+  this->time_info_ = sqlite3_column_int(stmt, 15);
+  this->time_move_ = sqlite3_column_int(stmt, 16);
+  this->time_turn_ = sqlite3_column_int(stmt, 17);
+  this->time_attack_ = sqlite3_column_int(stmt, 18);
+  this->time_eat_ = sqlite3_column_int(stmt, 19);
+  this->time_egg_ = sqlite3_column_int(stmt, 20);
+  this->energy_nothing_ = sqlite3_column_int(stmt, 21);
+  this->energy_myself_ = sqlite3_column_int(stmt, 22);
+  this->energy_detect_ = sqlite3_column_int(stmt, 23);
+  this->energy_info_ = sqlite3_column_int(stmt, 24);
+  this->energy_move_ = sqlite3_column_int(stmt, 25);
+  this->energy_turn_ = sqlite3_column_int(stmt, 26);
+  this->energy_attack_ = sqlite3_column_int(stmt, 27);
+  this->energy_eat_ = sqlite3_column_int(stmt, 28);
+  this->energy_egg_ = sqlite3_column_int(stmt, 29);
+  sqlite3_reset(stmt);
+
+  this->loaded_ = true;
 }
 
 }
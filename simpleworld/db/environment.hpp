@@ -21,6 +21,7 @@
 #ifndef SIMPLEWORLD_DB_ENVIRONMENT_HPP
 #define SIMPLEWORLD_DB_ENVIRONMENT_HPP
 
+#include <simpleworld/ints.hpp>
 #include <simpleworld/db/types.hpp>
 #include <simpleworld/db/db.hpp>
 #include <simpleworld/db/table.hpp>
@@ -40,6 +41,7 @@ public:
    * Constructor.
    * It's not checked if the id is in the table, only when accessing the data
    * the id is checked.
+   * The row is read only once, when the first column is accessed.
    * @param db database.
    * @param id id of the environment.
    */
@@ -52,6 +54,7 @@ public:
    * @param time time passed since the creation of the World.
    * @param size_x size of the World (x coord).
    * @param size_y size of the World (y coord).
+   * @param seed seed of the random numbers.
    * @param time_rot time needed to rot the food.
    * @param size_rot size that is substracted to the food.
    * @param mutations_probability probability (0.0-1.0) that the code mutates.
@@ -82,7 +85,7 @@ public:
    * @exception DBException if there is an error with the insertion.
    */
   static ID insert(DB* db, Time time, Coord size_x, Coord size_y,
-                   Time time_rot, Energy size_rot,
+                   Uint32 seed, Time time_rot, Energy size_rot,
                    double mutations_probability, Time time_birth,
                    Time time_mutate, Time time_laziness,
                    Energy energy_laziness, double attack_multiplier,
@@ -163,6 +166,21 @@ public:
   void size_y(Coord size_y);
 
 
+  /**
+   * Get the seed of the random numbers.
+   * @return the seed.
+   * @exception DBException if there is an error with the query.
+   */
+  Uint32 seed() const;
+
+  /**
+   * Set the seed of the random numbers.
+   * @param seed the new seed.
+   * @exception DBException if there is an error with the update.
+   */
+  void seed(Uint32 seed);
+
+
   /**
    * Get the time needed to rot the food.
    * @return the time.
@@ -550,6 +568,45 @@ public:
    * @exception DBException if there is an error with the update.
    */
   void energy_egg(Energy energy_egg);
+
+private:
+  /**
+   * Read the columns of the environment.
+   * @exception DBException if there is an error with the query.
+   */
+  void load_() const;
+
+  mutable bool loaded_;         /**< If the columns were read */
+  mutable Time time_;           /**< Time passed since the creation */
+  mutable Coord size_x_;        /**< Size of the World (x coord) */
+  mutable Coord size_y_;        /**< Size of the World (y coord) */
+  mutable Uint32 seed_;         /**< Seed of the random numbers */
+  mutable Time time_rot_;       /**< Time needed to rot the food */
+  mutable Energy size_rot_;     /**< Size that is substracted to the food */
+  mutable double mutations_probability_; /**< Probability of mutation */
+  mutable Time time_birth_;     /**< Time needed to convert a egg into a bug */
+  mutable Time time_mutate_;    /**< Time to mutate the code of a old bug */
+  mutable Time time_laziness_;  /**< Time to be considered lazy */
+  mutable Energy energy_laziness_; /**< Energy for laziness */
+  mutable double attack_multiplier_; /**< Multiplier for the attacks */
+  mutable Time time_nothing_;   /**< Time needed to do the action nothing */
+  mutable Time time_myself_;    /**< Time needed to do the action myself */
+  mutable Time time_detect_;    /**< Time needed to do the action detect */
+  mutable Time time_info_;      /**< Time needed to do the action info */
+  mutable Time time_move_;      /**< Time needed to do the action move */
+  mutable Time time_turn_;      /**< Time needed to do the action turn */
+  mutable Time time_attack_;    /**< Time needed to do the action attack */
+  mutable Time time_eat_;       /**< Time needed to do the action eat */
+  mutable Time time_egg_;       /**< Time needed to do the action egg */
+  mutable Energy energy_nothing_; /**< Energy used to do the action nothing */
+  mutable Energy energy_myself_; /**< Energy used to do the action myself */
+  mutable Energy energy_detect_; /**< Energy used to do the action detect */
+  mutable Energy energy_info_;  /**< Energy used to do the action info */
+  mutable Energy energy_move_;  /**< Energy used to do the action move */
+  mutable Energy energy_turn_;  /**< Energy used to do the action turn */
+  mutable Energy energy_attack_; /**< Energy used to do the action attack */
+  mutable Energy energy_eat_;   /**< Energy used to do the action eat */
+  mutable Energy energy_egg_;   /**< Energy used to do the action egg */
 };
 
 }
@@ -19,6 +19,7 @@
  */
 
 #include <string>
+#include <algorithm>
 
 #include <boost/format.hpp>
 
@@ -28,6 +29,10 @@
 #include "mutation.hpp"
 #include <boost/concept_check.hpp>
 
+// Maximum number of rows inserted by a statement: 4 parameters for each
+// row must be under the default limit of SQLite (999)
+#define MAX_ROWS 64
+
 namespace simpleworld
 {
 namespace db
@@ -60,11 +65,9 @@ Mutation::Mutation(DB* db, ID bug_id)
 ID Mutation::insert_mutation(DB* db, ID bug_id, Time time, Uint32 position,
                              Uint32 original, Uint32 mutated)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Mutation(bug_id, time, type, position, original, mutated)\n\
-VALUES(?, ?, 0, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, 0, ?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int(stmt, 2, time);
   sqlite3_bind_int(stmt, 3, position);
@@ -72,7 +75,7 @@ VALUES(?, ?, 0, ?, ?, ?);", -1, &stmt, NULL))
   sqlite3_bind_int(stmt, 5, mutated);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -91,11 +94,9 @@ VALUES(?, ?, 0, ?, ?, ?);", -1, &stmt, NULL))
 ID Mutation::insert_partial(DB* db, ID bug_id, Time time, Uint32 position,
                             Uint32 original, Uint32 mutated)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Mutation(bug_id, time, type, position, original, mutated)\n\
-VALUES(?, ?, 1, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, 1, ?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int(stmt, 2, time);
   sqlite3_bind_int(stmt, 3, position);
@@ -103,7 +104,7 @@ VALUES(?, ?, 1, ?, ?, ?);", -1, &stmt, NULL))
   sqlite3_bind_int(stmt, 5, mutated);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -122,11 +123,9 @@ VALUES(?, ?, 1, ?, ?, ?);", -1, &stmt, NULL))
 ID Mutation::insert_permutation(DB* db, ID bug_id, Time time, Uint32 position,
                                 Uint32 original, Uint32 mutated)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Mutation(bug_id, time, type, position, original, mutated)\n\
-VALUES(?, ?, 2, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, 2, ?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int(stmt, 2, time);
   sqlite3_bind_int(stmt, 3, position);
@@ -134,7 +133,7 @@ VALUES(?, ?, 2, ?, ?, ?);", -1, &stmt, NULL))
   sqlite3_bind_int(stmt, 5, mutated);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -152,18 +151,16 @@ VALUES(?, ?, 2, ?, ?, ?);", -1, &stmt, NULL))
 ID Mutation::insert_addition(DB* db, ID bug_id, Time time, Uint32 position,
                              Uint32 mutated)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Mutation(bug_id, time, type, position, mutated)\n\
-VALUES(?, ?, 3, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, 3, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int(stmt, 2, time);
   sqlite3_bind_int(stmt, 3, position);
   sqlite3_bind_int(stmt, 4, mutated);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -181,18 +178,16 @@ VALUES(?, ?, 3, ?, ?);", -1, &stmt, NULL))
 ID Mutation::insert_duplication(DB* db, ID bug_id, Time time, Uint32 position,
                                 Uint32 mutated)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Mutation(bug_id, time, type, position, mutated)\n\
-VALUES(?, ?, 4, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, 4, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int(stmt, 2, time);
   sqlite3_bind_int(stmt, 3, position);
   sqlite3_bind_int(stmt, 4, mutated);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -210,22 +205,71 @@ VALUES(?, ?, 4, ?, ?);", -1, &stmt, NULL))
 ID Mutation::insert_deletion(DB* db, ID bug_id, Time time, Uint32 position,
                              Uint32 original)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Mutation(bug_id, time, type, position, original)\n\
-VALUES(?, ?, 5, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, 5, ?, ?);");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int(stmt, 2, time);
   sqlite3_bind_int(stmt, 3, position);
   sqlite3_bind_int(stmt, 4, original);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
 
+/**
+ * Insert several mutations of a bug.
+ * The rows are inserted with as few statements as possible.
+ * @param db database.
+ * @param bug_id id of the bug.
+ * @param time when the mutations happened.
+ * @param mutations the mutations.
+ * @exception DBException if there is an error with the insertion.
+ */
+void Mutation::insert(DB* db, ID bug_id, Time time,
+                      const std::vector<Data>& mutations)
+{
+  std::vector<Data>::size_type first = 0;
+  while (first < mutations.size()) {
+    std::vector<Data>::size_type rows =
+      std::min(mutations.size() - first,
+               static_cast<std::vector<Data>::size_type>(MAX_ROWS));
+
+    // the statements are cached, so the SQL only depends on the rows
+    std::string sql = "\
+INSERT INTO Mutation(bug_id, time, type, position, original, mutated)\n\
+VALUES(?1, ?2, ?, ?, ?, ?)";
+    for (std::vector<Data>::size_type row = 1; row < rows; row++)
+      sql += ",\n      (?1, ?2, ?, ?, ?, ?)";
+    sql += ";";
+
+    sqlite3_stmt* stmt = db->prepare(sql);
+    sqlite3_bind_int64(stmt, 1, bug_id);
+    sqlite3_bind_int(stmt, 2, time);
+    for (std::vector<Data>::size_type row = 0; row < rows; row++) {
+      const Data& mutation = mutations[first + row];
+      int index = 3 + row * 4;
+      sqlite3_bind_int(stmt, index, static_cast<int>(mutation.type));
+      sqlite3_bind_int(stmt, index + 1, mutation.position);
+      if (mutation.type == Addition or mutation.type == Duplication)
+        sqlite3_bind_null(stmt, index + 2);
+      else
+        sqlite3_bind_int(stmt, index + 2, mutation.original);
+      if (mutation.type == Deletion)
+        sqlite3_bind_null(stmt, index + 3);
+      else
+        sqlite3_bind_int(stmt, index + 3, mutation.mutated);
+    }
+    if (sqlite3_step(stmt) != SQLITE_DONE)
+      throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+    sqlite3_reset(stmt);
+
+    first += rows;
+  }
+}
+
 /**
  * Delete a mutation.
  * @param db database.
@@ -234,15 +278,13 @@ VALUES(?, ?, 5, ?, ?);", -1, &stmt, NULL))
  */
 void Mutation::remove(DB* db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM Mutation\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -253,17 +295,15 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void Mutation::id(ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Mutation\n\
 SET id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = id;
 }
@@ -276,19 +316,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 ID Mutation::bug_id() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT bug_id\n\
 FROM Mutation\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Mutation")
                                             % this->id_));
   ID id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return id;
 }
@@ -300,17 +338,15 @@ id %1% not found in table Mutation")
  */
 void Mutation::bug_id(ID bug_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Mutation\n\
 SET bug_id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, bug_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -321,19 +357,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Time Mutation::time() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT time\n\
 FROM Mutation\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Mutation")
                                             % this->id_));
   Time time = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return time;
 }
@@ -345,17 +379,15 @@ id %1% not found in table Mutation")
  */
 void Mutation::time(Time time)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Mutation\n\
 SET time = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -366,19 +398,17 @@ WHERE id = ?;", -1, &stmt, NULL))
 */
 Mutation::Type Mutation::type() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT type\n\
 FROM Mutation\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Mutation")
                                             % this->id_));
   Uint32 type = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return static_cast<Mutation::Type>(type);
 }
@@ -390,17 +420,15 @@ id %1% not found in table Mutation")
 */
 void Mutation::type(Mutation::Type type)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Mutation\n\
 SET type = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, static_cast<int>(type));
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -410,19 +438,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Mutation::position() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT position\n\
 FROM Mutation\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Mutation")
                                             % this->id_));
   Uint32 position = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return position;
 }
@@ -434,17 +460,15 @@ id %1% not found in table Mutation")
  */
 void Mutation::position(Uint32 position)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Mutation\n\
 SET position = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, position);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -455,19 +479,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Mutation::original() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT original\n\
 FROM Mutation\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Mutation")
                                             % this->id_));
   Uint32 original = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return original;
 }
@@ -479,17 +501,15 @@ id %1% not found in table Mutation")
  */
 void Mutation::original(Uint32 original)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Mutation\n\
 SET original = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, original);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -500,19 +520,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Mutation::mutated() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT mutated\n\
 FROM Mutation\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Mutation")
                                             % this->id_));
   Uint32 mutated = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return mutated;
 }
@@ -524,17 +542,15 @@ id %1% not found in table Mutation")
  */
 void Mutation::mutated(Uint32 mutated)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Mutation\n\
 SET mutated = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, mutated);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 }
@@ -21,6 +21,8 @@
 #ifndef SIMPLEWORLD_DB_MUTATION_HPP
 #define SIMPLEWORLD_DB_MUTATION_HPP
 
+#include <vector>
+
 #include <simpleworld/ints.hpp>
 #include <simpleworld/types.hpp>
 #include <simpleworld/db/types.hpp>
@@ -51,6 +53,18 @@ public:
   };
 
 
+  /**
+   * Data of a mutation to insert.
+   */
+  struct Data
+  {
+    Type type;                  /**< Type of mutation */
+    Uint32 position;            /**< Where the mutation happened */
+    Uint32 original;            /**< Not used by additions/duplications */
+    Uint32 mutated;             /**< Not used by deletions */
+  };
+
+
   /**
    * Constructor.
    * It's not checked if the id is in the table, only when accessing the data
@@ -142,6 +156,18 @@ public:
   static ID insert_deletion(DB* db, ID bug_id, Time time, Uint32 position,
                             Uint32 original);
 
+  /**
+   * Insert several mutations of a bug.
+   * The rows are inserted with as few statements as possible.
+   * @param db database.
+   * @param bug_id id of the bug.
+   * @param time when the mutations happened.
+   * @param mutations the mutations.
+   * @exception DBException if there is an error with the insertion.
+   */
+  static void insert(DB* db, ID bug_id, Time time,
+                     const std::vector<Data>& mutations);
+
   /**
    * Delete a mutation.
    * @param db database.
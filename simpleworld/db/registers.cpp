@@ -54,15 +54,13 @@ Registers::Registers(DB* db, ID id)
  */
 ID Registers::insert(DB* db, const void* data, Uint32 size)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Registers(data)\n\
-VALUES(?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?);");
   sqlite3_bind_blob(stmt, 1, data, size, SQLITE_TRANSIENT);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -75,15 +73,13 @@ VALUES(?);", -1, &stmt, NULL))
  */
 ID Registers::insert(DB* db)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
     INSERT INTO Registers(data)\n\
-    VALUES(?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+    VALUES(?);");
   sqlite3_bind_zeroblob(stmt, 1, TOTAL_REGISTERS * sizeof(cpu::Word));
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -96,15 +92,13 @@ ID Registers::insert(DB* db)
  */
 void Registers::remove(DB* db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM Registers\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -115,17 +109,15 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void Registers::id(ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Registers\n\
 SET id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = id;
 }
@@ -141,5 +133,46 @@ Blob Registers::data() const
   return Blob(this->db_, "Registers", "data", this->id_);
 }
 
+
+/**
+ * Get if the CPU is running.
+ * @return true if the CPU is running, false if it was stopped.
+ * @exception DBException if there is an error with the query.
+ */
+bool Registers::running() const
+{
+  sqlite3_stmt* stmt = this->db_->prepare("\
+SELECT running\n\
+FROM Registers\n\
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, this->id_);
+  if (sqlite3_step(stmt) != SQLITE_ROW)
+    throw EXCEPTION(DBException, boost::str(boost::format("\
+id %1% not found in table Registers")
+                                            % this->id_));
+  bool running = sqlite3_column_int(stmt, 0) != 0;
+  sqlite3_reset(stmt);
+
+  return running;
+}
+
+/**
+ * Set if the CPU is running.
+ * @param running true if the CPU is running, false if it was stopped.
+ * @exception DBException if there is an error with the update.
+ */
+void Registers::running(bool running)
+{
+  sqlite3_stmt* stmt = this->db_->prepare("\
+UPDATE Registers\n\
+SET running = ?\n\
+WHERE id = ?;");
+  sqlite3_bind_int(stmt, 1, running ? 1 : 0);
+  sqlite3_bind_int64(stmt, 2, this->id_);
+  if (sqlite3_step(stmt) != SQLITE_DONE)
+    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+  sqlite3_reset(stmt);
+}
+
 }
 }
@@ -95,6 +95,21 @@ public:
    * @exception DBException if there is an error with the query.
    */
   Blob data() const;
+
+
+  /**
+   * Get if the CPU is running.
+   * @return true if the CPU is running, false if it was stopped.
+   * @exception DBException if there is an error with the query.
+   */
+  bool running() const;
+
+  /**
+   * Set if the CPU is running.
+   * @param running true if the CPU is running, false if it was stopped.
+   * @exception DBException if there is an error with the update.
+   */
+  void running(bool running);
 };
 
 }
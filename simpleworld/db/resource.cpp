@@ -34,11 +34,12 @@ namespace db
  * Constructor.
  * It's not checked if the id is in the table, only when accessing the data
  * the id is checked.
+ * The row is read only once, when the first column is accessed.
  * @param db database.
  * @param id id of the resource.
  */
 Resource::Resource(DB* db, ID id)
-  : Table("Resource", db, id)
+  : Table("Resource", db, id), loaded_(false)
 {
 }
 
@@ -56,25 +57,23 @@ Resource::Resource(DB* db, ID id)
  * @return the id of the new row (the same as bug_id).
  * @exception DBException if there is an error with the insertion.
  */
-ID Resource::insert(DB* db, Time frequency, Uint16 max,
+ID Resource::insert(DB* db, Time frequency, Uint32 max,
                     Coord start_x, Coord start_y, Coord end_x, Coord end_y,
                     Energy size)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Resource(frequency, max, start_x, start_y, end_x, end_y, size)\n\
-VALUES(?, ?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?, ?, ?, ?, ?);");
   sqlite3_bind_int(stmt, 1, frequency);
-  sqlite3_bind_int(stmt, 2, max);
-  sqlite3_bind_int(stmt, 3, start_x);
-  sqlite3_bind_int(stmt, 4, start_y);
-  sqlite3_bind_int(stmt, 5, end_x);
-  sqlite3_bind_int(stmt, 6, end_y);
+  sqlite3_bind_int64(stmt, 2, max);
+  sqlite3_bind_int64(stmt, 3, start_x);
+  sqlite3_bind_int64(stmt, 4, start_y);
+  sqlite3_bind_int64(stmt, 5, end_x);
+  sqlite3_bind_int64(stmt, 6, end_y);
   sqlite3_bind_int(stmt, 7, size);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -87,15 +86,13 @@ VALUES(?, ?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
  */
 void Resource::remove(DB* db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM Resource\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -106,17 +103,15 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void Resource::id(ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Resource\n\
 SET id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = id;
 }
@@ -129,21 +124,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Time Resource::frequency() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT frequency\n\
-FROM Resource\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Resource")
-                                            % this->id_));
-  Time frequency = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return frequency;
+  return this->frequency_;
 }
 
 /**
@@ -153,17 +137,17 @@ id %1% not found in table Resource")
  */
 void Resource::frequency(Time frequency)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Resource\n\
 SET frequency = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, frequency);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->frequency_ = frequency;
 }
 
 
@@ -172,23 +156,12 @@ WHERE id = ?;", -1, &stmt, NULL))
  * @return the maximum.
  * @exception DBException if there is an error with the query.
  */
-Uint16 Resource::max() const
+Uint32 Resource::max() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT max\n\
-FROM Resource\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Resource")
-                                            % this->id_));
-  Uint16 max = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return max;
+  return this->max_;
 }
 
 /**
@@ -196,19 +169,19 @@ id %1% not found in table Resource")
  * @param max the new maximum.
  * @exception DBException if there is an error with the update.
  */
-void Resource::max(Uint16 max)
+void Resource::max(Uint32 max)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Resource\n\
 SET max = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, max);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, max);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->max_ = max;
 }
 
 /**
@@ -218,21 +191,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Coord Resource::start_x() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT start_x\n\
-FROM Resource\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Resource")
-                                            % this->id_));
-  Coord start_x = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return start_x;
+  return this->start_x_;
 }
 
 /**
@@ -242,17 +204,17 @@ id %1% not found in table Resource")
  */
 void Resource::start_x(Coord start_x)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Resource\n\
 SET start_x = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, start_x);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, start_x);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->start_x_ = start_x;
 }
 
 /**
@@ -262,21 +224,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Coord Resource::start_y() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT start_y\n\
-FROM Resource\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Resource")
-                                            % this->id_));
-  Coord start_y = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return start_y;
+  return this->start_y_;
 }
 
 /**
@@ -286,17 +237,17 @@ id %1% not found in table Resource")
  */
 void Resource::start_y(Coord start_y)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Resource\n\
 SET start_y = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, start_y);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, start_y);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->start_y_ = start_y;
 }
 
 /**
@@ -306,21 +257,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Coord Resource::end_x() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT end_x\n\
-FROM Resource\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Resource")
-                                            % this->id_));
-  Coord end_x = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return end_x;
+  return this->end_x_;
 }
 
 /**
@@ -330,17 +270,17 @@ id %1% not found in table Resource")
  */
 void Resource::end_x(Coord end_x)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Resource\n\
 SET end_x = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, end_x);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, end_x);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->end_x_ = end_x;
 }
 
 /**
@@ -350,21 +290,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Coord Resource::end_y() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT end_y\n\
-FROM Resource\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Resource")
-                                            % this->id_));
-  Coord end_y = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return end_y;
+  return this->end_y_;
 }
 
 /**
@@ -374,17 +303,17 @@ id %1% not found in table Resource")
  */
 void Resource::end_y(Coord end_y)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Resource\n\
 SET end_y = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, end_y);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, end_y);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->end_y_ = end_y;
 }
 
 
@@ -395,21 +324,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Resource::size() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT size\n\
-FROM Resource\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Resource")
-                                            % this->id_));
-  Energy size = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return size;
+  return this->size_;
 }
 
 /**
@@ -419,17 +337,45 @@ id %1% not found in table Resource")
  */
 void Resource::size(Energy size)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Resource\n\
 SET size = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, size);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->size_ = size;
+}
+
+
+/**
+ * Read the columns of the resource.
+ * @exception DBException if there is an error with the query.
+ */
+void Resource::load_() const
+{
+  sqlite3_stmt* stmt = this->db_->prepare("\
+SELECT frequency, max, start_x, start_y, end_x, end_y, size\n\
+FROM Resource\n\
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, this->id_);
+  if (sqlite3_step(stmt) != SQLITE_ROW)
+    throw EXCEPTION(DBException, boost::str(boost::format("\
+id %1% not found in table Resource")
+                                            % this->id_));
+  this->frequency_ = sqlite3_column_int(stmt, 0);
+  this->max_ = sqlite3_column_int64(stmt, 1);
+  this->start_x_ = sqlite3_column_int64(stmt, 2);
+  this->start_y_ = sqlite3_column_int64(stmt, 3);
+  this->end_x_ = sqlite3_column_int64(stmt, 4);
+  this->end_y_ = sqlite3_column_int64(stmt, 5);
+  this->size_ = sqlite3_column_int(stmt, 6);
+  sqlite3_reset(stmt);
+
+  this->loaded_ = true;
 }
 
 }
@@ -34,11 +34,12 @@ namespace db
  * Constructor.
  * It's not checked if the id is in the table, only when accessing the data
  * the id is checked.
+ * The row is read only once, when the first column is accessed.
  * @param db database.
  * @param id id of the spawn.
  */
 Spawn::Spawn(DB* db, ID id)
-  : Table("Spawn", db, id)
+  : Table("Spawn", db, id), loaded_(false)
 {
 }
 
@@ -57,27 +58,25 @@ Spawn::Spawn(DB* db, ID id)
  * @return the id of the new row (the same as bug_id).
  * @exception DBException if there is an error with the insertion.
  */
-ID Spawn::insert(DB* db, ID code_id, Time frequency, Uint16 max,
+ID Spawn::insert(DB* db, ID code_id, Time frequency, Uint32 max,
                  Coord start_x, Coord start_y, Coord end_x, Coord end_y,
 		 Energy energy)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Spawn(code_id, frequency, max, start_x, start_y, end_x, end_y,\n\
                   energy)\n\
-VALUES(?, ?, ?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?, ?, ?, ?, ?, ?);");
   sqlite3_bind_int64(stmt, 1, code_id);
   sqlite3_bind_int(stmt, 2, frequency);
-  sqlite3_bind_int(stmt, 3, max);
-  sqlite3_bind_int(stmt, 4, start_x);
-  sqlite3_bind_int(stmt, 5, start_y);
-  sqlite3_bind_int(stmt, 6, end_x);
-  sqlite3_bind_int(stmt, 7, end_y);
+  sqlite3_bind_int64(stmt, 3, max);
+  sqlite3_bind_int64(stmt, 4, start_x);
+  sqlite3_bind_int64(stmt, 5, start_y);
+  sqlite3_bind_int64(stmt, 6, end_x);
+  sqlite3_bind_int64(stmt, 7, end_y);
   sqlite3_bind_int(stmt, 8, energy);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -90,15 +89,13 @@ VALUES(?, ?, ?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
  */
 void Spawn::remove(DB* db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM Spawn\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -109,17 +106,15 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void Spawn::id(ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Spawn\n\
 SET id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = id;
 }
@@ -132,21 +127,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 ID Spawn::code_id() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT code_id\n\
-FROM Spawn\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table AliveBug")
-    % this->id_));
-  ID code_id = sqlite3_column_int64(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return code_id;
+  return this->code_id_;
 }
 
 /**
@@ -156,17 +140,17 @@ id %1% not found in table AliveBug")
  */
 void Spawn::code_id(ID code_id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Spawn\n\
 SET code_id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, code_id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->code_id_ = code_id;
 }
 
 
@@ -177,21 +161,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Time Spawn::frequency() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT frequency\n\
-FROM Spawn\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Spawn")
-                                            % this->id_));
-  Time frequency = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return frequency;
+  return this->frequency_;
 }
 
 /**
@@ -201,17 +174,17 @@ id %1% not found in table Spawn")
  */
 void Spawn::frequency(Time frequency)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Spawn\n\
 SET frequency = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, frequency);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->frequency_ = frequency;
 }
 
 
@@ -220,23 +193,12 @@ WHERE id = ?;", -1, &stmt, NULL))
  * @return the maximum.
  * @exception DBException if there is an error with the query.
  */
-Uint16 Spawn::max() const
+Uint32 Spawn::max() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT max\n\
-FROM Spawn\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Spawn")
-                                            % this->id_));
-  Uint16 max = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return max;
+  return this->max_;
 }
 
 /**
@@ -244,19 +206,19 @@ id %1% not found in table Spawn")
  * @param max the new maximum.
  * @exception DBException if there is an error with the update.
  */
-void Spawn::max(Uint16 max)
+void Spawn::max(Uint32 max)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Spawn\n\
 SET max = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, max);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, max);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->max_ = max;
 }
 
 /**
@@ -266,21 +228,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Coord Spawn::start_x() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT start_x\n\
-FROM Spawn\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Spawn")
-                                            % this->id_));
-  Coord start_x = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return start_x;
+  return this->start_x_;
 }
 
 /**
@@ -290,17 +241,17 @@ id %1% not found in table Spawn")
  */
 void Spawn::start_x(Coord start_x)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Spawn\n\
 SET start_x = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, start_x);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, start_x);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->start_x_ = start_x;
 }
 
 /**
@@ -310,21 +261,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Coord Spawn::start_y() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT start_y\n\
-FROM Spawn\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Spawn")
-                                            % this->id_));
-  Coord start_y = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return start_y;
+  return this->start_y_;
 }
 
 /**
@@ -334,17 +274,17 @@ id %1% not found in table Spawn")
  */
 void Spawn::start_y(Coord start_y)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Spawn\n\
 SET start_y = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, start_y);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, start_y);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->start_y_ = start_y;
 }
 
 /**
@@ -354,21 +294,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Coord Spawn::end_x() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT end_x\n\
-FROM Spawn\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Spawn")
-                                            % this->id_));
-  Coord end_x = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return end_x;
+  return this->end_x_;
 }
 
 /**
@@ -378,17 +307,17 @@ id %1% not found in table Spawn")
  */
 void Spawn::end_x(Coord end_x)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Spawn\n\
 SET end_x = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, end_x);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, end_x);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->end_x_ = end_x;
 }
 
 /**
@@ -398,21 +327,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Coord Spawn::end_y() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT end_y\n\
-FROM Spawn\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Spawn")
-                                            % this->id_));
-  Coord end_y = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return end_y;
+  return this->end_y_;
 }
 
 /**
@@ -422,17 +340,17 @@ id %1% not found in table Spawn")
  */
 void Spawn::end_y(Coord end_y)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Spawn\n\
 SET end_y = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, end_y);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, end_y);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->end_y_ = end_y;
 }
 
 
@@ -443,21 +361,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Energy Spawn::energy() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
-SELECT energy\n\
-FROM Spawn\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int64(stmt, 1, this->id_);
-  if (sqlite3_step(stmt) != SQLITE_ROW)
-    throw EXCEPTION(DBException, boost::str(boost::format("\
-id %1% not found in table Spawn")
-                                            % this->id_));
-  Energy energy = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  if (not this->loaded_)
+    this->load_();
 
-  return energy;
+  return this->energy_;
 }
 
 /**
@@ -467,17 +374,46 @@ id %1% not found in table Spawn")
  */
 void Spawn::energy(Energy energy)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Spawn\n\
 SET energy = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
+
+  this->energy_ = energy;
+}
+
+
+/**
+ * Read the columns of the spawn.
+ * @exception DBException if there is an error with the query.
+ */
+void Spawn::load_() const
+{
+  sqlite3_stmt* stmt = this->db_->prepare("\
+SELECT code_id, frequency, max, start_x, start_y, end_x, end_y, energy\n\
+FROM Spawn\n\
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, this->id_);
+  if (sqlite3_step(stmt) != SQLITE_ROW)
+    throw EXCEPTION(DBException, boost::str(boost::format("\
+id %1% not found in table Spawn")
+                                            % this->id_));
+  this->code_id_ = sqlite3_column_int64(stmt, 0);
+  this->frequency_ = sqlite3_column_int(stmt, 1);
+  this->max_ = sqlite3_column_int64(stmt, 2);
+  this->start_x_ = sqlite3_column_int64(stmt, 3);
+  this->start_y_ = sqlite3_column_int64(stmt, 4);
+  this->end_x_ = sqlite3_column_int64(stmt, 5);
+  this->end_y_ = sqlite3_column_int64(stmt, 6);
+  this->energy_ = sqlite3_column_int(stmt, 7);
+  sqlite3_reset(stmt);
+
+  this->loaded_ = true;
 }
 
 }
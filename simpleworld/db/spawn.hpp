@@ -41,6 +41,7 @@ public:
    * Constructor.
    * It's not checked if the id is in the table, only when accessing the data
    * the id is checked.
+   * The row is read only once, when the first column is accessed.
    * @param db database.
    * @param id id of the spawn.
    */
@@ -60,7 +61,7 @@ public:
    * @param energy energy of new bugs.
    * @exception DBException if there is an error with the insertion.
    */
-  static ID insert(DB* db, ID code_id, Time frequency, Uint16 max,
+  static ID insert(DB* db, ID code_id, Time frequency, Uint32 max,
                    Coord start_x, Coord start_y, Coord end_x, Coord end_y,
                    Energy energy);
 
@@ -123,14 +124,14 @@ public:
    * @return the maximum.
    * @exception DBException if there is an error with the query.
    */
-  Uint16 max() const;
+  Uint32 max() const;
 
   /**
    * Set the maximum number of elements in the region.
    * @param max the new maximum.
    * @exception DBException if there is an error with the update.
    */
-  void max(Uint16 max);
+  void max(Uint32 max);
 
   /**
    * Get the x coord of the start of the region.
@@ -202,6 +203,23 @@ public:
    * @exception DBException if there is an error with the update.
    */
   void energy(Energy energy);
+
+private:
+  /**
+   * Read the columns of the spawn.
+   * @exception DBException if there is an error with the query.
+   */
+  void load_() const;
+
+  mutable bool loaded_;         /**< If the columns were read */
+  mutable ID code_id_;          /**< Id of the code of new bugs */
+  mutable Time frequency_;      /**< Frequency of the spawns */
+  mutable Uint32 max_;          /**< Maximum number of elements in the region */
+  mutable Coord start_x_;       /**< X coord of the start of the region */
+  mutable Coord start_y_;       /**< Y coord of the start of the region */
+  mutable Coord end_x_;         /**< X coord of the end of the region */
+  mutable Coord end_y_;         /**< Y coord of the end of the region */
+  mutable Energy energy_;       /**< Energy of new bugs */
 };
 
 }
@@ -70,13 +70,11 @@ ID Stats::insert(DB* db, Time time, Uint32 families, Uint32 alive, Uint32 eggs,
                  Uint32 last_births, Uint32 last_sons, Uint32 last_deaths,
                  Uint32 last_kills, Uint32 last_mutations)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO Stats(time, families, alive, eggs, food, energy, mutations, age,\n\
                   last_births, last_sons, last_deaths, last_kills,\n\
                   last_mutations)\n\
-VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);");
   sqlite3_bind_int(stmt, 1, time);
   sqlite3_bind_int(stmt, 2, families);
   sqlite3_bind_int(stmt, 3, alive);
@@ -92,7 +90,7 @@ VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
   sqlite3_bind_int(stmt, 13, last_mutations);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -105,16 +103,13 @@ VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);", -1, &stmt, NULL))
  */
 ID Stats::insert(DB* db)
 {
-  sqlite3_stmt* stmt;
-
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 SELECT max(time)\n\
-FROM Environment;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+FROM Environment;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Time time = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   std::vector<ID> alive_bugs = db->alive_bugs();
   std::set<ID> ancestors;
@@ -129,41 +124,37 @@ FROM Environment;", -1, &stmt, NULL))
   }
   Uint32 families = ancestors.size();
 
-  if (sqlite3_prepare_v2(db->db(), "\
+  stmt = db->prepare("\
 SELECT count(*)\n\
-FROM AliveBug;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+FROM AliveBug;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Uint32 alive = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
-  if (sqlite3_prepare_v2(db->db(), "\
+  stmt = db->prepare("\
 SELECT count(*)\n\
-FROM Egg;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+FROM Egg;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Uint32 eggs = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
-  if (sqlite3_prepare_v2(db->db(), "\
+  stmt = db->prepare("\
 SELECT count(*)\n\
-FROM Food;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+FROM Food;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Uint32 food = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
-  if (sqlite3_prepare_v2(db->db(), "\
+  stmt = db->prepare("\
 SELECT total(energy)\n\
-FROM AliveBug;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+FROM AliveBug;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Uint32 energy = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   Uint32 mutations = 0;
   for (std::vector<ID>::const_iterator alive_bug = alive_bugs.begin();
@@ -171,51 +162,47 @@ FROM AliveBug;", -1, &stmt, NULL))
        ++alive_bug)
     mutations += Bug(db, *alive_bug).all_mutations().size();
 
-  if (sqlite3_prepare_v2(db->db(), "\
+  stmt = db->prepare("\
 SELECT total((SELECT max(time)\n\
               FROM Environment) - birth)\n\
-FROM AliveBug;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+FROM AliveBug;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Uint32 age = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
-  if (sqlite3_prepare_v2(db->db(), "\
+  stmt = db->prepare("\
 SELECT count(*) - (SELECT total(last_deaths)\n\
                    FROM Stats)\n\
-FROM DeadBug;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+FROM DeadBug;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Uint32 last_deaths = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
-  if (sqlite3_prepare_v2(db->db(), "\
+  stmt = db->prepare("\
 SELECT count(*) - (SELECT total(last_kills)\n\
                    FROM Stats)\n\
 FROM DeadBug\n\
-WHERE killer_id IS NOT NULL;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE killer_id IS NOT NULL;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Uint32 last_kills = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
-  if (sqlite3_prepare_v2(db->db(), "\
+  stmt = db->prepare("\
 SELECT count(*) +\n\
        (SELECT count(*)\n\
         FROM DeadBug) -\n\
        (SELECT total(last_births)\n\
         FROM Stats)\n\
-FROM AliveBug;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+FROM AliveBug;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Uint32 last_births = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
-  if (sqlite3_prepare_v2(db->db(), "\
+  stmt = db->prepare("\
 SELECT count(*) +\n\
        (SELECT count(*)\n\
         FROM DeadBug\n\
@@ -227,22 +214,20 @@ SELECT count(*) +\n\
 FROM AliveBug\n\
 WHERE bug_id IN (SELECT id\n\
                  FROM Bug\n\
-                 WHERE father_id IS NOT NULL);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+                 WHERE father_id IS NOT NULL);");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Uint32 last_sons = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
-  if (sqlite3_prepare_v2(db->db(), "\
+  stmt = db->prepare("\
 SELECT count(*) - (SELECT total(last_mutations)\n\
                    FROM Stats)\n\
-FROM Mutation;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+FROM Mutation;");
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
   Uint32 last_mutations = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return Stats::insert(db, time, families, alive, eggs, food, energy, mutations,
                        age, last_births, last_sons, last_deaths, last_kills,
@@ -257,15 +242,13 @@ FROM Mutation;", -1, &stmt, NULL))
  */
 void Stats::remove(DB* db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -276,17 +259,15 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void Stats::id(ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = id;
 }
@@ -299,19 +280,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Time Stats::time() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT time\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Time time = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return time;
 }
@@ -323,17 +302,15 @@ id %1% not found in table Stats")
  */
 void Stats::time(Time time)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET time = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, time);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -344,19 +321,17 @@ WHERE id = ?;", -1, &stmt, NULL))
 */
 Uint32 Stats::families() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT families\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 families = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return families;
 }
@@ -368,17 +343,15 @@ id %1% not found in table Stats")
 */
 void Stats::families(Uint32 families)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET families = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, families);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -388,19 +361,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::alive() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT alive\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 alive = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return alive;
 }
@@ -412,17 +383,15 @@ id %1% not found in table Stats")
  */
 void Stats::alive(Uint32 alive)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET alive = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, alive);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -432,19 +401,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::eggs() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT eggs\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 eggs = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return eggs;
 }
@@ -456,17 +423,15 @@ id %1% not found in table Stats")
  */
 void Stats::eggs(Uint32 eggs)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET eggs = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, eggs);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -476,19 +441,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::food() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT food\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 food = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return food;
 }
@@ -500,17 +463,15 @@ id %1% not found in table Stats")
  */
 void Stats::food(Uint32 food)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET food = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, food);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -520,19 +481,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::energy() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT energy\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 energy = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return energy;
 }
@@ -544,17 +503,15 @@ id %1% not found in table Stats")
  */
 void Stats::energy(Uint32 energy)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET energy = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, energy);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -564,19 +521,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::mutations() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT mutations\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 mutations = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return mutations;
 }
@@ -588,17 +543,15 @@ id %1% not found in table Stats")
  */
 void Stats::mutations(Uint32 mutations)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET mutations = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, mutations);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -608,19 +561,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::age() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT age\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 age = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return age;
 }
@@ -632,17 +583,15 @@ id %1% not found in table Stats")
  */
 void Stats::age(Uint32 age)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET age = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, age);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -652,19 +601,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::last_births() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT last_births\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 last_births = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return last_births;
 }
@@ -676,17 +623,15 @@ id %1% not found in table Stats")
  */
 void Stats::last_births(Uint32 last_births)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET last_births = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, last_births);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -696,19 +641,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::last_sons() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT last_sons\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 last_sons = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return last_sons;
 }
@@ -720,17 +663,15 @@ id %1% not found in table Stats")
  */
 void Stats::last_sons(Uint32 last_sons)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET last_sons = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, last_sons);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -740,19 +681,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::last_deaths() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT last_deaths\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 last_deaths = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return last_deaths;
 }
@@ -764,17 +703,15 @@ id %1% not found in table Stats")
  */
 void Stats::last_deaths(Uint32 last_deaths)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET last_deaths = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, last_deaths);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -784,19 +721,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::last_kills() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT last_kills\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 last_kills = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return last_kills;
 }
@@ -808,17 +743,15 @@ id %1% not found in table Stats")
  */
 void Stats::last_kills(Uint32 last_kills)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET last_kills = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, last_kills);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -828,19 +761,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Uint32 Stats::last_mutations() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT last_mutations\n\
 FROM Stats\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table Stats")
                                             % this->id_));
   Uint32 last_mutations = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return last_mutations;
 }
@@ -852,17 +783,15 @@ id %1% not found in table Stats")
  */
 void Stats::last_mutations(Uint32 last_mutations)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE Stats\n\
 SET last_mutations = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, last_mutations);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 }
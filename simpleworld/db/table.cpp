@@ -57,10 +57,7 @@ FROM %2%\n\
 WHERE _ROWID_ = ?;")
                                % colname
                                % this->name_));
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), query.c_str(), query.size(), &stmt,
-                         NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+  sqlite3_stmt* stmt = this->db_->prepare(query);
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
@@ -68,7 +65,7 @@ id %1% not found in table %2%")
                                             % this->id_
                                             % colname));
   bool is_null = sqlite3_column_type(stmt, 0) == SQLITE_NULL;
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return is_null;
 }
@@ -87,10 +84,7 @@ SET %2% = ?\n\
 WHERE _ROWID_ = ?;")
                                % this->name_
                                % colname));
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), query.c_str(), query.size(), &stmt,
-                         NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+  sqlite3_stmt* stmt = this->db_->prepare(query);
   sqlite3_bind_null(stmt, 1);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
@@ -98,7 +92,7 @@ WHERE _ROWID_ = ?;")
 id %1% not found in table %2%")
                                             % this->id_
                                             % colname));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 }
@@ -57,17 +57,15 @@ World::World(DB* db, ID id)
 ID World::insert(DB* db, Coord position_x, Coord position_y,
                  Orientation orientation)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO World(position_x, position_y, orientation)\n\
-VALUES(?, ?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_bind_int(stmt, 1, position_x);
-  sqlite3_bind_int(stmt, 2, position_y);
+VALUES(?, ?, ?);");
+  sqlite3_bind_int64(stmt, 1, position_x);
+  sqlite3_bind_int64(stmt, 2, position_y);
   sqlite3_bind_int(stmt, 3, orientation);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -82,16 +80,14 @@ VALUES(?, ?, ?);", -1, &stmt, NULL))
  */
 ID World::insert(DB* db, Coord position_x, Coord position_y)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 INSERT INTO World(position_x, position_y)\n\
-VALUES(?, ?);", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_bind_int(stmt, 1, position_x);
-  sqlite3_bind_int(stmt, 2, position_y);
+VALUES(?, ?);");
+  sqlite3_bind_int64(stmt, 1, position_x);
+  sqlite3_bind_int64(stmt, 2, position_y);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return sqlite3_last_insert_rowid(db->db());
 }
@@ -104,15 +100,13 @@ VALUES(?, ?);", -1, &stmt, NULL))
  */
 void World::remove(DB* db, ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(db->db(), "\
+  sqlite3_stmt* stmt = db->prepare("\
 DELETE FROM World\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(db->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -123,17 +117,15 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void World::id(ID id)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE World\n\
 SET id = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, id);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   this->id_ = id;
 }
@@ -145,19 +137,17 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Coord World::position_x() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT position_x\n\
 FROM World\n\
-WHERE id = ?", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table World")
                                             % this->id_));
-  Coord position_x = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  Coord position_x = sqlite3_column_int64(stmt, 0);
+  sqlite3_reset(stmt);
 
   return position_x;
 }
@@ -169,19 +159,17 @@ id %1% not found in table World")
  */
 Coord World::position_y() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT position_y\n\
 FROM World\n\
-WHERE id = ?", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
 id %1% not found in table World")
                                             % this->id_));
-  Coord position_y = sqlite3_column_int(stmt, 0);
-  sqlite3_finalize(stmt);
+  Coord position_y = sqlite3_column_int64(stmt, 0);
+  sqlite3_reset(stmt);
 
   return position_y;
 }
@@ -193,17 +181,15 @@ id %1% not found in table World")
  */
 void World::position_x(Coord position_x)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE World\n\
 SET position_x = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, position_x);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, position_x);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -213,17 +199,15 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 void World::position_y(Coord position_y)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE World\n\
 SET position_y = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_bind_int(stmt, 1, position_y);
+WHERE id = ?;");
+  sqlite3_bind_int64(stmt, 1, position_y);
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 
@@ -234,12 +218,10 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 Orientation World::orientation() const
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 SELECT orientation\n\
 FROM World\n\
-WHERE id = ?", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?");
   sqlite3_bind_int64(stmt, 1, this->id_);
   if (sqlite3_step(stmt) != SQLITE_ROW)
     throw EXCEPTION(DBException, boost::str(boost::format("\
@@ -247,7 +229,7 @@ id %1% not found in table World")
                                             % this->id_));
   Orientation orientation =
     static_cast<Orientation>(sqlite3_column_int(stmt, 0));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   return orientation;
 }
@@ -259,17 +241,15 @@ id %1% not found in table World")
  */
 void World::orientation(Orientation orientation)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(this->db_->db(), "\
+  sqlite3_stmt* stmt = this->db_->prepare("\
 UPDATE World\n\
 SET orientation = ?\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
+WHERE id = ?;");
   sqlite3_bind_int(stmt, 1, static_cast<int>(orientation));
   sqlite3_bind_int64(stmt, 2, this->id_);
   if (sqlite3_step(stmt) != SQLITE_DONE)
     throw EXCEPTION(DBException, sqlite3_errmsg(this->db_->db()));
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 }
@@ -18,12 +18,11 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <iostream>
-#include <cstring>
+#include <algorithm>
+
+#include <boost/scoped_array.hpp>
 
 #include <simpleworld/ints.hpp>
-#include <simpleworld/cpu/word.hpp>
-#include <simpleworld/db/exception.hpp>
 #include "dbmemory.hpp"
 
 namespace simpleworld
@@ -42,13 +41,49 @@ DBMemory::DBMemory(const db::Blob& blob)
 
 /**
 * Update the data from the database.
+* The changes not written to the database are lost.
 */
 void DBMemory::update()
 {
   Uint32 size;
   boost::shared_array<Uint8> data = this->blob_.read(&size);
-  Memory::resize(size);
-  std::memcpy(this->memory_, data.get(), size);
+  Memory::copy(cpu::Memory(data.get(), size));
+  this->clean_();
+}
+
+/**
+ * Write the pages changed to the database.
+ * @exception DBException if there is an error with the update.
+ */
+void DBMemory::flush()
+{
+  // the pages don't match the blob, so all the memory is written
+  if (this->size_ != this->saved_.size()) {
+    this->write_blob_(0, this->size_);
+    this->clean_();
+    return;
+  }
+
+  // write each group of consecutive pages changed at once
+  cpu::Address pages = this->pages_.size();
+  cpu::Address page = 0;
+  while (page < pages) {
+    if (this->shares_page(this->saved_, page)) {
+      page++;
+      continue;
+    }
+
+    cpu::Address start = page * MEMORY_PAGE_SIZE;
+    while (page < pages and not this->shares_page(this->saved_, page))
+      page++;
+    cpu::Address end = std::min(static_cast<cpu::Address>(page *
+                                                          MEMORY_PAGE_SIZE),
+                                this->size_);
+
+    this->write_blob_(start, end - start);
+  }
+
+  this->clean_();
 }
 
 
@@ -60,77 +95,50 @@ void DBMemory::update()
 void DBMemory::resize(cpu::Address size)
 {
   Memory::resize(size);
-  this->blob_.write(this->memory_, size);
+  this->write_blob_(0, size);
+  this->clean_();
 }
 
 
 /**
- * Set the value of a word.
- * In big endian systems the system_endian parameter does nothing.
- * In little endian systems the word is supposed to be in little endian if
- * system_endian is true and in big endian if system_endian is false.
- * @param address address of the word
- * @param value value of the word
- * @param system_endian if the word is in the systen endianness
- * @exception MemoryError if address > (size - 4)
+ * Copy the content of other Memory class.
+ * @param memory memory to copy.
+ * @return a reference to this object.
  */
-void DBMemory::set_word(cpu::Address address, cpu::Word value,
-                        bool system_endian)
+DBMemory& DBMemory::assign(const cpu::Memory& memory)
 {
-  Memory::set_word(address, value, system_endian);
-  if (system_endian)
-    value = cpu::change_byte_order(value);
-  try {
-    this->blob_.write(&value, sizeof(cpu::Word), address);
-  } catch (const db::DBException& e) {
-    std::cerr << "size = " << this->size() << std::endl;
-    throw;
-  }
-}
+  Memory::assign(memory);
+  this->write_blob_(0, memory.size());
+  this->clean_();
 
-/**
- * Set the value of a half word.
- * In big endian systems the system_endian parameter does nothing.
- * In little endian systems the word is supposed to be in little endian if
- * system_endian is true and in big endian if system_endian is false.
- * @param address address of the half word
- * @param value value of the half word
- * @param system_endian if the half word is in the systen endianness
- * @exception MemoryError if address > (size - 2)
- */
-void DBMemory::set_halfword(cpu::Address address, cpu::HalfWord value,
-                            bool system_endian)
-{
-  Memory::set_halfword(address, value, system_endian);
-  if (system_endian)
-    value = cpu::change_byte_order(value);
-  this->blob_.write(&value, sizeof(cpu::HalfWord), address);
+  return *this;
 }
 
+
 /**
- * Set the value of a quarter word.
- * @param address address of the quarter word
- * @param value value of the quarter word
- * @exception MemoryError if address > (size - 1)
+ * Write a region of memory to the database.
+ * @param address address of the region.
+ * @param size size of the region.
  */
-void DBMemory::set_quarterword(cpu::Address address, cpu::QuarterWord value)
+void DBMemory::write_blob_(cpu::Address address, cpu::Address size)
 {
-  Memory::set_quarterword(address, value);
-  this->blob_.write(&value, sizeof(cpu::QuarterWord), address);
+  boost::scoped_array<Uint8> data(new Uint8[size]);
+  this->read_(address, data.get(), size);
+
+  // the whole blob is replaced when the size changes
+  if (address == 0 and size == this->size_)
+    this->blob_.write(data.get(), size);
+  else
+    this->blob_.write(data.get(), size, address);
 }
 
-
 /**
- * Copy the content of other Memory class.
- * @param memory memory to copy.
- * @return a reference to this object.
+ * Mark all the pages as not changed.
  */
-DBMemory& DBMemory::assign(const cpu::Memory& memory)
+void DBMemory::clean_()
 {
-  Memory::assign(memory);
-  this->blob_.write(this->memory_, memory.size());
-
-  return *this;
+  // the pages written from now are not shared with the copy
+  this->saved_.copy(*this);
 }
 
 }
@@ -30,6 +30,11 @@ namespace simpleworld
 
 /**
  * Memory subclass that get the data from the database.
+ * The changes are made in memory and they are only written to the
+ * database when flush() is called, usually before the transaction is
+ * commited.
+ * The pages changed are the ones not shared with a copy of the memory
+ * made when it was written.
  */
 class DBMemory: public cpu::Memory
 {
@@ -43,9 +48,16 @@ public:
 
   /**
   * Update the data from the database.
+  * The changes not written to the database are lost.
   */
   void update();
 
+  /**
+   * Write the pages changed to the database.
+   * @exception DBException if there is an error with the update.
+   */
+  void flush();
+
 
   /**
    * Set the size of the memory.
@@ -55,41 +67,6 @@ public:
   void resize(cpu::Address size);
 
 
-  /**
-   * Set the value of a word.
-   * In big endian systems the system_endian parameter does nothing.
-   * In little endian systems the word is supposed to be in little endian if
-   * system_endian is true and in big endian if system_endian is false.
-   * @param address address of the word
-   * @param value value of the word
-   * @param system_endian if the word is in the systen endianness
-   * @exception MemoryError if address > (size - 4)
-   */
-  void set_word(cpu::Address address, cpu::Word value,
-                bool system_endian = true);
-
-  /**
-   * Set the value of a half word.
-   * In big endian systems the system_endian parameter does nothing.
-   * In little endian systems the word is supposed to be in little endian if
-   * system_endian is true and in big endian if system_endian is false.
-   * @param address address of the half word
-   * @param value value of the half word
-   * @param system_endian if the half word is in the systen endianness
-   * @exception MemoryError if address > (size - 2)
-   */
-  void set_halfword(cpu::Address address, cpu::HalfWord value,
-                    bool system_endian = true);
-
-  /**
-   * Set the value of a quarter word.
-   * @param address address of the quarter word
-   * @param value value of the quarter word
-   * @exception MemoryError if address > (size - 1)
-   */
-  void set_quarterword(cpu::Address address, cpu::QuarterWord value);
-
-
   /**
    * Copy the content of other Memory class.
    * @param memory memory to copy.
@@ -99,6 +76,19 @@ public:
 
 private:
   db::Blob blob_;
+  cpu::Memory saved_;           /**< Memory in the database */
+
+  /**
+   * Write a region of memory to the database.
+   * @param address address of the region.
+   * @param size size of the region.
+   */
+  void write_blob_(cpu::Address address, cpu::Address size);
+
+  /**
+   * Mark all the pages as not changed.
+   */
+  void clean_();
 };
 
 }
@@ -33,8 +33,79 @@ namespace simpleworld
  */
 Egg::Egg(SimpleWorld* sw, db::ID id)
   : Element(ElementEgg), db::Bug(sw, id), db::Egg(sw, id),
-    db::World(sw, this->world_id())
+    db::World(sw, this->world_id()), changed_(0)
 {
+  this->energy_ = db::Egg::energy();
+  this->position_x_ = db::World::position_x();
+  this->position_y_ = db::World::position_y();
+  this->orientation_null_ = db::World::is_null("orientation");
+  this->orientation_ = this->orientation_null_ ? OrientationNorth :
+    db::World::orientation();
+}
+
+
+/**
+ * Set the energy of the egg.
+ * The energy is written to the database when the egg is saved.
+ * @param energy the new energy.
+ */
+void Egg::energy(Energy energy)
+{
+  this->energy_ = energy;
+  this->changed_ |= ChangedEnergy;
+}
+
+
+/**
+ * Set the position in the x coord.
+ * @param position_x the new position.
+ * @exception DBException if there is an error with the update.
+ */
+void Egg::position_x(Coord position_x)
+{
+  db::World::position_x(position_x);
+  this->position_x_ = position_x;
+}
+
+/**
+ * Set the position in the y coord.
+ * @param position_y the new position.
+ * @exception DBException if there is an error with the update.
+ */
+void Egg::position_y(Coord position_y)
+{
+  db::World::position_y(position_y);
+  this->position_y_ = position_y;
+}
+
+/**
+ * Set the orientation.
+ * The orientation is written to the database when the egg is saved.
+ * @param orientation the new orientation.
+ */
+void Egg::orientation(Orientation orientation)
+{
+  this->orientation_ = orientation;
+  this->orientation_null_ = false;
+  this->changed_ |= ChangedOrientation;
+}
+
+
+/**
+ * Write the state of the egg that is only kept in memory.
+ * @exception DBException if there is a error in the database.
+ */
+void Egg::save()
+{
+  if (this->changed_ & ChangedEnergy)
+    db::Egg::energy(this->energy_);
+  if (this->changed_ & ChangedOrientation) {
+    if (this->orientation_null_)
+      db::World::set_null("orientation");
+    else
+      db::World::orientation(this->orientation_);
+  }
+  this->changed_ = 0;
 }
 
 
@@ -48,9 +119,9 @@ bool Egg::is_null(const std::string& colname) const
   if (colname == "father_id")
     return db::Bug::is_null(colname);
   else if (colname == "orientation")
-    return db::World::is_null(colname);
+    return this->orientation_null_;
   else
-    return false;
+    return db::Egg::is_null(colname);
 }
 
 /**
@@ -61,8 +132,12 @@ void Egg::set_null(const std::string& colname)
 {
   if (colname == "father_id")
     db::Bug::set_null(colname);
-  else if (colname == "orientation")
-    db::World::set_null(colname);
+  else if (colname == "orientation") {
+    this->orientation_ = OrientationNorth;
+    this->orientation_null_ = true;
+    this->changed_ |= ChangedOrientation;
+  } else
+    db::Egg::set_null(colname);
 }
 
 }
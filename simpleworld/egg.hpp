@@ -21,6 +21,7 @@
 #ifndef SIMPLEWORLD_EGG_HPP
 #define SIMPLEWORLD_EGG_HPP
 
+#include <simpleworld/types.hpp>
 #include <simpleworld/element.hpp>
 #include <simpleworld/db/bug.hpp>
 #include <simpleworld/db/egg.hpp>
@@ -57,6 +58,67 @@ public:
   void id(db::ID id) { db::Bug::id(id); }
 
 
+  /**
+   * Get the energy of the egg.
+   * @return the energy.
+   */
+  Energy energy() const { return this->energy_; }
+
+  /**
+   * Set the energy of the egg.
+   * The energy is written to the database when the egg is saved.
+   * @param energy the new energy.
+   */
+  void energy(Energy energy);
+
+
+  /**
+   * Get the position in the x coord.
+   * @return the position.
+   */
+  Coord position_x() const { return this->position_x_; }
+
+  /**
+   * Get the position in the y coord.
+   * @return the position.
+   */
+  Coord position_y() const { return this->position_y_; }
+
+  /**
+   * Set the position in the x coord.
+   * @param position_x the new position.
+   * @exception DBException if there is an error with the update.
+   */
+  void position_x(Coord position_x);
+
+  /**
+   * Set the position in the y coord.
+   * @param position_y the new position.
+   * @exception DBException if there is an error with the update.
+   */
+  void position_y(Coord position_y);
+
+  /**
+   * Get the orientation.
+   * @return the orientation.
+   */
+  Orientation orientation() const { return this->orientation_; }
+
+  /**
+   * Set the orientation.
+   * The orientation is written to the database when the egg is saved.
+   * @param orientation the new orientation.
+   */
+  void orientation(Orientation orientation);
+
+
+  /**
+   * Write the state of the egg that is only kept in memory.
+   * @exception DBException if there is a error in the database.
+   */
+  void save();
+
+
   /**
    * Check if colname is NULL.
    * @param colname name of the column.
@@ -69,6 +131,22 @@ public:
    * @param colname name of the column.
    */
   void set_null(const std::string& colname);
+
+private:
+  /**
+   * Columns that have been changed but not written to the database.
+   */
+  enum Changed {
+    ChangedEnergy = 1 << 0,
+    ChangedOrientation = 1 << 1
+  };
+
+  Energy energy_;               /**< Energy of the egg */
+  Coord position_x_;            /**< Position in the x coord */
+  Coord position_y_;            /**< Position in the y coord */
+  Orientation orientation_;     /**< Orientation of the egg */
+  bool orientation_null_;       /**< If orientation is NULL */
+  unsigned changed_;            /**< Changed columns */
 };
 
 }
@@ -22,6 +22,7 @@
 #define SIMPLEWORLD_ELEMENT_HPP
 
 #include <simpleworld/types.hpp>
+#include <simpleworld/slotmap.hpp>
 
 namespace simpleworld
 {
@@ -49,6 +50,11 @@ public:
    */
   ElementType type;
 
+  /**
+   * Handle of the element in the SimpleWorld.
+   */
+  SlotHandle slot;
+
 
   /**
    * Check if the element can be moved.
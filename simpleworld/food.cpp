@@ -32,8 +32,71 @@ namespace simpleworld
  * @exception DBException if there is a error in the database.
  */
 Food::Food(SimpleWorld* sw, db::ID id)
-  : Element(ElementFood), db::Food(sw, id), db::World(sw, this->world_id())
+  : Element(ElementFood), db::Food(sw, id), db::World(sw, this->world_id()),
+    size_changed_(false)
 {
+  this->time_ = db::Food::time();
+  this->size_ = db::Food::size();
+  this->position_x_ = db::World::position_x();
+  this->position_y_ = db::World::position_y();
+}
+
+
+/**
+ * Set the time when the food was added.
+ * @param time the new time.
+ * @exception DBException if there is an error with the update.
+ */
+void Food::time(Time time)
+{
+  db::Food::time(time);
+  this->time_ = time;
+}
+
+/**
+ * Set the size of the food.
+ * The size is written to the database when the food is saved.
+ * @param size the new size.
+ */
+void Food::size(Energy size)
+{
+  this->size_ = size;
+  this->size_changed_ = true;
+}
+
+
+/**
+ * Set the position in the x coord.
+ * @param position_x the new position.
+ * @exception DBException if there is an error with the update.
+ */
+void Food::position_x(Coord position_x)
+{
+  db::World::position_x(position_x);
+  this->position_x_ = position_x;
+}
+
+/**
+ * Set the position in the y coord.
+ * @param position_y the new position.
+ * @exception DBException if there is an error with the update.
+ */
+void Food::position_y(Coord position_y)
+{
+  db::World::position_y(position_y);
+  this->position_y_ = position_y;
+}
+
+
+/**
+ * Write the state of the food that is only kept in memory.
+ * @exception DBException if there is a error in the database.
+ */
+void Food::save()
+{
+  if (this->size_changed_)
+    db::Food::size(this->size_);
+  this->size_changed_ = false;
 }
 
 
@@ -47,7 +110,7 @@ bool Food::is_null(const std::string& colname) const
   if (colname == "orientation")
     return db::World::is_null(colname);
   else
-    return false;
+    return db::Food::is_null(colname);
 }
 
 /**
@@ -58,6 +121,8 @@ void Food::set_null(const std::string& colname)
 {
   if (colname == "orientation")
     db::World::set_null(colname);
+  else
+    db::Food::set_null(colname);
 }
 
 }
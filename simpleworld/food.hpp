@@ -21,6 +21,7 @@
 #ifndef SIMPLEWORLD_FOOD_HPP
 #define SIMPLEWORLD_FOOD_HPP
 
+#include <simpleworld/types.hpp>
 #include <simpleworld/element.hpp>
 #include <simpleworld/db/food.hpp>
 #include <simpleworld/db/world.hpp>
@@ -56,6 +57,67 @@ public:
   void id(db::ID id) { db::Food::id(id); }
 
 
+  /**
+   * Get the time when the food was added.
+   * @return the time.
+   */
+  Time time() const { return this->time_; }
+
+  /**
+   * Set the time when the food was added.
+   * @param time the new time.
+   * @exception DBException if there is an error with the update.
+   */
+  void time(Time time);
+
+  /**
+   * Get the size of the food.
+   * @return the size.
+   */
+  Energy size() const { return this->size_; }
+
+  /**
+   * Set the size of the food.
+   * The size is written to the database when the food is saved.
+   * @param size the new size.
+   */
+  void size(Energy size);
+
+
+  /**
+   * Get the position in the x coord.
+   * @return the position.
+   */
+  Coord position_x() const { return this->position_x_; }
+
+  /**
+   * Get the position in the y coord.
+   * @return the position.
+   */
+  Coord position_y() const { return this->position_y_; }
+
+  /**
+   * Set the position in the x coord.
+   * @param position_x the new position.
+   * @exception DBException if there is an error with the update.
+   */
+  void position_x(Coord position_x);
+
+  /**
+   * Set the position in the y coord.
+   * @param position_y the new position.
+   * @exception DBException if there is an error with the update.
+   */
+  void position_y(Coord position_y);
+
+
+  /**
+   * Write the state of the food that is only kept in memory.
+   * @exception DBException if there is a error in the database.
+   */
+  void save();
+
+
   /**
    * Check if colname is NULL.
    * @param colname name of the column.
@@ -68,6 +130,13 @@ public:
    * @param colname name of the column.
    */
   void set_null(const std::string& colname);
+
+private:
+  Time time_;                   /**< When the food was added */
+  Energy size_;                 /**< Size of the food */
+  Coord position_x_;            /**< Position in the x coord */
+  Coord position_y_;            /**< Position in the y coord */
+  bool size_changed_;           /**< If the size has been changed */
 };
 
 }
@@ -18,8 +18,8 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <cstdlib>
-#include <cstring>
+#include <vector>
+#include <cmath>
 
 #include <boost/shared_array.hpp>
 
@@ -41,22 +41,24 @@ namespace simpleworld
  * Get a random value in the range min <= n < max.
  * @param min the minimun value.
  * @param max the maximun value.
+ * @param random generator of the random numbers.
  * @return the random value.
  */
-static int randint(int min, int max)
+static int randint(int min, int max, Random* random)
 {
-  return min + (((float) max - min) * (std::rand() / (RAND_MAX + 1.0)));
+  return random->integer(min, max);
 }
 
 /**
  * Create a random word.
+ * @param random generator of the random numbers.
  * @return the random word.
  */
-static cpu::Word random_word()
+static cpu::Word random_word(Random* random)
 {
   cpu::Word word;
   for (unsigned int i = 0; i < sizeof(cpu::Word); i++)
-    cpu::set_byte(&word, i, randint(0, 256));
+    cpu::set_byte(&word, i, randint(0, 256, random));
 
   return word;
 }
@@ -64,14 +66,16 @@ static cpu::Word random_word()
 /**
 * Partially mutate the word.
 * @param word the original word.
+* @param random generator of the random numbers.
 * @return the mutated word.
 */
-static cpu::Word partial_mutation(cpu::Word word)
+static cpu::Word partial_mutation(cpu::Word word, Random* random)
 {
   cpu::Word newword = word;
-  unsigned int max = randint(1, 4);
+  unsigned int max = randint(1, 4, random);
   for (unsigned int i = 0; i < max; i++)
-    cpu::set_byte(&newword, randint(0, 4), randint(0, 256));
+    cpu::set_byte(&newword, randint(0, 4, random),
+                  randint(0, 256, random));
 
   return newword;
 }
@@ -79,88 +83,144 @@ static cpu::Word partial_mutation(cpu::Word word)
 /**
  * Permutate the word.
  * @param word the original word.
+ * @param random generator of the random numbers.
  * @return the permutated word.
  */
-static cpu::Word permutation(cpu::Word word)
+static cpu::Word permutation(cpu::Word word, Random* random)
 {
   cpu::Word newword;
   for (unsigned int i = 0; i < sizeof(cpu::Word); i++)
-    cpu::set_byte(&newword, i, cpu::get_byte(word, randint(0, 4)));
+    cpu::set_byte(&newword, i, cpu::get_byte(word,
+                                                 randint(0, 4, random)));
 
   return newword;
 }
 
 /**
- * Generate mutations.
+ * Number of types of mutations.
+ */
+static const unsigned int mutation_types = 6;
+
+/**
+ * Types of mutations that can be drawn from one random number
+ * (6 ** 12 < 2 ** 32).
+ */
+static const unsigned int types_per_draw = 12;
+
+/**
+ * 6 ** 12.
+ */
+static const Uint32 types_range = 2176782336U;
+
+/**
+ * Get the number of words to skip until the next mutation.
+ * The number of words follows a geometric distribution, the same that the
+ * number of failures before a success in independent trials.
+ * @param log_q logarithm of the probability of a word not to be mutated.
+ * @param random generator of the random numbers.
+ * @return the number of words.
+ */
+static double skip(double log_q, Random* random)
+{
+  // 1 - real() is in (0, 1], so the logarithm is always defined
+  return std::floor(std::log(1.0 - random->real()) / log_q);
+}
+
+/**
+ * Plan the mutations of a code.
+ * Each word is mutated with the same probability, but instead of a trial
+ * for each word the distance to the next mutation is drawn, so the cost
+ * depends on the number of mutations and not on the size of the code.
  * @param list pointer to a list of mutations.
  * @param size pointer to the size of the code.
  * @param probability probability to happen a mutation.
+ * @param random generator of the random numbers.
  * @return if the code is mutated.
  */
-static bool generate(MutationsList* list, cpu::Address* size, float probability)
+bool plan_mutations(MutationsList* list, cpu::Address* size,
+                    float probability, Random* random)
 {
   // if the probability is 0, there is nothing to do
-  if (probability == 0.0)
+  if (probability <= 0.0)
     return false;
 
+  // probability of each word to be mutated
   const int max = 1 / probability;
+  const double log_q = max > 1 ? std::log(1.0 - 1.0 / max) : 0.0;
+
+  Uint32 types = 0;
+  unsigned int types_left = 0;
+
   cpu::Address i = 0;
   Mutation mutation;
   while (i < *size) {
-    if (randint(0, max) == 0) {
-      // mutation
-      switch (randint(0, 6)) {
-      case 0:                           // change the word by a random one
-        mutation.type = db::Mutation::Total;
-        mutation.address = i;
-        list->push_back(mutation);
-        i += sizeof(cpu::Word);
+    if (max > 1) {
+      cpu::Address words = (*size - i + sizeof(cpu::Word) - 1) /
+        sizeof(cpu::Word);
+      double skipped = skip(log_q, random);
+      if (skipped >= words)
         break;
+      i += static_cast<cpu::Address>(skipped) * sizeof(cpu::Word);
+    }
 
-      case 1:                           // mutate part of the word
-        mutation.type = db::Mutation::Partial;
-        mutation.address = i;
-        list->push_back(mutation);
-        i += sizeof(cpu::Word);
-        break;
+    // the types of several mutations are drawn at the same time
+    if (types_left == 0) {
+      types = random->integer(0, types_range);
+      types_left = types_per_draw;
+    }
+    unsigned int type = types % mutation_types;
+    types /= mutation_types;
+    types_left--;
+
+    switch (type) {
+    case 0:                             // change the word by a random one
+      mutation.type = db::Mutation::Total;
+      mutation.address = i;
+      list->push_back(mutation);
+      i += sizeof(cpu::Word);
+      break;
 
-      case 2:                           // permutate the word
-        mutation.type = db::Mutation::Permutation;
-        mutation.address = i;
-        list->push_back(mutation);
-        i += sizeof(cpu::Word);
-        break;
+    case 1:                             // mutate part of the word
+      mutation.type = db::Mutation::Partial;
+      mutation.address = i;
+      list->push_back(mutation);
+      i += sizeof(cpu::Word);
+      break;
 
-      case 3:                           // addition of a random word
-        mutation.type = db::Mutation::Addition;
-        mutation.address = i;
-        list->push_back(mutation);
-        i += sizeof(cpu::Word);
-        *size += sizeof(cpu::Word);
-        break;
+    case 2:                             // permutate the word
+      mutation.type = db::Mutation::Permutation;
+      mutation.address = i;
+      list->push_back(mutation);
+      i += sizeof(cpu::Word);
+      break;
 
-      case 4:                           // duplication of a word
-        // if it's the begining of the code do a addition instead
-        if (i == 0)
-          mutation.type = db::Mutation::Addition;
-        else
-          mutation.type = db::Mutation::Duplication;
-        mutation.address = i;
-        list->push_back(mutation);
-        i += sizeof(cpu::Word);
-        *size += sizeof(cpu::Word);
-        break;
+    case 3:                             // addition of a random word
+      mutation.type = db::Mutation::Addition;
+      mutation.address = i;
+      list->push_back(mutation);
+      i += sizeof(cpu::Word);
+      *size += sizeof(cpu::Word);
+      break;
 
-      case 5:                           // elimination of a word
-        mutation.type = db::Mutation::Deletion;
-        mutation.address = i;
-        list->push_back(mutation);
-        *size -= sizeof(cpu::Word);
-        break;
-      }
-    } else
-      // no mutation
+    case 4:                             // duplication of a word
+      // if it's the begining of the code do a addition instead
+      if (i == 0)
+        mutation.type = db::Mutation::Addition;
+      else
+        mutation.type = db::Mutation::Duplication;
+      mutation.address = i;
+      list->push_back(mutation);
       i += sizeof(cpu::Word);
+      *size += sizeof(cpu::Word);
+      break;
+
+    case 5:                             // elimination of a word
+      mutation.type = db::Mutation::Deletion;
+      mutation.address = i;
+      list->push_back(mutation);
+      *size -= sizeof(cpu::Word);
+      break;
+    }
   }
 
   return not list->empty();
@@ -168,26 +228,20 @@ static bool generate(MutationsList* list, cpu::Address* size, float probability)
 
 
 /**
- * Get a copy of the code but with occasional mutations.
- * @param list pointer to a list of mutations.
- * @param original the original code.
- * @param size the size of the code.
- * @return the code mutated.
+ * Apply a list of mutations to a code.
+ * The mutations are applied in order, so the address of each mutation is
+ * relative to the code already mutated by the previous ones. The mutations
+ * that don't change the code are removed from the list.
+ * @param list pointer to the list of mutations.
+ * @param memory the code.
+ * @param random generator of the random numbers.
  */
-static boost::shared_array<Uint8> mutate(MutationsList* list,
-                                         boost::shared_array<Uint8> original,
-                                         Uint32 size)
+void apply_mutations(MutationsList* list, cpu::Memory* memory,
+                     Random* random)
 {
-  boost::shared_array<Uint8> mutated(new Uint8[size]);
-  cpu::Address original_i = 0;
-  cpu::Address mutated_i = 0;
-  for (MutationsList::iterator iter = list->begin();
-       iter != list->end();
-       ++iter) {
-    cpu::Address chunk_size = (*iter).address - mutated_i;
-    if (chunk_size > 0)
-      std::memcpy(mutated.get() + mutated_i, original.get() + original_i,
-                  chunk_size);
+  MutationsList::iterator iter = list->begin();
+  while (iter != list->end()) {
+    bool changed = true;
 
     switch ((*iter).type) {
     case db::Mutation::Total:
@@ -197,16 +251,13 @@ static boost::shared_array<Uint8> mutate(MutationsList* list,
 #endif // DEBUG
 
       {
-        cpu::Word old_word = 
-          *reinterpret_cast<cpu::Word*>(original.get() + chunk_size);
-        cpu::Word new_word = random_word();
-        if (old_word != new_word) {
-          *reinterpret_cast<cpu::Word*>(mutated.get() + chunk_size) = new_word;
-          (*iter).old_value = old_word;
-          (*iter).new_value = new_word;
-          original_i += chunk_size + sizeof(cpu::Word);
-          mutated_i += chunk_size + sizeof(cpu::Word);
-        }
+        cpu::Word old_word = memory->get_word((*iter).address, false);
+        cpu::Word new_word = random_word(random);
+        changed = old_word != new_word;
+        if (changed)
+          memory->set_word((*iter).address, new_word, false);
+        (*iter).old_value = old_word;
+        (*iter).new_value = new_word;
       }
 
       break;
@@ -218,16 +269,13 @@ static boost::shared_array<Uint8> mutate(MutationsList* list,
 #endif // DEBUG
 
       {
-        cpu::Word old_word =
-          *reinterpret_cast<cpu::Word*>(original.get() + chunk_size);
-        cpu::Word new_word = partial_mutation(old_word);
-        if (old_word != new_word) {
-          *reinterpret_cast<cpu::Word*>(mutated.get() + chunk_size) = new_word;
-          (*iter).old_value = old_word;
-          (*iter).new_value = new_word;
-          original_i += chunk_size + sizeof(cpu::Word);
-          mutated_i += chunk_size + sizeof(cpu::Word);
-        }
+        cpu::Word old_word = memory->get_word((*iter).address, false);
+        cpu::Word new_word = partial_mutation(old_word, random);
+        changed = old_word != new_word;
+        if (changed)
+          memory->set_word((*iter).address, new_word, false);
+        (*iter).old_value = old_word;
+        (*iter).new_value = new_word;
       }
 
       break;
@@ -239,16 +287,13 @@ static boost::shared_array<Uint8> mutate(MutationsList* list,
 #endif // DEBUG
 
       {
-        cpu::Word old_word =
-          *reinterpret_cast<cpu::Word*>(original.get() + chunk_size);
-        cpu::Word new_word = permutation(old_word);
-        if (old_word != new_word) {
-          *reinterpret_cast<cpu::Word*>(mutated.get() + chunk_size) = new_word;
-          (*iter).old_value = old_word;
-          (*iter).new_value = new_word;
-          original_i += chunk_size + sizeof(cpu::Word);
-          mutated_i += chunk_size + sizeof(cpu::Word);
-        }
+        cpu::Word old_word = memory->get_word((*iter).address, false);
+        cpu::Word new_word = permutation(old_word, random);
+        changed = old_word != new_word;
+        if (changed)
+          memory->set_word((*iter).address, new_word, false);
+        (*iter).old_value = old_word;
+        (*iter).new_value = new_word;
       }
 
       break;
@@ -260,11 +305,10 @@ static boost::shared_array<Uint8> mutate(MutationsList* list,
 #endif // DEBUG
 
       {
-        cpu::Word new_word = random_word();
-        *reinterpret_cast<cpu::Word*>(mutated.get() + chunk_size) = new_word;
+        cpu::Word new_word = random_word(random);
+        memory->insert((*iter).address, sizeof(cpu::Word));
+        memory->set_word((*iter).address, new_word, false);
         (*iter).new_value = new_word;
-        original_i += chunk_size;
-        mutated_i += chunk_size + sizeof(cpu::Word);
       }
 
       break;
@@ -277,12 +321,10 @@ static boost::shared_array<Uint8> mutate(MutationsList* list,
 
       {
         cpu::Word new_word =
-          *reinterpret_cast<cpu::Word*>(mutated.get() + chunk_size -
-                                        sizeof(cpu::Word));
-        *reinterpret_cast<cpu::Word*>(mutated.get() + chunk_size) = new_word;
+          memory->get_word((*iter).address - sizeof(cpu::Word), false);
+        memory->insert((*iter).address, sizeof(cpu::Word));
+        memory->set_word((*iter).address, new_word, false);
         (*iter).new_value = new_word;
-        original_i += chunk_size;
-        mutated_i += chunk_size + sizeof(cpu::Word);
       }
 
       break;
@@ -294,45 +336,70 @@ static boost::shared_array<Uint8> mutate(MutationsList* list,
 #endif // DEBUG
 
       {
-        cpu::Word old_word =
-          *reinterpret_cast<cpu::Word*>(original.get() + chunk_size);
+        cpu::Word old_word = memory->get_word((*iter).address, false);
+        memory->erase((*iter).address, sizeof(cpu::Word));
         (*iter).old_value = old_word;
-        original_i += chunk_size + sizeof(cpu::Word);
-        mutated_i += chunk_size;
       }
 
       break;
     }
+
+    if (changed)
+      ++iter;
+    else
+      iter = list->erase(iter);
   }
+}
 
-  if (mutated_i != size)
-    std::memcpy(mutated.get() + mutated_i, original.get() + original_i,
-                size - mutated_i);
 
-  return mutated;
-}
+/**
+ * Mutate a code.
+ * @param list pointer to the list of mutations.
+ * @param memory the code.
+ * @param probability probability to happen a mutation.
+ * @param random generator of the random numbers.
+ * @return if the code was mutated.
+ */
+bool mutate(MutationsList* list, cpu::Memory* memory, float probability,
+            Random* random)
+{
+  cpu::Address size = memory->size();
+  if (not plan_mutations(list, &size, probability, random))
+    return false;
 
+  apply_mutations(list, memory, random);
+
+  return not list->empty();
+}
 
 /**
- * Mutate the code of a bug.
+ * Create a copy of a code with mutations.
+ * The code is only copied if there are mutations.
  * @param list pointer to the list of mutations.
  * @param db pointer to the database.
- * @param code_id id of the code.
+ * @param new_code id of the new code.
+ * @param code the original code.
  * @param probability probability to happen a mutation.
+ * @param random generator of the random numbers.
  * @return if the code was mutated.
  */
-bool mutate(MutationsList* list, db::DB* db, db::ID code_id, float probability)
+bool mutate(MutationsList* list, db::DB* db, db::ID* new_code,
+            const cpu::Memory& code, float probability, Random* random)
 {
-  cpu::Address size = db::Code(db, code_id).data().size();
-  if (generate(list, &size, probability)) {
-    boost::shared_array<Uint8> mutated =
-      mutate(list, db::Code(db, code_id).data().read(&size), size);
-    db::Code(db, code_id).data().write(mutated.get(), size);
+  cpu::Address size = code.size();
+  if (not plan_mutations(list, &size, probability, random))
+    return false;
 
-    return true;
-  }
+  cpu::Memory mutated(code);
+  apply_mutations(list, &mutated, random);
+  if (list->empty())
+    return false;
+
+  boost::shared_array<Uint8> data(new Uint8[mutated.size()]);
+  mutated.read(data.get(), mutated.size());
+  *new_code = db::Code::insert(db, data.get(), mutated.size());
 
-  return false;
+  return true;
 }
 
 /**
@@ -342,21 +409,21 @@ bool mutate(MutationsList* list, db::DB* db, db::ID code_id, float probability)
  * @param new_code id of the new code.
  * @param code_id id of the original code.
  * @param probability probability to happen a mutation.
+ * @param random generator of the random numbers.
  * @return if the code was mutated.
  */
 bool mutate(MutationsList* list, db::DB* db, db::ID* new_code, db::ID code_id, 
-            float probability)
+            float probability, Random* random)
 {
-  cpu::Address size = db::Code(db, code_id).data().size();
-  if (generate(list, &size, probability)) {
-    boost::shared_array<Uint8> mutated =
-      mutate(list, db::Code(db, code_id).data().read(&size), size);
-    *new_code = db::Code::insert(db, mutated.get(), size);
+  // if the probability is 0, the code is not read
+  if (probability <= 0.0)
+    return false;
 
-    return true;
-  }
+  cpu::Address size;
+  boost::shared_array<Uint8> data = db::Code(db, code_id).data().read(&size);
 
-  return false;
+  return mutate(list, db, new_code, cpu::Memory(data.get(), size),
+                probability, random);
 }
 
 
@@ -369,46 +436,17 @@ bool mutate(MutationsList* list, db::DB* db, db::ID* new_code, db::ID code_id,
  */
 void update_mutations(MutationsList* list, db::DB* db, db::ID bug_id, Time time)
 {
+  std::vector<db::Mutation::Data> rows;
+  rows.reserve(list->size());
   for (MutationsList::const_iterator iter = list->begin();
        iter != list->end();
-       ++iter)
-    switch ((*iter).type) {
-      case db::Mutation::Total:
-        db::Mutation::insert_mutation(db, bug_id, time, (*iter).address,
-                                      (*iter).old_value, (*iter).new_value);
-
-        break;
-
-      case db::Mutation::Partial:
-        db::Mutation::insert_partial(db, bug_id, time, (*iter).address,
-                                     (*iter).old_value, (*iter).new_value);
-
-        break;
-
-      case db::Mutation::Permutation:
-        db::Mutation::insert_permutation(db, bug_id, time, (*iter).address,
-                                         (*iter).old_value, (*iter).new_value);
-
-        break;
-
-      case db::Mutation::Addition:
-        db::Mutation::insert_addition(db, bug_id, time, (*iter).address,
-                                      (*iter).new_value);
-
-        break;
-
-      case db::Mutation::Duplication:
-        db::Mutation::insert_duplication(db, bug_id, time, (*iter).address,
-                                         (*iter).new_value);
-
-        break;
-
-      case db::Mutation::Deletion:
-        db::Mutation::insert_deletion(db, bug_id, time, (*iter).address,
-                                      (*iter).old_value);
+       ++iter) {
+    db::Mutation::Data row = {(*iter).type, (*iter).address,
+                              (*iter).old_value, (*iter).new_value};
+    rows.push_back(row);
+  }
 
-      break;
-    }
+  db::Mutation::insert(db, bug_id, time, rows);
 }
 
 }
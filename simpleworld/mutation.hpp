@@ -24,7 +24,9 @@
 #include <list>
 
 #include <simpleworld/types.hpp>
+#include <simpleworld/random.hpp>
 #include <simpleworld/cpu/types.hpp>
+#include <simpleworld/cpu/memory.hpp>
 #include <simpleworld/db/types.hpp>
 #include <simpleworld/db/mutation.hpp>
 
@@ -49,14 +51,55 @@ typedef std::list<Mutation> MutationsList;
 
 
 /**
- * Mutate the code of a bug.
+ * Plan the mutations of a code.
+ * Each word is mutated with the same probability, but instead of a trial
+ * for each word the distance to the next mutation is drawn, so the cost
+ * depends on the number of mutations and not on the size of the code.
+ * @param list pointer to a list of mutations.
+ * @param size pointer to the size of the code.
+ * @param probability probability to happen a mutation.
+ * @param random generator of the random numbers.
+ * @return if the code is mutated.
+ */
+bool plan_mutations(MutationsList* list, cpu::Address* size,
+                    float probability, Random* random);
+
+/**
+ * Apply a list of mutations to a code.
+ * The mutations are applied in order, so the address of each mutation is
+ * relative to the code already mutated by the previous ones. The mutations
+ * that don't change the code are removed from the list.
+ * @param list pointer to the list of mutations.
+ * @param memory the code.
+ * @param random generator of the random numbers.
+ */
+void apply_mutations(MutationsList* list, cpu::Memory* memory,
+                     Random* random);
+
+/**
+ * Mutate a code.
+ * @param list pointer to the list of mutations.
+ * @param memory the code.
+ * @param probability probability to happen a mutation.
+ * @param random generator of the random numbers.
+ * @return if the code was mutated.
+ */
+bool mutate(MutationsList* list, cpu::Memory* memory, float probability,
+            Random* random);
+
+/**
+ * Create a copy of a code with mutations.
+ * The code is only copied if there are mutations.
  * @param list pointer to the list of mutations.
  * @param db pointer to the database.
- * @param code_id id of the code.
+ * @param new_code id of the new code.
+ * @param code the original code.
  * @param probability probability to happen a mutation.
+ * @param random generator of the random numbers.
  * @return if the code was mutated.
  */
-bool mutate(MutationsList* list, db::DB* db, db::ID code_id, float probability);
+bool mutate(MutationsList* list, db::DB* db, db::ID* new_code,
+            const cpu::Memory& code, float probability, Random* random);
 
 /**
  * Create a copy of the code of a bug with mutations.
@@ -65,10 +108,11 @@ bool mutate(MutationsList* list, db::DB* db, db::ID code_id, float probability);
  * @param new_code id of the new code.
  * @param code_id id of the original code.
  * @param probability probability to happen a mutation.
+ * @param random generator of the random numbers.
  * @return if the code was mutated.
  */
 bool mutate(MutationsList* list, db::DB* db, db::ID* new_code, db::ID code_id, 
-            float probability);
+            float probability, Random* random);
 
 /**
  * Insert the mutations in the Mutation table of the database.
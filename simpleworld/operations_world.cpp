@@ -18,15 +18,10 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <cassert>
-
-#include <boost/format.hpp>
-
 #include <simpleworld/cpu/types.hpp>
 
 #include "types.hpp"
-#include "actionerror.hpp"
-#include "actionblocked.hpp"
+#include "isa.hpp"
 #include "simpleworld.hpp"
 #include "cpu.hpp"
 #include "bug.hpp"
@@ -64,7 +59,13 @@ namespace simpleworld
  */
 cpu::Update world(cpu::CPU& cpu, cpu::Instruction inst)
 {
-  Bug* bug = dynamic_cast<CPU*>(&cpu)->bug;;
+  CPU* bug_cpu = dynamic_cast<CPU*>(&cpu);
+  // the World is not used by CPU::speculate(), the instruction is executed
+  // later by CPU::resume()
+  if (bug_cpu->speculating())
+    return bug_cpu->yield(CPU::YieldDeferred);
+
+  Bug* bug = bug_cpu->bug;
   Time time = bug->world->env().time();
 
   // a action can take several cycles to be finished
@@ -75,7 +76,7 @@ cpu::Update world(cpu::CPU& cpu, cpu::Instruction inst)
   // interrupt was thrown
 
   // check the state of the action
-  if (bug->is_null("action_time")) {
+  if (bug->action_time_null()) {
     // the action begins in this cycle and after some cycles the action can be
     // finished
     // every action last for a fixed number of cycles
@@ -127,141 +128,134 @@ cpu::Update world(cpu::CPU& cpu, cpu::Instruction inst)
       break;
 
     default:
-      throw EXCEPTION(ActionError, boost::str(boost::format(\
-"Unknown action (0x%04x)")
-                                                % inst.data));
+      // invalid world command
+      cpu.interrupt(INTERRUPT_WORLDACTION, cpu.get_reg(REGISTER_PC),
+                    inst.data);
+      return cpu::UpdateInterrupt;
     }
   }
 
 
-  // if the action can't be completed in this cycle throw ActionBlocked
+  // if the action can't be completed in this cycle the rest of the cycles
+  // are skipped
   if (bug->action_time() > time)
-    throw EXCEPTION(ActionBlocked, "Action can't be executed now");
+    return bug_cpu->yield(CPU::YieldBlocked);
 
 
   // the action is finished in this cycle
+  ActionStatus status;
+  cpu::Word value;
   cpu::Word ypos;
-
-  try {
-    switch (inst.data) {
-    case ACTION_NOTHING:
-      bug->world->nothing(bug);
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-
-    case ACTION_MYSELFID:
-      cpu.set_reg(REGISTER_G1,
-                  static_cast<cpu::Word>(bug->world->myself(bug, InfoID,
-                                                            NULL)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-    case ACTION_MYSELFSIZE:
-      cpu.set_reg(REGISTER_G1,
-                  static_cast<cpu::Word>(bug->world->myself(bug, InfoSize,
-                                                            NULL)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-    case ACTION_MYSELFENERGY:
-      cpu.set_reg(REGISTER_G1,
-                  static_cast<cpu::Word>(bug->world->myself(bug, InfoEnergy,
-                                                            NULL)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-    case ACTION_MYSELFPOSITION:
-      cpu.set_reg(REGISTER_G1, bug->world->myself(bug, InfoPosition, &ypos));
+  ElementType type;
+  Energy energy;
+
+  switch (inst.data) {
+  case ACTION_NOTHING:
+    status = bug->world->nothing(bug);
+    break;
+
+  case ACTION_MYSELFID:
+    status = bug->world->myself(bug, InfoID, &value, NULL);
+    if (status == ActionSuccess)
+      cpu.set_reg(REGISTER_G1, value);
+    break;
+  case ACTION_MYSELFSIZE:
+    status = bug->world->myself(bug, InfoSize, &value, NULL);
+    if (status == ActionSuccess)
+      cpu.set_reg(REGISTER_G1, value);
+    break;
+  case ACTION_MYSELFENERGY:
+    status = bug->world->myself(bug, InfoEnergy, &value, NULL);
+    if (status == ActionSuccess)
+      cpu.set_reg(REGISTER_G1, value);
+    break;
+  case ACTION_MYSELFPOSITION:
+    status = bug->world->myself(bug, InfoPosition, &value, &ypos);
+    if (status == ActionSuccess) {
+      cpu.set_reg(REGISTER_G1, value);
       cpu.set_reg(REGISTER_G2, ypos);
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-    case ACTION_MYSELFORIENTATION:
-      cpu.set_reg(REGISTER_G1,
-                  static_cast<cpu::Word>(bug->world->myself(bug,
-                                                            InfoOrientation,
-                                                            NULL)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-
-    case ACTION_DETECT:
-      cpu.set_reg(REGISTER_G1,
-                  static_cast<cpu::Word>(bug->world->detect(bug)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-
-    case ACTION_INFOID:
-      cpu.set_reg(REGISTER_G1,
-                  static_cast<cpu::Word>(bug->world->information(bug, InfoID,
-                                                                 NULL)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-    case ACTION_INFOSIZE:
-      cpu.set_reg(REGISTER_G1,
-                  static_cast<cpu::Word>(bug->world->information(bug,
-                                                                 InfoSize,
-                                                                 NULL)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-    case ACTION_INFOENERGY:
-      cpu.set_reg(REGISTER_G1,
-                  static_cast<cpu::Word>(bug->world->information(bug,
-                                                                 InfoEnergy,
-                                                                 NULL)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-    case ACTION_INFOPOSITION:
-      cpu.set_reg(REGISTER_G1, bug->world->information(bug, InfoPosition,
-                                                       &ypos));
+    }
+    break;
+  case ACTION_MYSELFORIENTATION:
+    status = bug->world->myself(bug, InfoOrientation, &value, NULL);
+    if (status == ActionSuccess)
+      cpu.set_reg(REGISTER_G1, value);
+    break;
+
+  case ACTION_DETECT:
+    status = bug->world->detect(bug, &type);
+    if (status == ActionSuccess)
+      cpu.set_reg(REGISTER_G1, static_cast<cpu::Word>(type));
+    break;
+
+  case ACTION_INFOID:
+    status = bug->world->information(bug, InfoID, &value, NULL);
+    if (status == ActionSuccess)
+      cpu.set_reg(REGISTER_G1, value);
+    break;
+  case ACTION_INFOSIZE:
+    status = bug->world->information(bug, InfoSize, &value, NULL);
+    if (status == ActionSuccess)
+      cpu.set_reg(REGISTER_G1, value);
+    break;
+  case ACTION_INFOENERGY:
+    status = bug->world->information(bug, InfoEnergy, &value, NULL);
+    if (status == ActionSuccess)
+      cpu.set_reg(REGISTER_G1, value);
+    break;
+  case ACTION_INFOPOSITION:
+    status = bug->world->information(bug, InfoPosition, &value, &ypos);
+    if (status == ActionSuccess) {
+      cpu.set_reg(REGISTER_G1, value);
       cpu.set_reg(REGISTER_G2, ypos);
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-    case ACTION_INFOORIENTATION:
-      cpu.set_reg(REGISTER_G1,
-                  static_cast<cpu::Word>(bug->world->information(bug,
-                                                                 InfoOrientation,
-                                                                 NULL)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-
-    case ACTION_MOVEFORWARD:
-      bug->world->move(bug, MoveForward);
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-    case ACTION_MOVEBACKWARD:
-      bug->world->move(bug, MoveBackward);
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-
-    case ACTION_TURNLEFT:
-      bug->world->turn(bug, TurnLeft);
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-    case ACTION_TURNRIGHT:
-      bug->world->turn(bug, TurnRight);
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-
-    case ACTION_ATTACK:
-      bug->world->attack(bug, static_cast<Energy>(cpu.get_reg(REGISTER_G0)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-
-    case ACTION_EAT:
-      cpu.set_reg(REGISTER_G1, static_cast<cpu::Word>(bug->world->eat(bug)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-
-    case ACTION_EGG:
-      bug->world->egg(bug, static_cast<Energy>(cpu.get_reg(REGISTER_G0)));
-      cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionSuccess));
-      break;
-
-    default:
-      throw EXCEPTION(ActionError, boost::str(boost::format(\
-"Unknown action (0x%04x)")
-                                              % inst.data));
     }
-  } catch (const ActionError& e) {
-    cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(ActionFailure));
+    break;
+  case ACTION_INFOORIENTATION:
+    status = bug->world->information(bug, InfoOrientation, &value, NULL);
+    if (status == ActionSuccess)
+      cpu.set_reg(REGISTER_G1, value);
+    break;
+
+  case ACTION_MOVEFORWARD:
+    status = bug->world->move(bug, MoveForward);
+    break;
+  case ACTION_MOVEBACKWARD:
+    status = bug->world->move(bug, MoveBackward);
+    break;
+
+  case ACTION_TURNLEFT:
+    status = bug->world->turn(bug, TurnLeft);
+    break;
+  case ACTION_TURNRIGHT:
+    status = bug->world->turn(bug, TurnRight);
+    break;
+
+  case ACTION_ATTACK:
+    status = bug->world->attack(bug,
+                                static_cast<Energy>(cpu.get_reg(REGISTER_G0)));
+    break;
+
+  case ACTION_EAT:
+    status = bug->world->eat(bug, &energy);
+    if (status == ActionSuccess)
+      cpu.set_reg(REGISTER_G1, static_cast<cpu::Word>(energy));
+    break;
+
+  case ACTION_EGG:
+    status = bug->world->egg(bug,
+                             static_cast<Energy>(cpu.get_reg(REGISTER_G0)));
+    break;
+
+  default:
+    status = ActionFailure;
   }
 
+  // the bug is killed by the caller of the CPU
+  if (status == ActionDeath)
+    return bug_cpu->yield(CPU::YieldDeath);
+
+  cpu.set_reg(REGISTER_G0, static_cast<cpu::Word>(status));
+
 
   // the action is finished
   bug->time_last_action(time);
@@ -0,0 +1,86 @@
+/**
+ * @file simpleworld/pool.hpp
+ * Pool of objects of the same type.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEWORLD_POOL_HPP
+#define SIMPLEWORLD_POOL_HPP
+
+#include <new>
+
+#include <boost/pool/pool.hpp>
+
+namespace simpleworld
+{
+
+/**
+ * Pool of objects of the same type.
+ * The memory is allocated in blocks and reused when a object is destroyed.
+ * The objects not destroyed when the pool is destroyed are not finalized.
+ */
+template <typename T>
+class Pool
+{
+public:
+  /**
+   * Constructor.
+   */
+  Pool()
+    : pool_(sizeof(T))
+  {}
+
+
+  /**
+   * Create a object.
+   * @param a1 first parameter of the constructor.
+   * @param a2 second parameter of the constructor.
+   * @return the new object.
+   * @exception std::bad_alloc if there is no memory.
+   */
+  template <typename A1, typename A2>
+  T* construct(A1 a1, A2 a2)
+  {
+    void* memory = this->pool_.malloc();
+    if (memory == NULL)
+      throw std::bad_alloc();
+
+    try {
+      return new (memory) T(a1, a2);
+    } catch (...) {
+      this->pool_.free(memory);
+      throw;
+    }
+  }
+
+  /**
+   * Destroy a object created by this pool.
+   * @param ptr the object.
+   */
+  void destroy(T* ptr)
+  {
+    ptr->~T();
+    this->pool_.free(ptr);
+  }
+
+private:
+  boost::pool<> pool_;
+};
+
+}
+
+#endif // SIMPLEWORLD_POOL_HPP
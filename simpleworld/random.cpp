@@ -0,0 +1,124 @@
+/**
+ * @file simpleworld/random.cpp
+ * Counter-based random number generator.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+
+#include "random.hpp"
+
+namespace simpleworld
+{
+
+/**
+ * Increment of the SplitMix64 generator (2^64 / golden ratio).
+ */
+static const Uint64 golden_gamma = 0x9e3779b97f4a7c15ULL;
+
+/**
+ * Finalizer of the SplitMix64 generator.
+ * @param value the value to mix.
+ * @return the value mixed.
+ */
+static Uint64 mix(Uint64 value)
+{
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+
+/**
+ * Constructor.
+ * @param seed seed of the World.
+ * @param entity id of the element that uses the numbers.
+ * @param cycle cycle when the numbers are used.
+ * @param purpose use of the numbers.
+ */
+Random::Random(Uint32 seed, Uint64 entity, Time cycle, RandomPurpose purpose)
+  : counter_(0)
+{
+  this->key_ = mix(seed + golden_gamma);
+  this->key_ = mix(this->key_ ^ (entity + golden_gamma));
+  this->key_ = mix(this->key_ ^ (cycle + golden_gamma));
+  this->key_ = mix(this->key_ ^ (purpose + golden_gamma));
+}
+
+
+/**
+ * Get the next random number.
+ * @return the random number.
+ */
+Uint32 Random::next()
+{
+  this->counter_++;
+
+  return mix(this->key_ + this->counter_ * golden_gamma) >> 32;
+}
+
+/**
+ * Get a random number in the range min <= n < max.
+ * @param min the minimun value.
+ * @param max the maximun value.
+ * @return the random number.
+ */
+Uint32 Random::integer(Uint32 min, Uint32 max)
+{
+  assert(min < max);
+
+  return min + ((static_cast<Uint64>(this->next()) * (max - min)) >> 32);
+}
+
+/**
+ * Get a random number of 64 bits in the range min <= n < max.
+ * If the range fits in 32 bits the number is the same as the one of
+ * integer().
+ * @param min the minimun value.
+ * @param max the maximun value.
+ * @return the random number.
+ */
+Uint64 Random::integer64(Uint64 min, Uint64 max)
+{
+  assert(min < max);
+
+  Uint64 range = max - min;
+  if (range <= 0xffffffff)
+    return min + this->integer(0, static_cast<Uint32>(range));
+
+  // the numbers of 64 bits below 2^64 % range are rejected, so all the
+  // values of n % range have the same probability
+  Uint64 limit = (0 - range) % range;
+  Uint64 number;
+  do {
+    number = static_cast<Uint64>(this->next()) << 32;
+    number |= this->next();
+  } while (number < limit);
+
+  return min + number % range;
+}
+
+/**
+ * Get a random number in the range 0 <= n < 1.
+ * @return the random number.
+ */
+double Random::real()
+{
+  return this->next() / 4294967296.0;
+}
+
+}
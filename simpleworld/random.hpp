@@ -0,0 +1,100 @@
+/**
+ * @file simpleworld/random.hpp
+ * Counter-based random number generator.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEWORLD_RANDOM_HPP
+#define SIMPLEWORLD_RANDOM_HPP
+
+#include <simpleworld/ints.hpp>
+#include <simpleworld/types.hpp>
+
+namespace simpleworld
+{
+
+/**
+ * Use of the random numbers.
+ */
+enum RandomPurpose {
+  RandomSpawn,                  /**< Eggs created by a spawn */
+  RandomResource,               /**< Food created by a resource */
+  RandomMutation,               /**< Mutations of the code of a bug */
+  RandomCommand                 /**< Elements added by the user */
+};
+
+
+/**
+ * Counter-based random number generator.
+ *
+ * The numbers are the SplitMix64 hash of a key and a counter, and the key
+ * is the hash of the seed of the World, the element that uses the numbers,
+ * the cycle and the purpose. So the numbers only depend on who uses them
+ * and when, not on the numbers used before by other elements, and the
+ * generators don't share any state.
+ */
+class Random
+{
+public:
+  /**
+   * Constructor.
+   * @param seed seed of the World.
+   * @param entity id of the element that uses the numbers.
+   * @param cycle cycle when the numbers are used.
+   * @param purpose use of the numbers.
+   */
+  Random(Uint32 seed, Uint64 entity, Time cycle, RandomPurpose purpose);
+
+
+  /**
+   * Get the next random number.
+   * @return the random number.
+   */
+  Uint32 next();
+
+  /**
+   * Get a random number in the range min <= n < max.
+   * @param min the minimun value.
+   * @param max the maximun value.
+   * @return the random number.
+   */
+  Uint32 integer(Uint32 min, Uint32 max);
+
+  /**
+   * Get a random number of 64 bits in the range min <= n < max.
+   * If the range fits in 32 bits the number is the same as the one of
+   * integer().
+   * @param min the minimun value.
+   * @param max the maximun value.
+   * @return the random number.
+   */
+  Uint64 integer64(Uint64 min, Uint64 max);
+
+  /**
+   * Get a random number in the range 0 <= n < 1.
+   * @return the random number.
+   */
+  double real();
+
+private:
+  Uint64 key_;                  /**< Hash of the seed, entity, cycle... */
+  Uint64 counter_;              /**< Numbers generated */
+};
+
+}
+
+#endif // SIMPLEWORLD_RANDOM_HPP
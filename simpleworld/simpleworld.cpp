@@ -29,11 +29,12 @@
 
 #include <algorithm>
 #include <vector>
-#include <list>
 #include <cassert>
 
 #include <boost/scoped_array.hpp>
 #include <boost/format.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
 
 #include <simpleworld/cpu/types.hpp>
 #include <simpleworld/cpu/exception.hpp>
@@ -52,52 +53,118 @@
 #include "config.hpp"
 #include "simpleworld.hpp"
 #include "worlderror.hpp"
-#include "actionerror.hpp"
-#include "actionblocked.hpp"
-#include "bugdeath.hpp"
 #include "movement.hpp"
 #include "mutation.hpp"
+#include "isa.hpp"
+
+/**
+ * Instructions executed by each bug in a cycle.
+ * The same number is used by the serial and the parallel execution, so
+ * both give the same results.
+ */
+#define CYCLES_BY_BUG 1024
 
 namespace simpleworld
 {
 
+/**
+ * Get the first cycle after a given one that is base plus a multiple of
+ * period.
+ * @param base first cycle of the serie.
+ * @param period cycles between two cycles of the serie.
+ * @param after the cycle must be after this one.
+ * @return the cycle.
+ */
+static Time next_cycle(Time base, Time period, Time after)
+{
+  if (after < base)
+    return base;
+
+  return base + ((after - base) / period + 1) * period;
+}
+
+/**
+ * Get the time of the last action of a bug.
+ * If the bug has not done any action, the time of its birth is used.
+ * @param bug The bug.
+ * @return the time.
+ */
+static Time last_action(Bug* bug)
+{
+  if (bug->time_last_action_null())
+    return bug->birth();
+  else
+    return bug->time_last_action();
+}
+
+/**
+ * Get the elements of the due events in the order they are in the map.
+ * The elements that were removed are skipped.
+ * @param map the elements.
+ * @param due the handles of the due events.
+ * @return the elements.
+ */
+template <typename T>
+static std::vector<T*> due_elements(const SlotMap<T>& map,
+                                    const std::vector<SlotHandle>& due)
+{
+  typedef std::pair<typename SlotMap<T>::size_type, T*> Ordered;
+  std::vector<Ordered> order;
+  for (std::vector<SlotHandle>::const_iterator handle = due.begin();
+       handle != due.end();
+       ++handle) {
+    T* element = map.get(*handle);
+    if (element != NULL)
+      order.push_back(std::make_pair(map.order(element), element));
+  }
+  std::sort(order.begin(), order.end());
+
+  std::vector<T*> elements;
+  elements.reserve(order.size());
+  for (typename std::vector<Ordered>::const_iterator element = order.begin();
+       element != order.end();
+       ++element)
+    elements.push_back(element->second);
+
+  return elements;
+}
+
+/**
+ * Execute the cycle of a bug until it needs the World.
+ * @param bugs the bugs.
+ * @param index index of the bug.
+ */
+static void speculate(const std::vector<Bug*>& bugs, std::size_t index)
+{
+  bugs[index]->cpu.speculate(CYCLES_BY_BUG);
+}
+
+
 /**
  * Constructor.
+ * If memory is true the World runs in a copy of the database in memory
+ * that is written to the file only in the checkpoints.
  * @param filename File name of the database.
+ * @param memory if the database is kept in memory.
  * @exception DBException if there is a error in the database.
  */
-SimpleWorld::SimpleWorld(std::string filename)
-  : DB(filename)
+SimpleWorld::SimpleWorld(std::string filename, bool memory)
+  : DB(filename, memory), env_(NULL), code_cache_(isa), sequence_(0),
+    checkpoint_every_(0), threads_(0)
 {
-  this->env_ = new db::Environment(this, this->last_environment());
+  this->env_load();
   this->world_ = new World(Position(this->env_->size_x(), this->env_->size_y()));
 
 
   // Load the elements of the world
   std::vector< db::ID > ids;
 
-  ids = this->spawns();
-  for (std::vector< db::ID >::const_iterator iter = ids.begin();
-       iter != ids.end();
-       ++iter) {
-    db::Spawn* ptr = new db::Spawn(this, *iter);
-    this->spawns_.push_back(ptr);
-  }
-
-  ids = this->resources();
-  for (std::vector< db::ID >::const_iterator iter = ids.begin();
-       iter != ids.end();
-       ++iter) {
-    db::Resource* ptr = new db::Resource(this, *iter);
-    this->resources_.push_back(ptr);
-  }
-
   ids = this->food();
   for (std::vector< db::ID >::const_iterator iter = ids.begin();
        iter != ids.end();
        ++iter) {
-    Food* ptr = new Food(this, *iter);
-    this->foods_.push_back(ptr);
+    Food* ptr = this->food_pool_.construct(this, *iter);
+    this->foods_.insert(ptr);
     this->world_->add(ptr, Position(ptr->position_x(), ptr->position_y()));
   }
 
@@ -105,8 +172,8 @@ SimpleWorld::SimpleWorld(std::string filename)
   for (std::vector< db::ID >::const_iterator iter = ids.begin();
        iter != ids.end();
        ++iter) {
-    Egg* ptr = new Egg(this, *iter);
-    this->eggs_.push_back(ptr);
+    Egg* ptr = this->egg_pool_.construct(this, *iter);
+    this->eggs_.insert(ptr);
     this->world_->add(ptr, Position(ptr->position_x(), ptr->position_y()));
   }
 
@@ -114,10 +181,13 @@ SimpleWorld::SimpleWorld(std::string filename)
   for (std::vector< db::ID >::const_iterator iter = ids.begin();
        iter != ids.end();
        ++iter) {
-    Bug* ptr = new Bug(this, *iter);
-    this->bugs_.push_back(ptr);
+    Bug* ptr = this->bug_pool_.construct(this, *iter);
+    ptr->sequence = this->sequence_++;
+    this->bugs_.insert(ptr);
     this->world_->add(ptr, Position(ptr->position_x(), ptr->position_y()));
   }
+
+  this->events_load();
 }
 
 /**
@@ -126,27 +196,42 @@ SimpleWorld::SimpleWorld(std::string filename)
 SimpleWorld::~SimpleWorld()
 {
   // Free the food
-  std::list<Food*>::iterator food = this->foods_.begin();
+  SlotMap<Food>::iterator food = this->foods_.begin();
   while (food != this->foods_.end()) {
-    delete (*food);
+    this->food_pool_.destroy(*food);
     ++food;
   }
 
   // Free the eggs
-  std::list<Egg*>::iterator egg = this->eggs_.begin();
+  SlotMap<Egg>::iterator egg = this->eggs_.begin();
   while (egg != this->eggs_.end()) {
-    delete (*egg);
+    this->egg_pool_.destroy(*egg);
     ++egg;
   }
 
   // Free the bugs
-  std::list<Bug*>::iterator bug = this->bugs_.begin();
+  SlotMap<Bug>::iterator bug = this->bugs_.begin();
   while (bug != this->bugs_.end()) {
-    delete (*bug);
+    this->bug_pool_.destroy(*bug);
     ++bug;
   }
 
 
+  // Free the spawns
+  std::vector<db::Spawn*>::iterator spawn = this->spawns_.begin();
+  while (spawn != this->spawns_.end()) {
+    delete (*spawn);
+    ++spawn;
+  }
+
+  // Free the resources
+  std::vector<db::Resource*>::iterator resource = this->resources_.begin();
+  while (resource != this->resources_.end()) {
+    delete (*resource);
+    ++resource;
+  }
+
+
   // Free the world
   delete this->world_;
   // Free the environment
@@ -182,14 +267,15 @@ void SimpleWorld::add_egg(Energy energy,
     id = db::Bug::insert(this, code_id, this->env_->time());
     db::ID world_id = db::World::insert(this, position.x, position.y,
                                         orientation);
-    db::Egg::insert(this, id, world_id, energy, db::Code::insert(this, code_id));
+    db::Egg::insert(this, id, world_id, energy, code_id);
   } catch (const db::DBException& e) {
     throw EXCEPTION(WorldError, e.info);
   }
 
-  Egg* egg = new Egg(this, id);
-  this->eggs_.push_back(egg);
+  Egg* egg = this->egg_pool_.construct(this, id);
+  this->eggs_.insert(egg);
   this->world_->add(egg, position);
+  this->schedule(egg);
 
   transaction.commit();
 }
@@ -214,9 +300,10 @@ void SimpleWorld::add_food(Position position, Energy size)
     throw EXCEPTION(WorldError, e.info);
   }
 
-  Food* food = new Food(this, id);
-  this->foods_.push_back(food);
+  Food* food = this->food_pool_.construct(this, id);
+  this->foods_.insert(food);
   this->world_->add(food, position);
+  this->schedule(food);
 
   transaction.commit();
 }
@@ -224,18 +311,33 @@ void SimpleWorld::add_food(Position position, Energy size)
 
 /**
  * Execute some cycles of the World.
+ * If the database is in memory, it's written to the file at the end of the
+ * first transaction after checkpoint_every() cycles since the last
+ * checkpoint and after the last cycle.
  * @param cycles Cycles to be executed.
  */
 void SimpleWorld::run(Time cycles)
 {
   Time time = this->env_->time();
+  if (this->pool_.get() == NULL)
+    this->pool_.reset(new ThreadPool(this->threads_));
 
+  // cycles since the last checkpoint
+  Time checkpoint_cycles = 0;
   while (cycles > 0) {
     db::Transaction transaction(this, db::Transaction::immediate);
+    if (this->data_version() != this->data_version_) {
+      this->env_load();
+      this->events_load();
+    }
 
-    const Time cycles_transaction = (cycles < CYCLES_BY_TRANSACTION) ?
+    Time cycles_transaction = (cycles < CYCLES_BY_TRANSACTION) ?
       cycles : CYCLES_BY_TRANSACTION;
     for (Time i = cycles_transaction; i > 0; i--) {
+      this->foods_.compact();
+      this->eggs_.compact();
+      this->bugs_.compact();
+
       this->spawn_eggs();
       this->spawn_food();
 
@@ -252,23 +354,51 @@ void SimpleWorld::run(Time cycles)
       this->bugs_laziness();
       this->food_rot();
 
-      if (time % 1024 == 0)
+      if (time % 1024 == 0) {
+        this->save();
         db::Stats::insert(this);
+      }
     }
 
     cycles -= cycles_transaction;
 
+    this->save();
     transaction.commit();
+
+    // the checkpoints don't end the transactions because the bugs are
+    // saved in each commit and the ids of the code depend on it, so the
+    // file is the same that would be written without the memory
+    if (this->memory()) {
+      checkpoint_cycles += cycles_transaction;
+      if (cycles == 0 or
+          (this->checkpoint_every_ > 0 and
+           checkpoint_cycles >= this->checkpoint_every_)) {
+        this->checkpoint();
+        checkpoint_cycles = 0;
+      }
+    }
   }
 }
 
 
+/**
+ * Change the number of threads used to execute the bugs.
+ * The results don't depend on the number of threads.
+ * @param threads number of threads, 0 to use the number of processors.
+ */
+void SimpleWorld::threads(unsigned threads)
+{
+  this->threads_ = threads;
+  this->pool_.reset();
+}
+
+
 /**
  * Do nothing.
  * @param bug Bug that executes the action.
- * @exception ActionError if something fails.
+ * @return the status of the action.
  */
-void SimpleWorld::nothing(Bug* bug)
+ActionStatus SimpleWorld::nothing(Bug* bug)
 {
 #ifdef DEBUG
   std::cout << boost::format("Bug %1% doing action nothing")
@@ -276,18 +406,22 @@ void SimpleWorld::nothing(Bug* bug)
     << std::endl;
 #endif // DEBUG
 
-  this->substract_energy(bug, this->env_->energy_nothing());
+  if (not this->substract_energy(bug, this->env_->energy_nothing()))
+    return ActionDeath;
+
+  return ActionSuccess;
 }
 
 /**
  * Get information about the bug itself.
  * @param bug Bug that executes the action.
  * @param info Type of information requested.
+ * @param value Where to save the information.
  * @param ypos Where to save the Y coord when requested the position.
- * @return The information.
- * @exception ActionError if something fails.
+ * @return the status of the action.
  */
-cpu::Word SimpleWorld::myself(Bug* bug, Info info, cpu::Word* ypos)
+ActionStatus SimpleWorld::myself(Bug* bug, Info info, cpu::Word* value,
+                                 cpu::Word* ypos)
 {
 #ifdef DEBUG
   std::cout << boost::format("Bug %1% doing action myself")
@@ -295,39 +429,44 @@ cpu::Word SimpleWorld::myself(Bug* bug, Info info, cpu::Word* ypos)
     << std::endl;
 #endif // DEBUG
 
-  this->substract_energy(bug, this->env_->energy_myself());
+  if (not this->substract_energy(bug, this->env_->energy_myself()))
+    return ActionDeath;
 
   switch (info) {
   case InfoID:
-    return static_cast<cpu::Word>(bug->id());
+    *value = static_cast<cpu::Word>(bug->id());
+    return ActionSuccess;
 
   case InfoSize:
-    return static_cast<cpu::Word>(db::Code(this, bug->memory_id()).data().size());
+    *value = static_cast<cpu::Word>(bug->mem.size());
+    return ActionSuccess;
 
   case InfoEnergy:
-    return static_cast<cpu::Word>(bug->energy());
+    *value = static_cast<cpu::Word>(bug->energy());
+    return ActionSuccess;
 
   case InfoPosition:
     *ypos = static_cast<cpu::Word>(bug->position_y());
-    return static_cast<cpu::Word>(bug->position_x());
+    *value = static_cast<cpu::Word>(bug->position_x());
+    return ActionSuccess;
 
   case InfoOrientation:
-    return static_cast<cpu::Word>(bug->orientation());
+    *value = static_cast<cpu::Word>(bug->orientation());
+    return ActionSuccess;
 
   default:
-    throw EXCEPTION(ActionError, boost::str(boost::format(\
-"Type of information (0x%04x) unknown")
-                                            % info));
+    // Type of information unknown
+    return ActionFailure;
   }
 }
 
 /**
  * Get the type of element that is in front of the bug.
  * @param bug Bug that executes the action.
- * @return The type of element.
- * @exception ActionError if something fails.
+ * @param type Where to save the type of element.
+ * @return the status of the action.
  */
-ElementType SimpleWorld::detect(Bug* bug)
+ActionStatus SimpleWorld::detect(Bug* bug, ElementType* type)
 {
 #ifdef DEBUG
   std::cout << boost::format("Bug %1% doing action detect")
@@ -335,25 +474,25 @@ ElementType SimpleWorld::detect(Bug* bug)
     << std::endl;
 #endif // DEBUG
 
-  this->substract_energy(bug, this->env_->energy_detect());
+  if (not this->substract_energy(bug, this->env_->energy_detect()))
+    return ActionDeath;
 
-  Position front = this->front(bug);
-  try {
-    return this->world_->get(front)->type;
-  } catch (const WorldError& e) {
-    return ElementNothing;
-  }
+  Element* target = this->world_->try_get(this->front(bug));
+  *type = target == NULL ? ElementNothing : target->type;
+
+  return ActionSuccess;
 }
 
 /**
  * Get information about the bug that is in front of the bug.
  * @param bug Bug that executes the action.
  * @param info Type of information requested.
+ * @param value Where to save the information.
  * @param ypos Where to save the Y coord when requested the position.
- * @return The information.
- * @exception ActionError if something fails.
+ * @return the status of the action.
  */
-cpu::Word SimpleWorld::information(Bug* bug, Info info, cpu::Word* ypos)
+ActionStatus SimpleWorld::information(Bug* bug, Info info, cpu::Word* value,
+                                      cpu::Word* ypos)
 {
 #ifdef DEBUG
   std::cout << boost::format("Bug %1% doing action information")
@@ -361,18 +500,14 @@ cpu::Word SimpleWorld::information(Bug* bug, Info info, cpu::Word* ypos)
     << std::endl;
 #endif // DEBUG
 
-  this->substract_energy(bug, this->env_->energy_info());
+  if (not this->substract_energy(bug, this->env_->energy_info()))
+    return ActionDeath;
 
   Position front = this->front(bug);
-  Element* target;
-  try {
-    target = this->world_->get(front);
-  } catch (const WorldError& e) {
-    throw EXCEPTION(ActionError, boost::str(boost::format("\
-There is nothing in (%1%, %2%)")
-                                            % front.x
-                                            % front.y));
-  }
+  Element* target = this->world_->try_get(front);
+  // There is nothing in front of the bug
+  if (target == NULL)
+    return ActionFailure;
   // ElementNothing is not a valid type, it's only send to bugs to inform
   // them that there is nothing in the World
   assert(target->type != ElementNothing);
@@ -380,44 +515,51 @@ There is nothing in (%1%, %2%)")
   switch (info) {
   case InfoID:  // Only eggs and bugs
     if (target->type == ElementEgg)
-      return static_cast<cpu::Word>(static_cast<Egg*>(target)->id());
+      *value = static_cast<cpu::Word>(static_cast<Egg*>(target)->id());
     else if (target->type == ElementBug)
-      return static_cast<cpu::Word>(static_cast<Bug*>(target)->id());
+      *value = static_cast<cpu::Word>(static_cast<Bug*>(target)->id());
     else
-      throw EXCEPTION(ActionError, "Food has no id");
+      // Food has no id
+      return ActionFailure;
+    return ActionSuccess;
 
   case InfoSize: // Every element
     if (target->type == ElementFood)
-      return static_cast<cpu::Word>(static_cast<Food*>(target)->size());
+      *value = static_cast<cpu::Word>(static_cast<Food*>(target)->size());
     else if (target->type == ElementEgg)
-      return static_cast<cpu::Word>(db::Code(this, static_cast<Egg*>(target)->memory_id()).data().size());
+      *value = static_cast<cpu::Word>(db::Code(this, static_cast<Egg*>(target)->memory_id()).size());
     else
-      return static_cast<cpu::Word>(db::Code(this, static_cast<Bug*>(target)->memory_id()).data().size());
+      *value = static_cast<cpu::Word>(static_cast<Bug*>(target)->mem.size());
+    return ActionSuccess;
 
   case InfoEnergy: // Only eggs and bugs
     if (target->type == ElementEgg)
-      return static_cast<cpu::Word>(static_cast<Egg*>(target)->energy());
+      *value = static_cast<cpu::Word>(static_cast<Egg*>(target)->energy());
     else if (target->type == ElementBug)
-      return static_cast<cpu::Word>(static_cast<Bug*>(target)->energy());
+      *value = static_cast<cpu::Word>(static_cast<Bug*>(target)->energy());
     else
-      throw EXCEPTION(ActionError, "Food has no energy");
+      // Food has no energy
+      return ActionFailure;
+    return ActionSuccess;
 
   case InfoPosition: // Every element
     *ypos = static_cast<cpu::Word>(front.y);
-    return static_cast<cpu::Word>(front.x);
+    *value = static_cast<cpu::Word>(front.x);
+    return ActionSuccess;
 
   case InfoOrientation: // Only eggs and bugs
     if (target->type == ElementEgg)
-      return static_cast<cpu::Word>(static_cast<Egg*>(target)->orientation());
+      *value = static_cast<cpu::Word>(static_cast<Egg*>(target)->orientation());
     else if (target->type == ElementBug)
-      return static_cast<cpu::Word>(static_cast<Bug*>(target)->orientation());
+      *value = static_cast<cpu::Word>(static_cast<Bug*>(target)->orientation());
     else
-      throw EXCEPTION(ActionError, "Food has no orientation");
+      // Food has no orientation
+      return ActionFailure;
+    return ActionSuccess;
 
   default:
-    throw EXCEPTION(ActionError, boost::str(boost::format(\
-"Type of information (0x%04x) unknown")
-                                            % info));
+    // Type of information unknown
+    return ActionFailure;
   }
 }
 
@@ -425,9 +567,9 @@ There is nothing in (%1%, %2%)")
  * Move a bug.
  * @param bug Bug that executes the action.
  * @param movement Type of movement.
- * @exception ActionError if something fails.
+ * @return the status of the action.
  */
-void SimpleWorld::move(Bug* bug, Movement movement)
+ActionStatus SimpleWorld::move(Bug* bug, Movement movement)
 {
 #ifdef DEBUG
   std::cout << boost::format("Bug %1% doing action move")
@@ -435,28 +577,31 @@ void SimpleWorld::move(Bug* bug, Movement movement)
     << std::endl;
 #endif // DEBUG
 
-  this->substract_energy(bug, this->env_->energy_move());
+  if (not this->substract_energy(bug, this->env_->energy_move()))
+    return ActionDeath;
 
-  try {
-    Position current(bug->position_x(), bug->position_y());
-    Position front = this->front(bug);
-    this->world_->move(current, front);
-    if (current.x != front.x)
-      bug->position_x(front.x);
-    else
-      bug->position_y(front.y);
-  } catch (const Exception& e) {
-    throw EXCEPTION(ActionError, e.info);
-  }
+  Position current(bug->position_x(), bug->position_y());
+  Position front = this->front(bug);
+  // The position is used
+  if (this->world_->try_get(front) != NULL)
+    return ActionFailure;
+
+  this->world_->move(current, front);
+  if (current.x != front.x)
+    bug->position_x(front.x);
+  else
+    bug->position_y(front.y);
+
+  return ActionSuccess;
 }
 
 /**
  * Turn a bug.
  * @param bug Bug that executes the action.
  * @param turn Type of turn.
- * @exception ActionError if something fails.
+ * @return the status of the action.
  */
-void SimpleWorld::turn(Bug* bug, Turn turn)
+ActionStatus SimpleWorld::turn(Bug* bug, Turn turn)
 {
 #ifdef DEBUG
   std::cout << boost::format("Bug %1% doing action turn")
@@ -464,22 +609,21 @@ void SimpleWorld::turn(Bug* bug, Turn turn)
     << std::endl;
 #endif // DEBUG
 
-  this->substract_energy(bug, this->env_->energy_turn());
+  if (not this->substract_energy(bug, this->env_->energy_turn()))
+    return ActionDeath;
 
-  try {
-    bug->orientation(::simpleworld::turn(bug->orientation(), turn));
-  } catch (const Exception& e) {
-    throw EXCEPTION(ActionError, e.info);
-  }
+  bug->orientation(::simpleworld::turn(bug->orientation(), turn));
+
+  return ActionSuccess;
 }
 
 /**
  * Attack.
  * @param bug Bug that executes the action.
  * @param energy Energy used in the attack.
- * @exception ActionError if something fails.
+ * @return the status of the action.
  */
-void SimpleWorld::attack(Bug* bug, Energy energy)
+ActionStatus SimpleWorld::attack(Bug* bug, Energy energy)
 {
 #ifdef DEBUG
   std::cout << boost::format("Bug %1% doing action attack")
@@ -487,62 +631,51 @@ void SimpleWorld::attack(Bug* bug, Energy energy)
     << std::endl;
 #endif // DEBUG
 
-  this->substract_energy(bug, this->env_->energy_attack());
+  if (not this->substract_energy(bug, this->env_->energy_attack()))
+    return ActionDeath;
 
   // search the target of the attack
-  Position front = this->front(bug);
-  Element* target;
-  try {
-    target = this->world_->get(front);
-  } catch (const WorldError& e) {
-    throw EXCEPTION(ActionError, boost::str(boost::format("\
-There is nothing in (%1%, %2%)")
-                                            % front.x
-                                            % front.y));
-  }
-  // ElementNothing is not a valid type, it's only send to bugs to inform
-  // them that there is nothing in the World
-  assert(target->type != ElementNothing);
-
-  if ((target->type != ElementBug and target->type != ElementEgg))
-    throw EXCEPTION(ActionError, boost::str(boost::format("\
-There is not a egg/bug in (%1%, %2%)")
-                                            % front.x
-                                            % front.y));
+  Element* target = this->world_->try_get(this->front(bug));
+  // There is not a egg/bug in front of the bug
+  if (target == NULL or
+      (target->type != ElementBug and target->type != ElementEgg))
+    return ActionFailure;
 
   // attack the target
   if (target->type == ElementBug) {
     Bug* bug_target = dynamic_cast<Bug*>(target);
-    try {
-      this->substract_energy(bug_target,
-                             energy * this->env_->attack_multiplier());
-      bug_target->attacked();
-    } catch (const BugDeath& e) {
+    if (this->substract_energy(bug_target,
+                               energy * this->env_->attack_multiplier())) {
+      if (not bug_target->attacked())
+        // the interrupt can't be thrown (critical error in the CPU)
+        this->kill(bug_target);
+      else if (bug_target->action_time_null())
+        this->wake(bug_target);
+    } else
       // the bug is death
       this->kill(bug_target, bug->id());
-    }
   } else {
     Egg* egg_target = dynamic_cast<Egg*>(target);
-    try {
-      this->substract_energy(egg_target,
-                             energy * this->env_->attack_multiplier());
-    } catch (const BugDeath& e) {
+    if (not this->substract_energy(egg_target,
+                                   energy * this->env_->attack_multiplier()))
       // the egg is death
       this->kill(egg_target, bug->id());
-    }
   }
 
   // substract the energy of the attack to the bug
-  this->substract_energy(bug, energy);
+  if (not this->substract_energy(bug, energy))
+    return ActionDeath;
+
+  return ActionSuccess;
 }
 
 /**
  * Eat what is in front of the bug.
  * @param bug Bug that executes the action.
- * @return The energy eaten.
- * @exception ActionError if something fails.
+ * @param energy Where to save the energy eaten.
+ * @return the status of the action.
  */
-Energy SimpleWorld::eat(Bug* bug)
+ActionStatus SimpleWorld::eat(Bug* bug, Energy* energy)
 {
 #ifdef DEBUG
   std::cout << boost::format("Bug %1% doing action eat")
@@ -550,53 +683,44 @@ Energy SimpleWorld::eat(Bug* bug)
     << std::endl;
 #endif // DEBUG
 
-  this->substract_energy(bug, this->env_->energy_eat());
+  if (not this->substract_energy(bug, this->env_->energy_eat()))
+    return ActionDeath;
 
   Position front = this->front(bug);
-  Element* target;
-  try {
-    target = this->world_->get(front);
-  } catch (const WorldError& e) {
-    throw EXCEPTION(ActionError, boost::str(boost::format("\
-There is nothing in (%1%, %2%)")
-                                            % front.x
-                                            % front.y));
-  }
+  Element* target = this->world_->try_get(front);
+  // There is nothing to eat in front of the bug
+  if (target == NULL or target->type == ElementBug)
+    return ActionFailure;
   // ElementNothing is not a valid type, it's only send to bugs to inform
   // them that there is nothing in the World
   assert(target->type != ElementNothing);
 
-  Energy energy;
   if (target->type == ElementFood) {
     Food* food_target = dynamic_cast<Food*>(target);
-    energy = food_target->size();
-    bug->energy(bug->energy() + energy);
+    *energy = food_target->size();
+    bug->energy(bug->energy() + *energy);
 
     db::World::remove(this, food_target->world_id());
     db::Food::remove(this, food_target->id());
     this->world_->remove(front);
     this->foods_.remove(food_target);
-    delete food_target;
-  } else if (target->type == ElementEgg) {
+    this->food_pool_.destroy(food_target);
+  } else {
     Egg* egg_target = dynamic_cast<Egg*>(target);
-    energy = db::Code(this, egg_target->memory_id()).data().size();
+    *energy = db::Code(this, egg_target->memory_id()).size();
     this->kill(egg_target, bug->id());
-  } else
-    throw EXCEPTION(ActionError, boost::str(boost::format("\
-There is nothing to eat in (%1%, %2%")
-                                            % front.x
-                                            % front.y));
+  }
 
-  return energy;
+  return ActionSuccess;
 }
 
 /**
  * Create a egg in front of the bug.
  * @param bug Bug that executes the action.
  * @param energy Energy transfered to the egg.
- * @exception ActionError if something fails.
+ * @return the status of the action.
  */
-void SimpleWorld::egg(Bug* bug, Energy energy)
+ActionStatus SimpleWorld::egg(Bug* bug, Energy energy)
 {
 #ifdef DEBUG
   std::cout << boost::format("Bug %1% doing action egg")
@@ -604,17 +728,17 @@ void SimpleWorld::egg(Bug* bug, Energy energy)
     << std::endl;
 #endif // DEBUG
 
-  this->substract_energy(bug, this->env_->energy_egg());
+  if (not this->substract_energy(bug, this->env_->energy_egg()))
+    return ActionDeath;
 
+  // Trying to create a egg without energy
   if (energy == 0)
-    throw EXCEPTION(ActionError, "Trying to create a egg without energy");
+    return ActionFailure;
 
+  // The position is used
   Position front = this->front(bug);
-  if (this->world_->used(front))
-    throw EXCEPTION(ActionError, boost::str(boost::format("\
-Position used (%1%, %2%)")
-                                            % front.x
-                                            % front.y));
+  if (this->world_->try_get(front) != NULL)
+    return ActionFailure;
 
 
   // savepoint
@@ -626,37 +750,43 @@ Position used (%1%, %2%)")
                                       ::simpleworld::turn(::simpleworld::turn(bug->orientation(),
                                                                               TurnLeft),
                                                           TurnLeft));
-  db::ID code_id = db::Code::insert(this, bug->memory_id());
+  // the code is shared with the father if it's the same
+  boost::scoped_array<Uint8> code(new Uint8[bug->mem.size()]);
+  bug->mem.read(code.get(), bug->mem.size());
+  db::ID code_id = db::Code::insert(this, code.get(), bug->mem.size());
   db::ID egg_id = db::Bug::insert(this, code_id, this->env_->time(), bug->id());
   MutationsList list;
   db::ID memory_id;
-  if (mutate(&list, this, &memory_id, bug->memory_id(), 
-             this->env_->mutations_probability()))
+  Random random(this->env_->seed(), egg_id, this->env_->time(),
+                RandomMutation);
+  if (mutate(&list, this, &memory_id, bug->mem,
+             this->env_->mutations_probability(), &random))
     update_mutations(&list, this, egg_id, this->env_->time());
   else
-    memory_id = db::Code::insert(this, code_id);
+    memory_id = code_id;
   db::Egg::insert(this, egg_id, world_id, std::min(bug->energy(), energy),
                   memory_id);
-  Egg* ptr = new Egg(this, egg_id);
+  Egg* ptr = this->egg_pool_.construct(this, egg_id);
 
-  try {
-    // Substracts the size of the egg
-    this->substract_energy(bug,
-                           db::Code(this, db::Egg(this, egg_id).memory_id()).data().size());
-  } catch (const BugDeath& e) {
+  // Substracts the size of the egg
+  if (not this->substract_energy(bug, db::Code(this, memory_id).size())) {
     transaction.rollback("egg;");
+    this->egg_pool_.destroy(ptr);
 
-    throw;
+    return ActionDeath;
   }
 
-  this->eggs_.push_back(ptr);
+  this->eggs_.insert(ptr);
   this->world_->add(ptr, Position(ptr->position_x(), ptr->position_y()));
+  this->schedule(ptr);
 
   // Substracts the energy of the egg
-  this->substract_energy(bug, energy);
+  bool alive = this->substract_energy(bug, energy);
 
   // savepoint
   transaction.release("egg;");
+
+  return alive ? ActionSuccess : ActionDeath;
 }
 
 
@@ -673,45 +803,230 @@ Position SimpleWorld::front(Bug* bug)
 }
 
 
+/**
+ * Read the environment, the spawns and the resources.
+ * They are kept in memory until other connection changes the database.
+ * @exception DBException if there is a error in the database.
+ */
+void SimpleWorld::env_load()
+{
+  delete this->env_;
+  this->env_ = new db::Environment(this, this->last_environment());
+
+  std::vector<db::Spawn*>::iterator spawn = this->spawns_.begin();
+  while (spawn != this->spawns_.end()) {
+    delete (*spawn);
+    ++spawn;
+  }
+  this->spawns_.clear();
+
+  std::vector<db::Resource*>::iterator resource = this->resources_.begin();
+  while (resource != this->resources_.end()) {
+    delete (*resource);
+    ++resource;
+  }
+  this->resources_.clear();
+
+  std::vector< db::ID > ids;
+
+  ids = this->spawns();
+  for (std::vector< db::ID >::const_iterator iter = ids.begin();
+       iter != ids.end();
+       ++iter) {
+    db::Spawn* ptr = new db::Spawn(this, *iter);
+    this->spawns_.push_back(ptr);
+  }
+
+  ids = this->resources();
+  for (std::vector< db::ID >::const_iterator iter = ids.begin();
+       iter != ids.end();
+       ++iter) {
+    db::Resource* ptr = new db::Resource(this, *iter);
+    this->resources_.push_back(ptr);
+  }
+
+  this->data_version_ = this->data_version();
+}
+
+/**
+ * Schedule the events of the elements, the spawns and the resources.
+ * It must be called after the environment is read.
+ */
+void SimpleWorld::events_load()
+{
+  Time now = this->env_->time();
+
+  this->spawn_events_.clear(now);
+  for (Uint32 i = 0; i < this->spawns_.size(); i++)
+    if (this->spawns_[i]->frequency() != 0)
+      this->spawn_events_.schedule(next_cycle(1, this->spawns_[i]->frequency(),
+                                              now),
+                                   i);
+
+  this->resource_events_.clear(now);
+  for (Uint32 i = 0; i < this->resources_.size(); i++)
+    if (this->resources_[i]->frequency() != 0)
+      this->resource_events_.schedule(next_cycle(1,
+                                                 this->resources_[i]->frequency(),
+                                                 now),
+                                      i);
+
+  this->birth_events_.clear(now);
+  this->mutation_events_.clear(now);
+  this->laziness_events_.clear(now);
+  this->rot_events_.clear(now);
+  this->wake_events_.clear(now);
+  this->running_.clear();
+
+  for (SlotMap<Food>::iterator food = this->foods_.begin();
+       food != this->foods_.end();
+       ++food)
+    this->schedule(*food);
+  for (SlotMap<Egg>::iterator egg = this->eggs_.begin();
+       egg != this->eggs_.end();
+       ++egg)
+    this->schedule(*egg);
+  for (SlotMap<Bug>::iterator bug = this->bugs_.begin();
+       bug != this->bugs_.end();
+       ++bug) {
+    this->schedule(*bug);
+
+    // the bugs wait again when they find that the action is not finished
+    (*bug)->waiting = false;
+    this->running_.insert(std::make_pair((*bug)->sequence, *bug));
+  }
+}
+
+/**
+ * Schedule the birth of a egg.
+ * @param egg The egg.
+ */
+void SimpleWorld::schedule(Egg* egg)
+{
+  this->birth_events_.schedule(egg->creation() + this->env_->time_birth(),
+                               egg->slot);
+}
+
+/**
+ * Schedule the next mutation and the next laziness check of a bug.
+ * @param bug The bug.
+ */
+void SimpleWorld::schedule(Bug* bug)
+{
+  // check that the periods are not zero to prevent a float point exception
+  Time mutate = this->env_->time_mutate();
+  if (mutate != 0)
+    this->mutation_events_.schedule(next_cycle(bug->birth() + mutate, mutate,
+                                               this->mutation_events_.now()),
+                                    bug->slot);
+
+  Time laziness = this->env_->time_laziness();
+  if (laziness != 0)
+    this->laziness_events_.schedule(next_cycle(last_action(bug) + laziness,
+                                               laziness,
+                                               this->laziness_events_.now()),
+                                    bug->slot);
+}
+
+/**
+ * Schedule the next rot of the food.
+ * @param food The food.
+ */
+void SimpleWorld::schedule(Food* food)
+{
+  Time rot = this->env_->time_rot();
+  if (rot != 0)
+    this->rot_events_.schedule(next_cycle(food->time() + rot, rot,
+                                          this->rot_events_.now()),
+                               food->slot);
+}
+
+/**
+ * Stop running a bug until its action can be finished.
+ * @param bug The bug.
+ */
+void SimpleWorld::wait(Bug* bug)
+{
+  bug->waiting = true;
+  this->running_.erase(bug->sequence);
+  this->wake_events_.schedule(bug->action_time(), bug->slot);
+}
+
+/**
+ * Run again a bug that was waiting for its action.
+ * @param bug The bug.
+ */
+void SimpleWorld::wake(Bug* bug)
+{
+  if (not bug->waiting)
+    return;
+
+  bug->waiting = false;
+  this->running_.insert(std::make_pair(bug->sequence, bug));
+}
+
+
 /**
  * Spawn new eggs.
  */
 void SimpleWorld::spawn_eggs()
 {
+  // the spawns are checked before the time is updated, so they are
+  // scheduled in the cycle after the one they were checked
+  Time cycle = this->env_->time() + 1;
+  std::vector<Uint32> due;
+  this->spawn_events_.advance(cycle, &due);
+  std::sort(due.begin(), due.end());
+
+  // the next spawns are scheduled first because the World could be full
+  for (std::vector<Uint32>::const_iterator index = due.begin();
+       index != due.end();
+       ++index)
+    this->spawn_events_.schedule(next_cycle(1,
+                                            this->spawns_[*index]->frequency(),
+                                            cycle),
+                                 *index);
+
   try {
-    for (std::list<db::Spawn*>::iterator spawn = this->spawns_.begin();
-         spawn != this->spawns_.end();
-         ++spawn)
-      if (this->env_->time() % (*spawn)->frequency() == 0) {
-        Position start((*spawn)->start_x(), (*spawn)->start_y());
-        Position end((*spawn)->end_x(), (*spawn)->end_y());
-        Uint16 num_elements = this->world_->num_elements(start, end,
-                                                         ElementBug);
-        Uint16 max = (*spawn)->max();
-        if (num_elements < max) {
-          Energy energy = (*spawn)->energy();
-
-          for (Uint16 i = 0; i < max - num_elements; i++) {
-            db::ID code_id = (*spawn)->code_id();
-            db::ID id = db::Bug::insert(this, code_id, this->env_->time());
-            db::ID memory_id;
-            MutationsList list;
-            if (mutate(&list, this, &memory_id, code_id,
-                       this->env_->mutations_probability()))
-              update_mutations(&list, this, id, this->env_->time());
-            else
-              memory_id = db::Code::insert(this, code_id);
-            Position position = this->world_->unused_position(start, end);
-            db::ID world_id = db::World::insert(this, position.x, position.y,
-                                                World::random_orientation());
-            db::Egg::insert(this, id, world_id, energy, memory_id);
-
-            Egg* egg = new Egg(this, id);
-            this->eggs_.push_back(egg);
-            this->world_->add(egg, position);
-          }
+    for (std::vector<Uint32>::const_iterator index = due.begin();
+         index != due.end();
+         ++index) {
+      db::Spawn* spawn = this->spawns_[*index];
+      Position start(spawn->start_x(), spawn->start_y());
+      Position end(spawn->end_x(), spawn->end_y());
+      Uint32 num_elements = this->world_->num_elements(start, end,
+                                                       ElementBug);
+      Uint32 max = spawn->max();
+      if (num_elements < max) {
+        Energy energy = spawn->energy();
+        Random random(this->env_->seed(), spawn->id(), cycle, RandomSpawn);
+
+        for (Uint32 i = 0; i < max - num_elements; i++) {
+          db::ID code_id = spawn->code_id();
+          db::ID id = db::Bug::insert(this, code_id, this->env_->time());
+          db::ID memory_id;
+          MutationsList list;
+          Random mutation(this->env_->seed(), id, this->env_->time(),
+                          RandomMutation);
+          if (mutate(&list, this, &memory_id, code_id,
+                     this->env_->mutations_probability(), &mutation))
+            update_mutations(&list, this, id, this->env_->time());
+          else
+            memory_id = code_id;
+          Position position = this->world_->unused_position(start, end,
+                                                            &random);
+          db::ID world_id =
+            db::World::insert(this, position.x, position.y,
+                              World::random_orientation(&random));
+          db::Egg::insert(this, id, world_id, energy, memory_id);
+
+          Egg* egg = this->egg_pool_.construct(this, id);
+          this->eggs_.insert(egg);
+          this->world_->add(egg, position);
+          this->schedule(egg);
         }
       }
+    }
   } catch (const WorldError& e) {
     // the World is full
   }
@@ -724,30 +1039,48 @@ void SimpleWorld::spawn_food()
 {
   Time now = this->env_->time();
 
+  // the resources are checked before the time is updated, so they are
+  // scheduled in the cycle after the one they were checked
+  std::vector<Uint32> due;
+  this->resource_events_.advance(now + 1, &due);
+  std::sort(due.begin(), due.end());
+
+  // the next resources are scheduled first because the World could be full
+  for (std::vector<Uint32>::const_iterator index = due.begin();
+       index != due.end();
+       ++index)
+    this->resource_events_.schedule(next_cycle(1,
+                                               this->resources_[*index]->frequency(),
+                                               now + 1),
+                                    *index);
+
   try {
-    for (std::list<db::Resource*>::iterator resource =
-           this->resources_.begin();
-         resource != this->resources_.end();
-         ++resource)
-      if (now % (*resource)->frequency() == 0) {
-        Position start((*resource)->start_x(), (*resource)->start_y());
-        Position end((*resource)->end_x(), (*resource)->end_y());
-        Uint16 num_elements = this->world_->num_elements(start, end,
-                                                         ElementFood);
-        Uint16 max = (*resource)->max();
-        Energy size = (*resource)->size();
-        if (num_elements < max) {
-          for (Uint16 i = 0; i < max - num_elements; i++) {
-            Position position = this->world_->unused_position(start, end);
-            db::ID world_id = db::World::insert(this, position.x, position.y);
-            db::ID id = db::Food::insert(this, now, world_id, size);
-
-            Food* food = new Food(this, id);
-            this->foods_.push_back(food);
-            this->world_->add(food, position);
-          }
+    for (std::vector<Uint32>::const_iterator index = due.begin();
+         index != due.end();
+         ++index) {
+      db::Resource* resource = this->resources_[*index];
+      Position start(resource->start_x(), resource->start_y());
+      Position end(resource->end_x(), resource->end_y());
+      Uint32 num_elements = this->world_->num_elements(start, end,
+                                                       ElementFood);
+      Uint32 max = resource->max();
+      Energy size = resource->size();
+      if (num_elements < max) {
+        Random random(this->env_->seed(), resource->id(), now + 1,
+                      RandomResource);
+        for (Uint32 i = 0; i < max - num_elements; i++) {
+          Position position = this->world_->unused_position(start, end,
+                                                            &random);
+          db::ID world_id = db::World::insert(this, position.x, position.y);
+          db::ID id = db::Food::insert(this, now, world_id, size);
+
+          Food* food = this->food_pool_.construct(this, id);
+          this->foods_.insert(food);
+          this->world_->add(food, position);
+          this->schedule(food);
         }
       }
+    }
   } catch (const WorldError& e) {
     // the World is full
   }
@@ -758,13 +1091,14 @@ void SimpleWorld::spawn_food()
  */
 void SimpleWorld::eggs_birth()
 {
-  // check for the birthday of each egg
-  std::list<Egg*> eggs = this->eggs_;
-  for (std::list<Egg*>::iterator egg = eggs.begin();
+  std::vector<SlotHandle> due;
+  this->birth_events_.advance(this->env_->time(), &due);
+
+  std::vector<Egg*> eggs = due_elements(this->eggs_, due);
+  for (std::vector<Egg*>::const_iterator egg = eggs.begin();
        egg != eggs.end();
        ++egg)
-    if (((*egg)->creation() + this->env_->time_birth()) <= this->env_->time())
-      this->birth(*egg);
+    this->birth(*egg);
 }
 
 /**
@@ -772,28 +1106,36 @@ void SimpleWorld::eggs_birth()
  */
 void SimpleWorld::bugs_mutate()
 {
-  // check that time_mutate is not zero to prevent a float point exception
-  if (this->env_->time_mutate() == 0)
-    return;
+  Time now = this->env_->time();
+  std::vector<SlotHandle> due;
+  this->mutation_events_.advance(now, &due);
 
-  // check if the bug is old enough
-  for (std::list<Bug*>::iterator bug = this->bugs_.begin();
-       bug != this->bugs_.end();
+  std::vector<Bug*> bugs = due_elements(this->bugs_, due);
+  for (std::vector<Bug*>::const_iterator bug = bugs.begin();
+       bug != bugs.end();
        ++bug) {
-    Time age = this->env_->time() - (*bug)->birth();
-    if ((age > 0) and (age % this->env_->time_mutate() == 0)) {
-      MutationsList list;
-      if (mutate(&list, this, (*bug)->memory_id(),
-          this->env_->mutations_probability())) {
-        update_mutations(&list, this, (*bug)->id(), this->env_->time());
-        (*bug)->mutated();
+    this->mutation_events_.schedule(now + this->env_->time_mutate(),
+                                    (*bug)->slot);
+
+    // the code is mutated in memory and written when the bug is saved
+    MutationsList list;
+    Random random(this->env_->seed(), (*bug)->id(), now, RandomMutation);
+    if (mutate(&list, &(*bug)->mem, this->env_->mutations_probability(),
+               &random)) {
+      update_mutations(&list, this, (*bug)->id(), this->env_->time());
+      if (not (*bug)->mutated()) {
+        // the interrupt can't be thrown (critical error in the CPU)
+        this->kill(*bug);
+        continue;
+      }
+      // the code of the action could have changed
+      this->wake(*bug);
 
 #ifdef DEBUG
-        std::cout << boost::format("The code of bug %1% has been mutated")
-                     % (*bug)->id()
-                  << std::endl;
+      std::cout << boost::format("The code of bug %1% has been mutated")
+                   % (*bug)->id()
+                << std::endl;
 #endif // DEBUG
-      }
     }
   }
 }
@@ -804,13 +1146,14 @@ void SimpleWorld::bugs_mutate()
 void SimpleWorld::bugs_timer()
 {
   // throw the Timer Interrupt in each bug
-  std::list<Bug*> bugs = this->bugs_;
-  for (std::list<Bug*>::iterator bug = bugs.begin();
-       bug != bugs.end();
+  for (SlotMap<Bug>::iterator bug = this->bugs_.begin();
+       bug != this->bugs_.end();
        ++bug) {
     try {
       // throw the interrupt
       (*bug)->cpu.timer_interrupt();
+      if ((*bug)->action_time_null())
+        this->wake(*bug);
     } catch (const cpu::CPUException& e) {
       // some critical error
       this->kill(*bug);
@@ -820,36 +1163,34 @@ void SimpleWorld::bugs_timer()
 
 /**
  * Substract some energy to the egg.
- * If the egg has not enough energy, it's converted in food.
+ * If the egg has not enough energy, it must be converted in food.
  * @param egg The egg.
  * @param energy The energy.
- * @exception BugDeath If the bug die.
+ * @return true if the egg is alive, false if it dies.
  */
-void SimpleWorld::substract_energy(Egg* egg, Energy energy)
+bool SimpleWorld::substract_energy(Egg* egg, Energy energy)
 {
   if (egg->energy() <= energy)
-    throw EXCEPTION(BugDeath, boost::str(boost::format("\
-Egg %1% is death")
-                                         % egg->id()));
+    return false;
 
   egg->energy(egg->energy() - energy);
+  return true;
 }
 
 /**
  * Substract some energy to the bug.
- * If the bug has not enough energy, it's converted in food.
+ * If the bug has not enough energy, it must be converted in food.
  * @param bug The bug.
  * @param energy The energy.
- * @exception BugDeath If the bug die.
+ * @return true if the bug is alive, false if it dies.
  */
-void SimpleWorld::substract_energy(Bug* bug, Energy energy)
+bool SimpleWorld::substract_energy(Bug* bug, Energy energy)
 {
   if (bug->energy() <= energy)
-    throw EXCEPTION(BugDeath, boost::str(boost::format("\
-Bug %1% is death")
-                                         % bug->id()));
+    return false;
 
   bug->energy(bug->energy() - energy);
+  return true;
 }
 
 /**
@@ -859,13 +1200,17 @@ Bug %1% is death")
 void SimpleWorld::birth(Egg* egg)
 {
   // Convert the egg into a bug
+  egg->save();
   db::ID id = db::AliveBug::insert(this, egg, this->env_->time());
-  Bug* bug = new Bug(this, id);
+  Bug* bug = this->bug_pool_.construct(this, id);
 
   Position position(bug->position_x(), bug->position_y());
   this->world_->remove(position);
   this->world_->add(bug, position);
-  this->bugs_.push_back(bug);
+  bug->sequence = this->sequence_++;
+  this->bugs_.insert(bug);
+  this->running_.insert(std::make_pair(bug->sequence, bug));
+  this->schedule(bug);
 #ifdef DEBUG
   std::cout << boost::str(boost::format("\
 Bug[%1%] born")
@@ -873,7 +1218,7 @@ Bug[%1%] born")
             << std::endl;
 #endif // DEBUG
   this->eggs_.remove(egg);
-  delete egg;
+  this->egg_pool_.destroy(egg);
 }
 
 /**
@@ -882,15 +1227,19 @@ Bug[%1%] born")
  */
 void SimpleWorld::kill(Egg* egg)
 {
+  // The food uses the same position in the World
+  egg->save();
+
   // Convert the egg in food
   Time now = this->env_->time();
   db::ID id = db::Food::insert(this, now, egg->world_id(),
-                               db::Code(this, egg->memory_id()).data().size());
+                               db::Code(this, egg->memory_id()).size());
   db::DeadBug::insert(this, egg, now);
 
-  Food* food = new Food(this, id);
+  Food* food = this->food_pool_.construct(this, id);
   Position position(food->position_x(), food->position_y());
-  this->foods_.push_back(food);
+  this->foods_.insert(food);
+  this->schedule(food);
   this->world_->remove(position);
   this->world_->add(food, position);
 #ifdef DEBUG
@@ -911,7 +1260,7 @@ Egg[%1%] died")
                           % egg->id())
             << std::endl;
 #endif // DEBUG
-  delete egg;
+  this->egg_pool_.destroy(egg);
 }
 
 /**
@@ -921,15 +1270,19 @@ Egg[%1%] died")
  */
 void SimpleWorld::kill(Egg* egg, db::ID killer_id)
 {
+  // The food uses the same position in the World
+  egg->save();
+
   // Convert the egg in food
   Time now = this->env_->time();
   db::ID id = db::Food::insert(this, now, egg->world_id(),
-                               db::Code(this, egg->memory_id()).data().size());
+                               db::Code(this, egg->memory_id()).size());
   db::DeadBug::insert(this, egg, now, killer_id);
 
-  Food* food = new Food(this, id);
+  Food* food = this->food_pool_.construct(this, id);
   Position position(food->position_x(), food->position_y());
-  this->foods_.push_back(food);
+  this->foods_.insert(food);
+  this->schedule(food);
   this->world_->remove(position);
   this->world_->add(food, position);
 #ifdef DEBUG
@@ -950,7 +1303,7 @@ Egg[%1%] died")
                           % egg->id())
             << std::endl;
 #endif // DEBUG
-  delete egg;
+  this->egg_pool_.destroy(egg);
 }
 
 /**
@@ -959,15 +1312,19 @@ Egg[%1%] died")
  */
 void SimpleWorld::kill(Bug* bug)
 {
+  // The food uses the same position in the World
+  bug->save();
+
   // Convert the bug in food
   Time now = this->env_->time();
   db::ID id = db::Food::insert(this, now, bug->world_id(),
-                               db::Code(this, bug->memory_id()).data().size());
+                               bug->mem.size());
   db::DeadBug::insert(this, bug, now);
 
-  Food* food = new Food(this, id);
+  Food* food = this->food_pool_.construct(this, id);
   Position position(food->position_x(), food->position_y());
-  this->foods_.push_back(food);
+  this->foods_.insert(food);
+  this->schedule(food);
   this->world_->remove(position);
   this->world_->add(food, position);
 #ifdef DEBUG
@@ -982,13 +1339,14 @@ Food[%1%] added at (%2%, %3%) with a size of %4%")
 
   // Remove the dead bug
   this->bugs_.remove(bug);
+  this->running_.erase(bug->sequence);
 #ifdef DEBUG
   std::cout << boost::str(boost::format("\
 Bug[%1%] died")
                           % bug->id())
             << std::endl;
 #endif // DEBUG
-  delete bug;
+  this->bug_pool_.destroy(bug);
 }
 
 /**
@@ -998,15 +1356,19 @@ Bug[%1%] died")
  */
 void SimpleWorld::kill(Bug* bug, db::ID killer_id)
 {
+  // The food uses the same position in the World
+  bug->save();
+
   // Convert the bug in food
   Time now = this->env_->time();
   db::ID id = db::Food::insert(this, now, bug->world_id(),
-                               db::Code(this, bug->memory_id()).data().size());
+                               bug->mem.size());
   db::DeadBug::insert(this, bug, now, killer_id);
 
-  Food* food = new Food(this, id);
+  Food* food = this->food_pool_.construct(this, id);
   Position position(food->position_x(), food->position_y());
-  this->foods_.push_back(food);
+  this->foods_.insert(food);
+  this->schedule(food);
   this->world_->remove(position);
   this->world_->add(food, position);
 #ifdef DEBUG
@@ -1021,13 +1383,14 @@ Food[%1%] added at (%2%, %3%) with a size of %4%")
 
   // Remove the dead bug
   this->bugs_.remove(bug);
+  this->running_.erase(bug->sequence);
 #ifdef DEBUG
   std::cout << boost::str(boost::format("\
 Bug[%1%] died")
                           % bug->id())
             << std::endl;
 #endif // DEBUG
-  delete bug;
+  this->bug_pool_.destroy(bug);
 }
 
 /**
@@ -1035,29 +1398,63 @@ Bug[%1%] died")
  */
 void SimpleWorld::bugs_run()
 {
-  // execute a instruction in each bug
-  std::list<Bug*> bugs = this->bugs_;
-  for (std::list<Bug*>::iterator bug = bugs.begin();
-       bug != bugs.end();
-       ++bug) {
-    // check if the bug is alive, a bug could have killed it
-    if (std::find(this->bugs_.begin(), this->bugs_.end(), *bug) ==
-        this->bugs_.end())
-      continue;
+  // wake the bugs whose action can be finished in this cycle
+  Time now = this->env_->time();
+  std::vector<SlotHandle> due;
+  this->wake_events_.advance(now, &due);
+  for (std::vector<SlotHandle>::const_iterator handle = due.begin();
+       handle != due.end();
+       ++handle) {
+    // the bug could have been woken before and be waiting for other action
+    Bug* bug = this->bugs_.get(*handle);
+    if (bug != NULL and bug->waiting and bug->action_time() <= now)
+      this->wake(bug);
+  }
+
+  // the bugs that are not finishing a action are executed in parallel until
+  // they need the World, the rest of the cycle is executed below in order
+  // and, if a bug is changed by other before, its cycle is executed again
+  if (this->pool_->threads() > 1) {
+    this->speculative_.clear();
+    for (std::map<Uint64, Bug*>::const_iterator bug = this->running_.begin();
+         bug != this->running_.end();
+         ++bug)
+      if (bug->second->action_time_null())
+        this->speculative_.push_back(bug->second);
+
+    this->pool_->run(this->speculative_.size(),
+                     boost::bind(speculate, boost::cref(this->speculative_),
+                                 _1));
+  }
+
+  // execute a instruction in each bug that is not waiting
+  // the next bug is searched after each one because the bugs can be killed
+  // or woken by other bugs
+  std::map<Uint64, Bug*>::iterator iter = this->running_.begin();
+  while (iter != this->running_.end()) {
+    Uint64 sequence = iter->first;
+    Bug* bug = iter->second;
 
     try {
-      // execute 1024 instructions
-      (*bug)->cpu.execute(1024);
-    } catch (const ActionBlocked& e) {
-      // this is not a error, just a way to skip the rest of the cycles until
-      // the action can be executed
+      // execute CYCLES_BY_BUG instructions
+      if (bug->cpu.speculated())
+        bug->cpu.resume();
+      else
+        bug->cpu.execute(CYCLES_BY_BUG);
+
+      if (bug->cpu.yielded() == CPU::YieldBlocked)
+        // this is not a error, just a way to skip the rest of the cycles
+        // until the action can be executed
+        this->wait(bug);
+      else if (bug->cpu.yielded() == CPU::YieldDeath)
+        // the bug is death
+        this->kill(bug);
     } catch (const cpu::CPUException& e) {
       // some uncaught error in the CPU (CPU stopped)
-      this->kill(*bug);
-    } catch (const BugDeath& e) {
-      // the bug is death
-      this->kill(*bug);
+      this->kill(bug);
     }
+
+    iter = this->running_.upper_bound(sequence);
   }
 }
 
@@ -1066,65 +1463,87 @@ void SimpleWorld::bugs_run()
  */
 void SimpleWorld::bugs_laziness()
 {
-  // check the laziness of each bug
-  std::list<Bug*> bugs = this->bugs_;
-  for (std::list<Bug*>::iterator bug = bugs.begin();
+  Time now = this->env_->time();
+  Time laziness = this->env_->time_laziness();
+  std::vector<SlotHandle> due;
+  this->laziness_events_.advance(now, &due);
+
+  std::vector<Bug*> bugs = due_elements(this->bugs_, due);
+  for (std::vector<Bug*>::const_iterator bug = bugs.begin();
        bug != bugs.end();
        ++bug) {
-    // calculate the time since the last action
-    Time time;
-    if ((*bug)->is_null("time_last_action"))
-      time = this->env_->time() - (*bug)->birth();
-    else
-      time = this->env_->time() - (*bug)->time_last_action();
+    // the event was scheduled with the last action known then, if the bug
+    // has done other action since then it's not lazy yet
+    Time last = last_action(*bug);
+    Time next = next_cycle(last + laziness, laziness, now - 1);
+    if (next != now) {
+      this->laziness_events_.schedule(next, (*bug)->slot);
+      continue;
+    }
+    this->laziness_events_.schedule(now + laziness, (*bug)->slot);
 
-    if (time > 0 and time % this->env_->time_laziness() == 0) {
 #ifdef DEBUG
-      std::cout << boost::format("Bug %1% is lazy")
-        % (*bug)->id()
-      << std::endl;
+    std::cout << boost::format("Bug %1% is lazy")
+      % (*bug)->id()
+    << std::endl;
 #endif // DEBUG
 
-      try {
-        this->substract_energy((*bug), this->env_->energy_laziness());
-      } catch (const BugDeath& e) {
-        // the bug is death
-        this->kill(*bug);
-      }
-    }
+    if (not this->substract_energy((*bug), this->env_->energy_laziness()))
+      // the bug is death
+      this->kill(*bug);
   }
 }
 
+/**
+ * Write the state of the bugs, eggs and food that is only kept in memory.
+ * It must be called before the transaction is commited.
+ */
+void SimpleWorld::save()
+{
+  for (SlotMap<Food>::iterator food = this->foods_.begin();
+       food != this->foods_.end();
+       ++food)
+    (*food)->save();
+  for (SlotMap<Egg>::iterator egg = this->eggs_.begin();
+       egg != this->eggs_.end();
+       ++egg)
+    (*egg)->save();
+  for (SlotMap<Bug>::iterator bug = this->bugs_.begin();
+       bug != this->bugs_.end();
+       ++bug)
+    (*bug)->save();
+}
+
 /**
 * Rot the food that is getting old.
 */
 void SimpleWorld::food_rot()
 {
-  std::list<Food*> foods = this->foods_;
-  for (std::list<Food*>::iterator food = foods.begin();
+  Time now = this->env_->time();
+  std::vector<SlotHandle> due;
+  this->rot_events_.advance(now, &due);
+
+  std::vector<Food*> foods = due_elements(this->foods_, due);
+  for (std::vector<Food*>::const_iterator food = foods.begin();
        food != foods.end();
        ++food) {
-    // calculate the age of the food
-    Time age = this->env_->time() - (*food)->time();
-
-    if (age > 0 and age % this->env_->time_rot() == 0) {
 #ifdef DEBUG
-      std::cout << boost::format("Food %1% is rotting")
-        % (*food)->id()
-      << std::endl;
+    std::cout << boost::format("Food %1% is rotting")
+      % (*food)->id()
+    << std::endl;
 #endif // DEBUG
 
-      if ((*food)->size() <= this->env_->size_rot()) {
-        db::World world(this, (*food)->world_id());
-        Position position(world.position_x(), world.position_y());
-
-        db::World::remove(this, (*food)->world_id());
-        db::Food::remove(this, (*food)->id());
-        this->world_->remove(position);
-        this->foods_.remove(*food);
-        delete *food;
-      } else
-        (*food)->size((*food)->size() - this->env_->size_rot());
+    if ((*food)->size() <= this->env_->size_rot()) {
+      Position position((*food)->position_x(), (*food)->position_y());
+
+      db::World::remove(this, (*food)->world_id());
+      db::Food::remove(this, (*food)->id());
+      this->world_->remove(position);
+      this->foods_.remove(*food);
+      this->food_pool_.destroy(*food);
+    } else {
+      (*food)->size((*food)->size() - this->env_->size_rot());
+      this->rot_events_.schedule(now + this->env_->time_rot(), (*food)->slot);
     }
   }
 }
@@ -26,10 +26,18 @@
 #ifndef SIMPLEWORLD_SIMPLEWORLD_HPP
 #define SIMPLEWORLD_SIMPLEWORLD_HPP
 
-#include <list>
+#include <vector>
+#include <map>
 #include <string>
 
+#include <boost/scoped_ptr.hpp>
+
 #include <simpleworld/types.hpp>
+#include <simpleworld/pool.hpp>
+#include <simpleworld/threadpool.hpp>
+#include <simpleworld/slotmap.hpp>
+#include <simpleworld/timingwheel.hpp>
+#include <simpleworld/codecache.hpp>
 #include <simpleworld/world.hpp>
 #include <simpleworld/food.hpp>
 #include <simpleworld/egg.hpp>
@@ -57,10 +65,13 @@ class SimpleWorld: public db::DB
 public:
   /**
    * Constructor.
+   * If memory is true the World runs in a copy of the database in memory
+   * that is written to the file only in the checkpoints.
    * @param filename File name of the database.
+   * @param memory if the database is kept in memory.
    * @exception DBException if there is a error in the database.
    */
-  SimpleWorld(std::string filename);
+  SimpleWorld(std::string filename, bool memory = false);
 
   /**
    * Destructor.
@@ -71,6 +82,12 @@ public:
   const World& world() const { return *this->world_; }
   const db::Environment& env() const { return *this->env_; }
 
+  /**
+   * Cache of the code shared by the bugs.
+   * @return the cache.
+   */
+  CodeCache* code_cache() { return &this->code_cache_; }
+
   /**
    * Add a egg to the World.
    * @param energy Energy of the egg.
@@ -95,85 +112,123 @@ public:
 
   /**
    * Execute some cycles of the World.
+   * If the database is in memory, it's written to the file at the end of
+   * the first transaction after checkpoint_every() cycles since the last
+   * checkpoint and after the last cycle.
    * @param cycles Cycles to be executed.
    */
   void run(Time cycles);
 
+  /**
+   * Cycles between the checkpoints of a database in memory.
+   * The checkpoints are done at the end of the transactions, every
+   * CYCLES_BY_TRANSACTION cycles, so the cycles are rounded up to a
+   * multiple of it.
+   * @return the number of cycles, 0 if there is only a checkpoint at the
+   * end of run().
+   */
+  Time checkpoint_every() const { return this->checkpoint_every_; }
+
+  /**
+   * Change the cycles between the checkpoints of a database in memory.
+   * The checkpoints are done at the end of the transactions, every
+   * CYCLES_BY_TRANSACTION cycles, so the cycles are rounded up to a
+   * multiple of it.
+   * @param cycles number of cycles, 0 to only do a checkpoint at the end of
+   * run().
+   */
+  void checkpoint_every(Time cycles) { this->checkpoint_every_ = cycles; }
+
+  /**
+   * Number of threads used to execute the bugs.
+   * @return the number of threads, 0 if it's the number of processors.
+   */
+  unsigned threads() const { return this->threads_; }
+
+  /**
+   * Change the number of threads used to execute the bugs.
+   * The results don't depend on the number of threads.
+   * @param threads number of threads, 0 to use the number of processors.
+   */
+  void threads(unsigned threads);
+
 
   /**
    * Do nothing.
    * @param bug Bug that executes the action.
-   * @exception ActionError if something fails.
+   * @return the status of the action.
    */
-  virtual void nothing(Bug* bug);
+  virtual ActionStatus nothing(Bug* bug);
 
   /**
    * Get information about the bug itself.
    * @param bug Bug that executes the action.
    * @param info Type of information requested.
+   * @param value Where to save the information.
    * @param ypos Where to save the Y coord when requested the position.
-   * @return The information.
-   * @exception ActionError if something fails.
+   * @return the status of the action.
    */
-  virtual cpu::Word myself(Bug* bug, Info info, cpu::Word* ypos);
+  virtual ActionStatus myself(Bug* bug, Info info, cpu::Word* value,
+                              cpu::Word* ypos);
 
   /**
    * Get the type of element that is in front of the bug.
    * @param bug Bug that executes the action.
-   * @return The type of element.
-   * @exception ActionError if something fails.
+   * @param type Where to save the type of element.
+   * @return the status of the action.
    */
-  virtual ElementType detect(Bug* bug);
+  virtual ActionStatus detect(Bug* bug, ElementType* type);
 
   /**
    * Get information about the bug that is in front of the bug.
    * @param bug Bug that executes the action.
    * @param info Type of information requested.
+   * @param value Where to save the information.
    * @param ypos Where to save the Y coord when requested the position.
-   * @return The information.
-   * @exception ActionError if something fails.
+   * @return the status of the action.
    */
-  virtual cpu::Word information(Bug* bug, Info info, cpu::Word* ypos);
+  virtual ActionStatus information(Bug* bug, Info info, cpu::Word* value,
+                                   cpu::Word* ypos);
 
   /**
    * Move a bug.
    * @param bug Bug that executes the action.
    * @param movement Type of movement.
-   * @exception ActionError if something fails.
+   * @return the status of the action.
    */
-  virtual void move(Bug* bug, Movement movement);
+  virtual ActionStatus move(Bug* bug, Movement movement);
 
   /**
    * Turn a bug.
    * @param bug Bug that executes the action.
    * @param turn Type of turn.
-   * @exception ActionError if something fails.
+   * @return the status of the action.
    */
-  virtual void turn(Bug* bug, Turn turn);
+  virtual ActionStatus turn(Bug* bug, Turn turn);
 
   /**
    * Attack.
    * @param bug Bug that executes the action.
    * @param energy Energy used in the attack.
-   * @exception ActionError if something fails.
+   * @return the status of the action.
    */
-  virtual void attack(Bug* bug, Energy energy);
+  virtual ActionStatus attack(Bug* bug, Energy energy);
 
   /**
    * Eat what is in front of the bug.
    * @param bug Bug that executes the action.
-   * @return The energy eaten.
-   * @exception ActionError if something fails.
+   * @param energy Where to save the energy eaten.
+   * @return the status of the action.
    */
-  virtual Energy eat(Bug* bug);
+  virtual ActionStatus eat(Bug* bug, Energy* energy);
 
   /**
    * Create a egg in front of the bug.
    * @param bug Bug that executes the action.
    * @param energy Energy transfered to the egg.
-   * @exception ActionError if something fails.
+   * @return the status of the action.
    */
-  virtual void egg(Bug* bug, Energy energy);
+  virtual ActionStatus egg(Bug* bug, Energy energy);
 
 protected:
   /**
@@ -184,6 +239,49 @@ protected:
   Position front(Bug* bug);
 
 
+  /**
+   * Read the environment, the spawns and the resources.
+   * They are kept in memory until other connection changes the database.
+   * @exception DBException if there is a error in the database.
+   */
+  void env_load();
+
+  /**
+   * Schedule the events of the elements, the spawns and the resources.
+   * It must be called after the environment is read.
+   */
+  void events_load();
+
+  /**
+   * Schedule the birth of a egg.
+   * @param egg The egg.
+   */
+  void schedule(Egg* egg);
+
+  /**
+   * Schedule the next mutation and the next laziness check of a bug.
+   * @param bug The bug.
+   */
+  void schedule(Bug* bug);
+
+  /**
+   * Schedule the next rot of the food.
+   * @param food The food.
+   */
+  void schedule(Food* food);
+
+  /**
+   * Stop running a bug until its action can be finished.
+   * @param bug The bug.
+   */
+  void wait(Bug* bug);
+
+  /**
+   * Run again a bug that was waiting for its action.
+   * @param bug The bug.
+   */
+  void wake(Bug* bug);
+
   /**
    * Spawn new eggs.
    */
@@ -211,21 +309,21 @@ protected:
 
   /**
    * Substract some energy to the egg.
-   * If the egg has not enough energy, it's converted in food.
+   * If the egg has not enough energy, it must be converted in food.
    * @param egg The egg.
    * @param energy The energy.
-   * @exception BugDeath If the bug die.
+   * @return true if the egg is alive, false if it dies.
    */
-  void substract_energy(Egg* egg, Energy energy);
+  bool substract_energy(Egg* egg, Energy energy);
 
   /**
    * Substract some energy to the bug.
-   * If the bug has not enough energy, it's converted in food.
+   * If the bug has not enough energy, it must be converted in food.
    * @param bug The bug.
    * @param energy The energy.
-   * @exception BugDeath If the bug die.
+   * @return true if the bug is alive, false if it dies.
    */
-  void substract_energy(Bug* bug, Energy energy);
+  bool substract_energy(Bug* bug, Energy energy);
 
   /**
    * Convert a egg into a bug.
@@ -274,16 +372,42 @@ protected:
    */
   void bugs_laziness();
 
+  /**
+   * Write the state of the bugs, eggs and food that is only kept in memory.
+   * It must be called before the transaction is commited.
+   */
+  void save();
+
 
   World* world_;
   db::Environment* env_;
 
 private:
-  std::list<db::Spawn*> spawns_;
-  std::list<db::Resource*> resources_;
-  std::list<Food*> foods_;
-  std::list<Egg*> eggs_;
-  std::list<Bug*> bugs_;
+  Uint32 data_version_;
+  std::vector<db::Spawn*> spawns_;
+  std::vector<db::Resource*> resources_;
+  CodeCache code_cache_;
+  Pool<Food> food_pool_;
+  Pool<Egg> egg_pool_;
+  Pool<Bug> bug_pool_;
+  SlotMap<Food> foods_;
+  SlotMap<Egg> eggs_;
+  SlotMap<Bug> bugs_;
+  Uint64 sequence_;
+  std::map<Uint64, Bug*> running_;
+
+  TimingWheel<Uint32> spawn_events_;
+  TimingWheel<Uint32> resource_events_;
+  TimingWheel<SlotHandle> birth_events_;
+  TimingWheel<SlotHandle> mutation_events_;
+  TimingWheel<SlotHandle> laziness_events_;
+  TimingWheel<SlotHandle> rot_events_;
+  TimingWheel<SlotHandle> wake_events_;
+
+  Time checkpoint_every_;
+  unsigned threads_;
+  boost::scoped_ptr<ThreadPool> pool_;
+  std::vector<Bug*> speculative_; /**< Bugs executed in parallel */
 };
 
 }
@@ -0,0 +1,277 @@
+/**
+ * @file simpleworld/slotmap.hpp
+ * Container of elements with stable handles.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEWORLD_SLOTMAP_HPP
+#define SIMPLEWORLD_SLOTMAP_HPP
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+#include <simpleworld/ints.hpp>
+
+namespace simpleworld
+{
+
+/**
+ * Handle to a value in a SlotMap.
+ * The handle is invalidated when the value is removed, even if the slot is
+ * reused later.
+ */
+struct SlotHandle
+{
+  Uint32 index;                 /**< Index of the slot */
+  Uint32 generation;            /**< Generation of the slot */
+};
+
+
+/**
+ * Container of pointers with O(1) insertion, removal and lookup.
+ *
+ * The values are kept in a dense array in the order they were inserted.
+ * A removed value only leaves a hole in the array, so it's safe to remove
+ * values while iterating; the holes are skipped by the iterators and
+ * filled by compact().
+ *
+ * T must have a public SlotHandle member named slot, where the handle of
+ * the value is stored when it's inserted.
+ */
+template <typename T>
+class SlotMap
+{
+public:
+  typedef typename std::vector<T*>::size_type size_type;
+
+  /**
+   * Iterator over the values of a SlotMap.
+   * The values inserted while iterating are visited too.
+   */
+  class iterator
+  {
+  public:
+    /**
+     * Constructor.
+     * @param map map to iterate.
+     * @param index first index of the dense array to visit.
+     */
+    iterator(const SlotMap* map, size_type index)
+      : map_(map), index_(index)
+    { this->skip(); }
+
+    /**
+     * Get the value.
+     * @return the value.
+     */
+    T* operator *() const { return this->map_->dense_[this->index_]; }
+
+    /**
+     * Go to the next value.
+     * @return a reference to this object.
+     */
+    iterator& operator ++() { ++this->index_; this->skip(); return *this; }
+
+    /**
+     * Compare two iterators.
+     * @param other iterator to compare.
+     * @return true if they are not in the same index, else false.
+     */
+    bool operator !=(const iterator& other) const
+    { return this->index_ != other.index_; }
+
+    /**
+     * Compare two iterators.
+     * @param other iterator to compare.
+     * @return true if they are in the same index, else false.
+     */
+    bool operator ==(const iterator& other) const
+    { return this->index_ == other.index_; }
+
+  private:
+    /**
+     * Skip the holes left by the removed values.
+     */
+    void skip()
+    {
+      while (this->index_ < this->map_->dense_.size() and
+             this->map_->dense_[this->index_] == NULL)
+        ++this->index_;
+    }
+
+    const SlotMap* map_;
+    size_type index_;
+  };
+
+
+  /**
+   * Constructor.
+   */
+  SlotMap()
+    : removed_(0), free_(NoSlot)
+  {}
+
+
+  /**
+   * Get the number of values.
+   * @return the number of values.
+   */
+  size_type size() const { return this->dense_.size() - this->removed_; }
+
+  /**
+   * Check if there are no values.
+   * @return true if there are no values, else false.
+   */
+  bool empty() const { return this->size() == 0; }
+
+
+  /**
+   * Get a iterator to the first value.
+   * @return the iterator.
+   */
+  iterator begin() const { return iterator(this, 0); }
+
+  /**
+   * Get a iterator past the last value.
+   * @return the iterator.
+   */
+  iterator end() const { return iterator(this, this->dense_.size()); }
+
+
+  /**
+   * Insert a value at the end.
+   * The handle is also stored in value->slot.
+   * @param value the value.
+   * @return the handle of the value.
+   */
+  SlotHandle insert(T* value)
+  {
+    Uint32 index;
+    if (this->free_ != NoSlot) {
+      index = this->free_;
+      this->free_ = this->slots_[index].dense;
+    } else {
+      index = this->slots_.size();
+      Slot slot = {0, 0};
+      this->slots_.push_back(slot);
+    }
+
+    this->slots_[index].dense = this->dense_.size();
+    this->dense_.push_back(value);
+    this->dense_slot_.push_back(index);
+
+    SlotHandle handle = {index, this->slots_[index].generation};
+    value->slot = handle;
+    return handle;
+  }
+
+  /**
+   * Remove a value.
+   * The value is not deleted.
+   * @param value the value.
+   */
+  void remove(T* value)
+  {
+    assert(this->get(value->slot) == value);
+
+    Uint32 index = value->slot.index;
+    this->dense_[this->slots_[index].dense] = NULL;
+    this->removed_++;
+
+    this->slots_[index].generation++;
+    this->slots_[index].dense = this->free_;
+    this->free_ = index;
+  }
+
+  /**
+   * Get the value of a handle.
+   * @param handle the handle.
+   * @return the value or NULL if it was removed.
+   */
+  T* get(SlotHandle handle) const
+  {
+    if (handle.index >= this->slots_.size() or
+        this->slots_[handle.index].generation != handle.generation)
+      return NULL;
+
+    return this->dense_[this->slots_[handle.index].dense];
+  }
+
+  /**
+   * Get the position of a value in the order of the iterators.
+   * The position changes when the map is compacted.
+   * @param value the value.
+   * @return the position.
+   */
+  size_type order(const T* value) const
+  {
+    assert(this->get(value->slot) == value);
+
+    return this->slots_[value->slot.index].dense;
+  }
+
+
+  /**
+   * Remove the holes left by the removed values.
+   * The order of the values is kept. It's only done when at least half of
+   * the dense array are holes, so the cost is amortized over the removals.
+   * It must not be called while iterating.
+   */
+  void compact()
+  {
+    if (this->removed_ * 2 < this->dense_.size() or this->removed_ == 0)
+      return;
+
+    size_type used = 0;
+    for (size_type i = 0; i < this->dense_.size(); i++)
+      if (this->dense_[i] != NULL) {
+        this->dense_[used] = this->dense_[i];
+        this->dense_slot_[used] = this->dense_slot_[i];
+        this->slots_[this->dense_slot_[used]].dense = used;
+        used++;
+      }
+    this->dense_.resize(used);
+    this->dense_slot_.resize(used);
+    this->removed_ = 0;
+  }
+
+private:
+  /**
+   * Value used as a NULL index of a slot.
+   */
+  static const Uint32 NoSlot = 0xffffffff;
+
+  /**
+   * Information of a slot.
+   */
+  struct Slot
+  {
+    Uint32 dense;               /**< Index in dense_ or next free slot */
+    Uint32 generation;          /**< Generation of the slot */
+  };
+
+  std::vector<Slot> slots_;     /**< Slots of the handles */
+  std::vector<T*> dense_;       /**< Values, NULL if removed */
+  std::vector<Uint32> dense_slot_; /**< Slot of each value */
+  size_type removed_;           /**< Number of holes in dense_ */
+  Uint32 free_;                 /**< First free slot */
+};
+
+}
+
+#endif // SIMPLEWORLD_SLOTMAP_HPP
@@ -0,0 +1,181 @@
+/**
+ * @file simpleworld/threadpool.cpp
+ * Pool of threads that execute tasks with work stealing.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/bind.hpp>
+
+#include "threadpool.hpp"
+
+namespace simpleworld
+{
+
+/**
+ * Constructor.
+ * @param threads number of threads, including the thread that calls run().
+ * If it's 0 the number of processors is used.
+ */
+ThreadPool::ThreadPool(unsigned threads)
+  : size_(threads), task_(NULL), generation_(0), busy_(0), stop_(false)
+{
+  if (this->size_ == 0)
+    this->size_ = boost::thread::hardware_concurrency();
+  if (this->size_ == 0)
+    this->size_ = 1;
+
+  this->ranges_.reset(new Range[this->size_]);
+  for (unsigned thread = 0; thread < this->size_; thread++) {
+    this->ranges_[thread].begin = 0;
+    this->ranges_[thread].end = 0;
+  }
+
+  // the thread 0 is the one that calls run()
+  for (unsigned thread = 1; thread < this->size_; thread++)
+    this->workers_.create_thread(boost::bind(&ThreadPool::work, this,
+                                             thread));
+}
+
+/**
+ * Destructor.
+ */
+ThreadPool::~ThreadPool()
+{
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    this->stop_ = true;
+  }
+  this->start_.notify_all();
+
+  this->workers_.join_all();
+}
+
+
+/**
+ * Execute a task for each index in [0, size) and wait until all of them
+ * are finished.
+ * The order of the tasks is not defined.
+ * @param size number of indexes.
+ * @param task the task.
+ */
+void ThreadPool::run(std::size_t size, const Task& task)
+{
+  // split the indexes between the threads
+  for (unsigned thread = 0; thread < this->size_; thread++) {
+    boost::mutex::scoped_lock lock(this->ranges_[thread].mutex);
+    this->ranges_[thread].begin = size * thread / this->size_;
+    this->ranges_[thread].end = size * (thread + 1) / this->size_;
+  }
+
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    this->task_ = &task;
+    this->generation_++;
+    this->busy_ = this->size_ - 1;
+  }
+  this->start_.notify_all();
+
+  this->execute(0);
+
+  boost::mutex::scoped_lock lock(this->mutex_);
+  while (this->busy_ > 0)
+    this->finish_.wait(lock);
+  this->task_ = NULL;
+}
+
+
+/**
+ * Main function of the workers.
+ * @param thread index of the thread.
+ */
+void ThreadPool::work(unsigned thread)
+{
+  Uint32 generation = 0;
+  while (true) {
+    {
+      boost::mutex::scoped_lock lock(this->mutex_);
+      while (not this->stop_ and this->generation_ == generation)
+        this->start_.wait(lock);
+      if (this->stop_)
+        return;
+      generation = this->generation_;
+    }
+
+    this->execute(thread);
+
+    boost::mutex::scoped_lock lock(this->mutex_);
+    if (--this->busy_ == 0)
+      this->finish_.notify_one();
+  }
+}
+
+/**
+ * Execute tasks until there is no index left.
+ * @param thread index of the thread.
+ */
+void ThreadPool::execute(unsigned thread)
+{
+  std::size_t index;
+  while (this->next(thread, &index))
+    (*this->task_)(index);
+}
+
+/**
+ * Take the next index for a thread.
+ * @param thread index of the thread.
+ * @param index where to store the index.
+ * @return true if a index was found, false if there is no index left.
+ */
+bool ThreadPool::next(unsigned thread, std::size_t* index)
+{
+  Range& own = this->ranges_[thread];
+  {
+    boost::mutex::scoped_lock lock(own.mutex);
+    if (own.begin < own.end) {
+      *index = own.begin++;
+      return true;
+    }
+  }
+
+  // steal the last half of the indexes left to other thread
+  for (unsigned i = 1; i < this->size_; i++) {
+    Range& victim = this->ranges_[(thread + i) % this->size_];
+    std::size_t begin;
+    std::size_t end;
+    {
+      boost::mutex::scoped_lock lock(victim.mutex);
+      if (victim.begin >= victim.end)
+        continue;
+
+      end = victim.end;
+      begin = victim.end - (victim.end - victim.begin + 1) / 2;
+      victim.end = begin;
+    }
+
+    // the lock of the victim is released before to avoid a deadlock when
+    // two threads steal from each other
+    boost::mutex::scoped_lock lock(own.mutex);
+    own.begin = begin + 1;
+    own.end = end;
+    *index = begin;
+    return true;
+  }
+
+  return false;
+}
+
+}
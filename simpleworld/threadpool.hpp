@@ -0,0 +1,129 @@
+/**
+ * @file simpleworld/threadpool.hpp
+ * Pool of threads that execute tasks with work stealing.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEWORLD_THREADPOOL_HPP
+#define SIMPLEWORLD_THREADPOOL_HPP
+
+#include <cstddef>
+
+#include <boost/function.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <simpleworld/ints.hpp>
+
+namespace simpleworld
+{
+
+/**
+ * Pool of threads that execute tasks with work stealing.
+ *
+ * Each call to run() splits the indexes of the tasks in a range for each
+ * thread. A thread takes the indexes of its range from the front and, when
+ * its range is empty, steals half of the range of other thread from the
+ * back. The thread that calls run() works as one more thread of the pool.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * Task executed for each index.
+   * It must not throw any exception.
+   */
+  typedef boost::function<void (std::size_t)> Task;
+
+  /**
+   * Constructor.
+   * @param threads number of threads, including the thread that calls run().
+   * If it's 0 the number of processors is used.
+   */
+  ThreadPool(unsigned threads = 0);
+
+  /**
+   * Destructor.
+   */
+  ~ThreadPool();
+
+
+  /**
+   * Number of threads, including the thread that calls run().
+   * @return the number of threads.
+   */
+  unsigned threads() const { return this->size_; }
+
+
+  /**
+   * Execute a task for each index in [0, size) and wait until all of them
+   * are finished.
+   * The order of the tasks is not defined.
+   * @param size number of indexes.
+   * @param task the task.
+   */
+  void run(std::size_t size, const Task& task);
+
+private:
+  /**
+   * Range of indexes of a thread.
+   */
+  struct Range
+  {
+    boost::mutex mutex;
+    std::size_t begin;          /**< First index not taken */
+    std::size_t end;            /**< Index after the last one */
+  };
+
+  unsigned size_;               /**< Number of threads */
+  boost::scoped_array<Range> ranges_;
+  boost::thread_group workers_;
+
+  boost::mutex mutex_;          /**< Mutex of the members below */
+  boost::condition_variable start_;
+  boost::condition_variable finish_;
+  const Task* task_;
+  Uint32 generation_;           /**< Number of calls to run() */
+  unsigned busy_;               /**< Workers executing tasks */
+  bool stop_;
+
+  /**
+   * Main function of the workers.
+   * @param thread index of the thread.
+   */
+  void work(unsigned thread);
+
+  /**
+   * Execute tasks until there is no index left.
+   * @param thread index of the thread.
+   */
+  void execute(unsigned thread);
+
+  /**
+   * Take the next index for a thread.
+   * @param thread index of the thread.
+   * @param index where to store the index.
+   * @return true if a index was found, false if there is no index left.
+   */
+  bool next(unsigned thread, std::size_t* index);
+};
+
+}
+
+#endif // SIMPLEWORLD_THREADPOOL_HPP
@@ -0,0 +1,180 @@
+/**
+ * @file simpleworld/timingwheel.hpp
+ * Hierarchical timing wheel.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMPLEWORLD_TIMINGWHEEL_HPP
+#define SIMPLEWORLD_TIMINGWHEEL_HPP
+
+#include <vector>
+#include <cassert>
+
+#include <simpleworld/types.hpp>
+
+namespace simpleworld
+{
+
+/**
+ * Hierarchical timing wheel.
+ *
+ * The events are kept in 4 levels of 256 buckets. The first level has a
+ * bucket for each one of the next 256 cycles, the next levels have buckets
+ * of 256, 65536 and 16777216 cycles that are moved to the lower levels when
+ * their time comes. Scheduling a event is O(1) and advancing a cycle only
+ * costs the events that are due in that cycle (plus the amortized cost of
+ * moving each event down at most 3 levels).
+ */
+template <typename T>
+class TimingWheel
+{
+public:
+  /**
+   * Constructor.
+   * @param now last cycle already processed.
+   */
+  TimingWheel(Time now = 0)
+    : now_(now), size_(0)
+  {}
+
+
+  /**
+   * Get the last cycle processed.
+   * @return the cycle.
+   */
+  Time now() const { return this->now_; }
+
+  /**
+   * Get the number of events waiting.
+   * @return the number of events.
+   */
+  Uint32 size() const { return this->size_; }
+
+
+  /**
+   * Remove all the events.
+   * @param now last cycle already processed.
+   */
+  void clear(Time now)
+  {
+    for (unsigned level = 0; level < Levels; level++)
+      for (unsigned bucket = 0; bucket < Buckets; bucket++)
+        this->buckets_[level][bucket].clear();
+    this->now_ = now;
+    this->size_ = 0;
+  }
+
+  /**
+   * Add a event.
+   * A event for a cycle already processed is moved to the next cycle.
+   * @param time cycle of the event.
+   * @param value value returned when the event is due.
+   */
+  void schedule(Time time, const T& value)
+  {
+    Event event = {time <= this->now_ ? this->now_ + 1 : time, value};
+    this->place(event);
+    this->size_++;
+  }
+
+  /**
+   * Process the cycles until time.
+   * The values of the events are appended to due in the order they are
+   * found, not in the order they were scheduled.
+   * @param time last cycle to process.
+   * @param due where the values of the due events are appended.
+   */
+  void advance(Time time, std::vector<T>* due)
+  {
+    while (this->now_ != time) {
+      Time tick = this->now_ + 1;
+
+      // move the events of the upper levels that are in range now
+      for (unsigned level = 1; level < Levels; level++) {
+        if (((tick >> (Bits * (level - 1))) & (Buckets - 1)) != 0)
+          break;
+        this->cascade(level, (tick >> (Bits * level)) & (Buckets - 1));
+      }
+
+      std::vector<Event>& bucket = this->buckets_[0][tick & (Buckets - 1)];
+      for (typename std::vector<Event>::const_iterator event = bucket.begin();
+           event != bucket.end();
+           ++event) {
+        assert(event->time == tick);
+        due->push_back(event->value);
+      }
+      this->size_ -= bucket.size();
+      bucket.clear();
+
+      this->now_ = tick;
+    }
+  }
+
+private:
+  static const unsigned Levels = 4;  /**< Number of levels */
+  static const unsigned Bits = 8;    /**< Bits of the time in each level */
+  static const unsigned Buckets = 1 << Bits; /**< Buckets in each level */
+
+  /**
+   * A scheduled event.
+   */
+  struct Event
+  {
+    Time time;                  /**< Cycle of the event */
+    T value;                    /**< Value of the event */
+  };
+
+  /**
+   * Put a event in its bucket.
+   * The level depends on how far is the event from the next cycle.
+   * @param event the event.
+   */
+  void place(const Event& event)
+  {
+    Time delta = event.time - (this->now_ + 1);
+    unsigned level = 0;
+    while (level < Levels - 1 and (delta >> (Bits * (level + 1))) != 0)
+      level++;
+
+    this->buckets_[level][(event.time >> (Bits * level)) & (Buckets - 1)]
+      .push_back(event);
+  }
+
+  /**
+   * Move the events of a bucket to the lower levels.
+   * @param level level of the bucket.
+   * @param index index of the bucket.
+   */
+  void cascade(unsigned level, unsigned index)
+  {
+    std::vector<Event> events;
+    events.swap(this->buckets_[level][index]);
+
+    for (typename std::vector<Event>::const_iterator event = events.begin();
+         event != events.end();
+         ++event)
+      this->place(*event);
+  }
+
+  std::vector<Event> buckets_[Levels][Buckets]; /**< Buckets of events */
+  Time now_;                    /**< Last cycle processed */
+  Uint32 size_;                 /**< Number of events waiting */
+};
+
+}
+
+#endif // SIMPLEWORLD_TIMINGWHEEL_HPP
@@ -29,7 +29,7 @@ namespace simpleworld
 /**
  * Coordinate of a position.
  */
-typedef Uint16 Coord;
+typedef Uint32 Coord;
 
 /**
  * Position of a element.
@@ -91,7 +91,8 @@ enum ElementType {
 enum ActionStatus {
   ActionSuccess = 0,
   ActionFailure = 1,
-  ActionInterrupted = 2
+  ActionInterrupted = 2,
+  ActionDeath = 3               /**< The bug died, it's not stored in g0 */
 };
 
 
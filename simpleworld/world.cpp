@@ -18,7 +18,9 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <cstdlib>
+#include <cassert>
+#include <cstring>
+#include <algorithm>
 
 #include <boost/format.hpp>
 
@@ -45,12 +47,12 @@ namespace simpleworld
 
 /**
  * Check if position is used.
- * @param terrain where to search.
+ * @param element element in the position.
  * @param position position to check.
  * @exception Exception if the position is used.
  */
-#define CHECK_USED(terrain, position) \
-  if (terrain[position.x][position.y] != NULL) \
+#define CHECK_USED(element, position) \
+  if (element != NULL) \
     throw EXCEPTION(WorldError, boost::str(boost::format(\
 "Position (%1%, %2%) is already used") \
                                            % position.x \
@@ -58,33 +60,81 @@ namespace simpleworld
 
 /**
  * Check if position is not used.
- * @param terrain where to search.
+ * @param element element in the position.
  * @param position position to check.
  * @exception Exception if the position is not used.
  */
-#define CHECK_NOTUSED(terrain, position) \
-  if (terrain[position.x][position.y] == NULL) \
+#define CHECK_NOTUSED(element, position) \
+  if (element == NULL) \
     throw EXCEPTION(WorldError, boost::str(boost::format(\
 "Position (%1%, %2%) is not used") \
                                            % position.x \
                                            % position.y));
 
 
+/**
+ * Number of bits set in a word.
+ * @param word the word.
+ * @return the number of bits set.
+ */
+static inline unsigned popcount(Uint64 word)
+{
+#if defined(__GNUC__)
+  return __builtin_popcountll(word);
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return (word * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+/**
+ * Position of a bit set in a word.
+ * @param word the word.
+ * @param index number of bits set before the bit, starting from the lowest.
+ * @return the position of the bit.
+ */
+static inline unsigned select(Uint64 word, unsigned index)
+{
+  for (unsigned i = 0; i < index; i++)
+    word &= word - 1;
+
+#if defined(__GNUC__)
+  return __builtin_ctzll(word);
+#else
+  unsigned bit = 0;
+  while ((word & 1) == 0) {
+    word >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+
+/**
+ * Mask of the bits of a row of a tile in the range [start, end).
+ * @param start first bit.
+ * @param end bit after the last one.
+ * @return the mask.
+ */
+static inline Uint64 row_mask(unsigned start, unsigned end)
+{
+  Uint64 mask = end == 64 ? ~static_cast<Uint64>(0) :
+    (static_cast<Uint64>(1) << end) - 1;
+  return mask & (~static_cast<Uint64>(0) << start);
+}
+
+
 /**
  * Constructor.
  * @param width width of the World.
  * @param height height of the World.
  */
 World::World(Coord width, Coord height)
-  : num_elements_(0), terrain_(boost::extents[width][height])
 {
-  this->size_.x = width;
-  this->size_.y = height;
-
-  Position i;
-  for (i.x = 0; i.x < width; i.x++)
-    for (i.y = 0; i.y < height; i.y++)
-      this->terrain_[i.x][i.y] = NULL;
+  this->init_(Position(width, height));
 }
 
 /**
@@ -92,12 +142,20 @@ World::World(Coord width, Coord height)
  * @param size size of the World.
  */
 World::World(Position size)
-  : size_(size), num_elements_(0), terrain_(boost::extents[size.x][size.y])
 {
-  Position i;
-  for (i.x = 0; i.x < size.x; i.x++)
-    for (i.y = 0; i.y < size.y; i.y++)
-      this->terrain_[i.x][i.y] = NULL;
+  this->init_(size);
+}
+
+/**
+ * Destructor.
+ */
+World::~World()
+{
+  for (std::vector<Tile*>::iterator tile = this->tiles_.begin();
+       tile != this->tiles_.end();
+       ++tile)
+    delete *tile;
+  delete this->spare_;
 }
 
 /**
@@ -106,15 +164,9 @@ World::World(Position size)
  * @param end right/bottom position of the region.
  * @return the number of elements.
  */
-Uint16 World::num_elements(Position start, Position end) const
+Uint32 World::num_elements(Position start, Position end) const
 {
-  Uint16 count = 0;
-  for (Coord x = start.x; x < end.x; x++)
-    for (Coord y = start.y; y < end.y; y++)
-      if (this->terrain_[x][y] != NULL)
-        count++;
-
-  return count;
+  return this->count_(start, end, ElementNothing);
 }
 
 /**
@@ -124,18 +176,13 @@ Uint16 World::num_elements(Position start, Position end) const
  * @param type type of element.
  * @return the number of elements.
  */
-Uint16 World::num_elements(Position start, Position end,
+Uint32 World::num_elements(Position start, Position end,
                            ElementType type) const
 {
-  Uint16 count = 0;
-  for (Coord x = start.x; x < end.x; x++)
-    for (Coord y = start.y; y < end.y; y++) {
-      Element* const element = this->terrain_[x][y];
-      if (element != NULL and element->type == type)
-        count++;
-    }
+  if (type == ElementNothing or static_cast<unsigned>(type) >= NumBitmaps)
+    return 0;
 
-  return count;
+  return this->count_(start, end, type);
 }
 
 
@@ -149,12 +196,10 @@ Uint16 World::num_elements(Position start, Position end,
 void World::add(Element* element, Position position)
 {
   CHECK_OUTOFRANGE(position, this->size_);
-  CHECK_USED(this->terrain_, position);
+  CHECK_USED(this->element_(position), position);
 
   if (element != NULL)
-    this->num_elements_++;
-
-  this->terrain_[position.x][position.y] = element;
+    this->put_(element, position);
 }
 
 /**
@@ -166,10 +211,9 @@ void World::add(Element* element, Position position)
 void World::remove(Position position)
 {
   CHECK_OUTOFRANGE(position, this->size_);
-  CHECK_NOTUSED(this->terrain_, position);
+  CHECK_NOTUSED(this->element_(position), position);
 
-  this->num_elements_--;
-  this->terrain_[position.x][position.y] = NULL;
+  this->take_(position);
 }
 
 
@@ -183,7 +227,7 @@ bool World::used(Position position) const
 {
   CHECK_OUTOFRANGE(position, this->size_);
 
-  return this->terrain_[position.x][position.y] != NULL;
+  return this->element_(position) != NULL;
 }
 
 /**
@@ -196,60 +240,59 @@ bool World::used(Position position) const
 Element* World::get(Position position) const
 {
   CHECK_OUTOFRANGE(position, this->size_);
-  CHECK_NOTUSED(this->terrain_, position);
+  Element* element = this->element_(position);
+  CHECK_NOTUSED(element, position);
 
-  return this->terrain_[position.x][position.y];
+  return element;
 }
 
 
 /**
  * Get a random unused position.
+ * All the unused positions have the same probability and the position
+ * is found without trying random positions until one is unused.
+ * @param random generator of the random numbers.
  * @return the unused position.
  * @exception WorldError if there aren't unused positions.
  */
-Position World::unused_position() const
+Position World::unused_position(Random* random) const
 {
-  if (this->size_.x * this->size_.y == this->num_elements_)
+  Uint64 unused = static_cast<Uint64>(this->size_.x) * this->size_.y -
+    this->counts_[ElementNothing];
+  if (unused == 0)
     throw EXCEPTION(WorldError, "There aren't unused positions");
 
-  Position pos;
-  do {
-    pos.x = float(this->size_.x) * (std::rand() / (RAND_MAX + 1.0));
-    pos.y = float(this->size_.y) * (std::rand() / (RAND_MAX + 1.0));
-  } while (this->terrain_[pos.x][pos.y] != NULL);
-
-  return pos;
+  return this->select_unused_(Position(0, 0), this->size_,
+                              random->integer64(0, unused));
 }
 
 /**
  * Get a random unused position inside a region of the World.
+ * All the unused positions of the region have the same probability.
  * @param start left/top position of the region.
  * @param end right/bottom position of the region.
+ * @param random generator of the random numbers.
  * @return the unused position.
  * @exception WorldError if there aren't unused positions.
  */
-Position World::unused_position(Position start, Position end) const
+Position World::unused_position(Position start, Position end,
+                                Random* random) const
 {
-  Position size(end.x - start.x, end.y - start.y);
-  if (size.x * size.y == this->num_elements(start, end))
+  Uint64 unused = this->count_unused_(start, end);
+  if (unused == 0)
     throw EXCEPTION(WorldError, "There aren't unused positions");
 
-  Position pos;
-  do {
-    pos.x = start.x + float(size.x) * (std::rand() / (RAND_MAX + 1.0));
-    pos.y = start.y + float(size.y) * (std::rand() / (RAND_MAX + 1.0));
-  } while (this->terrain_[pos.x][pos.y] != NULL);
-
-  return pos;
+  return this->select_unused_(start, end, random->integer64(0, unused));
 }
 
 /**
  * Get a random orientation.
+ * @param random generator of the random numbers.
  * @return the random orientation.
  */
-Orientation World::random_orientation()
+Orientation World::random_orientation(Random* random)
 {
-  return static_cast<Orientation>(float(4) * (std::rand() / (RAND_MAX + 1.0)));
+  return static_cast<Orientation>(random->integer(0, 4));
 }
 
 
@@ -265,11 +308,11 @@ Orientation World::random_orientation()
 void World::move(Position oldposition, Position newposition)
 {
   CHECK_OUTOFRANGE(oldposition, this->size_);
-  CHECK_NOTUSED(this->terrain_, oldposition);
+  Element* element = this->element_(oldposition);
+  CHECK_NOTUSED(element, oldposition);
   CHECK_OUTOFRANGE(newposition, this->size_);
-  CHECK_USED(this->terrain_, newposition);
+  CHECK_USED(this->element_(newposition), newposition);
 
-  Element* element = this->get(oldposition);
   if (not element->movable())
     throw EXCEPTION(WorldError, boost::str(boost::format(\
 "Element in position (%1%, %2%) is not movable")
@@ -277,8 +320,313 @@ void World::move(Position oldposition, Position newposition)
                                            % oldposition.y));
 
   // Update the World
-  this->terrain_[oldposition.x][oldposition.y] = NULL;
-  this->terrain_[newposition.x][newposition.y] = element;
+  this->put_(element, newposition);
+  this->take_(oldposition);
+}
+
+
+/**
+ * Initialize the World.
+ * @param size size of the World.
+ */
+void World::init_(Position size)
+{
+  this->size_ = size;
+  this->tiles_size_.x = (size.x + WORLD_TILE_SIZE - 1) / WORLD_TILE_SIZE;
+  this->tiles_size_.y = (size.y + WORLD_TILE_SIZE - 1) / WORLD_TILE_SIZE;
+  std::size_t tiles = static_cast<std::size_t>(this->tiles_size_.x) *
+    this->tiles_size_.y;
+  for (unsigned i = 0; i < NumBitmaps; i++) {
+    this->counts_[i] = 0;
+    this->sums_[i].assign(tiles, 0);
+  }
+
+  this->tiles_.assign(tiles, NULL);
+  this->spare_ = NULL;
+}
+
+/**
+ * Put a element in a position and update the bitmaps.
+ * The tile is allocated if it's needed.
+ * @param element the element.
+ * @param position the position, inside of the World and not used.
+ */
+void World::put_(Element* element, Position position)
+{
+  Tile*& tile = this->tiles_[this->tile_(position)];
+  if (tile == NULL) {
+    if (this->spare_ != NULL) {
+      tile = this->spare_;
+      this->spare_ = NULL;
+    } else
+      tile = new Tile;
+    std::memset(tile, 0, sizeof(Tile));
+  }
+
+  tile->elements[cell_(position)] = element;
+
+  Uint64 bit = static_cast<Uint64>(1) << (position.x % WORLD_TILE_SIZE);
+  Coord row = position.y % WORLD_TILE_SIZE;
+  Coord tx = position.x / WORLD_TILE_SIZE;
+  Coord ty = position.y / WORLD_TILE_SIZE;
+  tile->bitmaps[ElementNothing][row] |= bit;
+  tile->counts[ElementNothing]++;
+  this->counts_[ElementNothing]++;
+  this->add_sum_(ElementNothing, tx, ty, 1);
+  if (element->type != ElementNothing and
+      static_cast<unsigned>(element->type) < NumBitmaps) {
+    tile->bitmaps[element->type][row] |= bit;
+    tile->counts[element->type]++;
+    this->counts_[element->type]++;
+    this->add_sum_(element->type, tx, ty, 1);
+  }
+}
+
+/**
+ * Remove the element of a position and update the bitmaps.
+ * The tile is freed if it's empty.
+ * @param position the position, inside of the World and used.
+ * @return the element.
+ */
+Element* World::take_(Position position)
+{
+  Tile*& tile = this->tiles_[this->tile_(position)];
+  Element* element = tile->elements[cell_(position)];
+  tile->elements[cell_(position)] = NULL;
+
+  Uint64 bit = static_cast<Uint64>(1) << (position.x % WORLD_TILE_SIZE);
+  Coord row = position.y % WORLD_TILE_SIZE;
+  Coord tx = position.x / WORLD_TILE_SIZE;
+  Coord ty = position.y / WORLD_TILE_SIZE;
+  tile->bitmaps[ElementNothing][row] &= ~bit;
+  tile->counts[ElementNothing]--;
+  this->counts_[ElementNothing]--;
+  this->add_sum_(ElementNothing, tx, ty, -1);
+  if (element->type != ElementNothing and
+      static_cast<unsigned>(element->type) < NumBitmaps) {
+    tile->bitmaps[element->type][row] &= ~bit;
+    tile->counts[element->type]--;
+    this->counts_[element->type]--;
+    this->add_sum_(element->type, tx, ty, -1);
+  }
+
+  // a tile is kept to not allocate it again when a element is removed
+  // and added in the same cycle
+  if (tile->counts[ElementNothing] == 0) {
+    delete this->spare_;
+    this->spare_ = tile;
+    tile = NULL;
+  }
+
+  return element;
+}
+
+/**
+ * Add a value to the number of elements of a type in a tile.
+ * @param type type of element.
+ * @param tx x coord of the tile.
+ * @param ty y coord of the tile.
+ * @param value value added.
+ */
+void World::add_sum_(unsigned type, Coord tx, Coord ty, Sint32 value)
+{
+  for (Coord i = ty + 1; i <= this->tiles_size_.y; i += i & (~i + 1))
+    for (Coord j = tx + 1; j <= this->tiles_size_.x; j += j & (~j + 1))
+      this->sums_[type][static_cast<std::size_t>(i - 1) *
+                        this->tiles_size_.x + j - 1] += value;
+}
+
+/**
+ * Number of elements of a type in the tiles before a tile, the tiles
+ * with a x coord less than tx and a y coord less than ty.
+ * @param type type of element.
+ * @param tx x coord of the tile.
+ * @param ty y coord of the tile.
+ * @return the number of elements.
+ */
+Uint32 World::sum_(unsigned type, Coord tx, Coord ty) const
+{
+  Uint32 sum = 0;
+  for (Coord i = ty; i > 0; i -= i & (~i + 1))
+    for (Coord j = tx; j > 0; j -= j & (~j + 1))
+      sum += this->sums_[type][static_cast<std::size_t>(i - 1) *
+                               this->tiles_size_.x + j - 1];
+
+  return sum;
+}
+
+/**
+ * Number of positions used by a type of element in a region.
+ * The tiles inside of the region are counted by the sums, only the tiles
+ * in the border of the region are counted row by row.
+ * @param start left/top position of the region.
+ * @param end right/bottom position of the region.
+ * @param type type of element, ElementNothing for any type.
+ * @return the number of positions.
+ */
+Uint32 World::count_(Position start, Position end, unsigned type) const
+{
+  if (start.x >= end.x or start.y >= end.y)
+    return 0;
+  if (start.x == 0 and start.y == 0 and
+      end.x == this->size_.x and end.y == this->size_.y)
+    return this->counts_[type];
+
+  // tiles of the region and tiles with all their positions in the region
+  Position first(start.x / WORLD_TILE_SIZE, start.y / WORLD_TILE_SIZE);
+  Position last((end.x - 1) / WORLD_TILE_SIZE, (end.y - 1) / WORLD_TILE_SIZE);
+  Position full_first(start.x % WORLD_TILE_SIZE == 0 ? first.x : first.x + 1,
+                      start.y % WORLD_TILE_SIZE == 0 ? first.y : first.y + 1);
+  Position full_end(end.x % WORLD_TILE_SIZE == 0 or end.x == this->size_.x ?
+                    last.x + 1 : last.x,
+                    end.y % WORLD_TILE_SIZE == 0 or end.y == this->size_.y ?
+                    last.y + 1 : last.y);
+
+  Uint32 count = 0;
+  if (full_first.x < full_end.x and full_first.y < full_end.y)
+    count += this->sum_(type, full_end.x, full_end.y) -
+      this->sum_(type, full_first.x, full_end.y) -
+      this->sum_(type, full_end.x, full_first.y) +
+      this->sum_(type, full_first.x, full_first.y);
+
+  // the first and the last rows of tiles if they are in the border
+  if (first.y < full_first.y or first.y >= full_end.y)
+    for (Coord tx = first.x; tx <= last.x; tx++)
+      count += this->count_tile_(start, end, type, tx, first.y);
+  if (last.y != first.y and last.y >= full_end.y)
+    for (Coord tx = first.x; tx <= last.x; tx++)
+      count += this->count_tile_(start, end, type, tx, last.y);
+
+  // the first and the last tiles of the other rows if they are in the border
+  bool first_border = first.x < full_first.x or first.x >= full_end.x;
+  bool last_border = last.x != first.x and last.x >= full_end.x;
+  if (first_border or last_border)
+    for (Coord ty = full_first.y; ty < full_end.y; ty++) {
+      if (first_border)
+        count += this->count_tile_(start, end, type, first.x, ty);
+      if (last_border)
+        count += this->count_tile_(start, end, type, last.x, ty);
+    }
+
+  return count;
+}
+
+/**
+ * Number of positions used by a type of element in the part of a region
+ * inside of a tile.
+ * @param start left/top position of the region.
+ * @param end right/bottom position of the region.
+ * @param type type of element, ElementNothing for any type.
+ * @param tx x coord of the tile.
+ * @param ty y coord of the tile.
+ * @return the number of positions.
+ */
+Uint32 World::count_tile_(Position start, Position end, unsigned type,
+                          Coord tx, Coord ty) const
+{
+  const Tile* tile =
+    this->tiles_[static_cast<std::size_t>(ty) * this->tiles_size_.x + tx];
+  if (tile == NULL)
+    return 0;
+
+  Coord x0 = std::max(start.x, tx * WORLD_TILE_SIZE) - tx * WORLD_TILE_SIZE;
+  Coord x1 = std::min(end.x - tx * WORLD_TILE_SIZE,
+                      static_cast<Coord>(WORLD_TILE_SIZE));
+  Coord y0 = std::max(start.y, ty * WORLD_TILE_SIZE) - ty * WORLD_TILE_SIZE;
+  Coord y1 = std::min(end.y - ty * WORLD_TILE_SIZE,
+                      static_cast<Coord>(WORLD_TILE_SIZE));
+  if (x0 == 0 and y0 == 0 and
+      x1 == WORLD_TILE_SIZE and y1 == WORLD_TILE_SIZE)
+    return tile->counts[type];
+
+  Uint32 count = 0;
+  Uint64 mask = row_mask(x0, x1);
+  for (Coord y = y0; y < y1; y++)
+    count += popcount(tile->bitmaps[type][y] & mask);
+
+  return count;
+}
+
+/**
+ * Number of unused positions in a region.
+ * @param start left/top position of the region.
+ * @param end right/bottom position of the region.
+ * @return the number of positions.
+ */
+Uint64 World::count_unused_(Position start, Position end) const
+{
+  if (start.x >= end.x or start.y >= end.y)
+    return 0;
+
+  return static_cast<Uint64>(end.x - start.x) * (end.y - start.y) -
+    this->count_(start, end, ElementNothing);
+}
+
+/**
+ * Find a unused position inside a region of the World by its index.
+ * The unused positions are indexed by tiles and, inside of each tile, in
+ * row major order.
+ * @param start left/top position of the region.
+ * @param end right/bottom position of the region.
+ * @param index index of the position, less than the unused positions of
+ * the region.
+ * @return the unused position.
+ */
+Position World::select_unused_(Position start, Position end,
+                               Uint64 index) const
+{
+  // binary search of the row of tiles
+  Coord first = start.y / WORLD_TILE_SIZE;
+  Coord last = (end.y - 1) / WORLD_TILE_SIZE;
+  while (first < last) {
+    Coord middle = first + (last - first) / 2;
+    Position bound(end.x, std::min(end.y, (middle + 1) * WORLD_TILE_SIZE));
+    if (this->count_unused_(start, bound) > index)
+      last = middle;
+    else
+      first = middle + 1;
+  }
+  Coord ty = first;
+  Coord y0 = std::max(start.y, ty * WORLD_TILE_SIZE);
+  Coord y1 = std::min(end.y, (ty + 1) * WORLD_TILE_SIZE);
+  index -= this->count_unused_(start, Position(end.x, y0));
+
+  // binary search of the tile in the row
+  first = start.x / WORLD_TILE_SIZE;
+  last = (end.x - 1) / WORLD_TILE_SIZE;
+  while (first < last) {
+    Coord middle = first + (last - first) / 2;
+    Position bound(std::min(end.x, (middle + 1) * WORLD_TILE_SIZE), y1);
+    if (this->count_unused_(Position(start.x, y0), bound) > index)
+      last = middle;
+    else
+      first = middle + 1;
+  }
+  Coord tx = first;
+  Coord x0 = std::max(start.x, tx * WORLD_TILE_SIZE);
+  Coord x1 = std::min(end.x, (tx + 1) * WORLD_TILE_SIZE);
+  index -= this->count_unused_(Position(start.x, y0), Position(x0, y1));
+
+  const Tile* tile =
+    this->tiles_[static_cast<std::size_t>(ty) * this->tiles_size_.x + tx];
+  Uint64 mask = row_mask(x0 - tx * WORLD_TILE_SIZE,
+                         x1 - tx * WORLD_TILE_SIZE);
+  for (Coord y = y0 - ty * WORLD_TILE_SIZE;
+       y < y1 - ty * WORLD_TILE_SIZE;
+       y++) {
+    Uint64 bits = tile == NULL ? mask :
+      ~tile->bitmaps[ElementNothing][y] & mask;
+    unsigned count = popcount(bits);
+    if (index < count)
+      return Position(tx * WORLD_TILE_SIZE +
+                      select(bits, static_cast<unsigned>(index)),
+                      ty * WORLD_TILE_SIZE + y);
+    index -= count;
+  }
+
+  // the index is always less than the unused positions
+  assert(false);
+  return start;
 }
 
 }
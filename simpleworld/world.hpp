@@ -20,19 +20,39 @@
 #ifndef SIMPLEWORLD_WORLD_HPP
 #define SIMPLEWORLD_WORLD_HPP
 
-#include <map>
-
-#include <boost/multi_array.hpp>
+#include <vector>
+#include <cstddef>
 
 #include <simpleworld/ints.hpp>
 #include <simpleworld/types.hpp>
 #include <simpleworld/element.hpp>
+#include <simpleworld/random.hpp>
 
 namespace simpleworld
 {
 
+/**
+ * Size of the side of the tiles of the World.
+ * The rows of the bitmaps of a tile are a word of 64 bits.
+ */
+#define WORLD_TILE_SIZE 64
+
 /**
  * Simple World World.
+ *
+ * The terrain is split in tiles of WORLD_TILE_SIZE x WORLD_TILE_SIZE
+ * positions that are allocated when the first element is added to them
+ * and freed when the last one is removed, so a big World with few
+ * elements only uses the memory of the tiles used. The elements of a tile
+ * are kept in Z-order, so the positions near each other are near in
+ * memory.
+ *
+ * For each type of element a tile has also a bitmap with the positions
+ * used by elements of that type (the bitmap of ElementNothing has the
+ * positions used by any element). The elements of the tiles inside of a
+ * region are counted with a Fenwick tree of the number of elements of the
+ * tiles, and the ones of the tiles in the border a row of a tile at a
+ * time. The type of a element must not change while it's in the World.
  */
 class World
 {
@@ -50,6 +70,11 @@ public:
    */
   World(Position size);
 
+  /**
+   * Destructor.
+   */
+  ~World();
+
 
   /**
    * Size of the World.
@@ -61,7 +86,7 @@ public:
    * Number of elements in the World.
    * @return the number of elements.
    */
-  Uint16 num_elements() const { return this->num_elements_; }
+  Uint32 num_elements() const { return this->counts_[ElementNothing]; }
 
   /**
    * Number of elements in a region of the World.
@@ -69,7 +94,7 @@ public:
    * @param end right/bottom position of the region.
    * @return the number of elements.
    */
-  Uint16 num_elements(Position start, Position end) const;
+  Uint32 num_elements(Position start, Position end) const;
 
   /**
    * Number of elements of a specific kind in a region of the World.
@@ -78,7 +103,7 @@ public:
    * @param type type of element.
    * @return the number of elements.
    */
-  Uint16 num_elements(Position start, Position end, ElementType type) const;
+  Uint32 num_elements(Position start, Position end, ElementType type) const;
 
 
   /**
@@ -116,6 +141,20 @@ public:
    */
   Element* get(Position position) const;
 
+  /**
+   * Get a element from the World without exceptions.
+   * @param position position of the element.
+   * @return the element, NULL if the position is not used or it's out of
+   * the limits.
+   */
+  Element* try_get(Position position) const
+  {
+    if (position.x >= this->size_.x or position.y >= this->size_.y)
+      return NULL;
+
+    return this->element_(position);
+  }
+
   /**
    * Get a element from the World.
    * @param position position of the element.
@@ -128,25 +167,32 @@ public:
 
   /**
    * Get a random unused position.
+   * All the unused positions have the same probability and the position
+   * is found without trying random positions until one is unused.
+   * @param random generator of the random numbers.
    * @return the unused position.
    * @exception WorldError if there aren't unused positions.
    */
-  Position unused_position() const;
+  Position unused_position(Random* random) const;
 
   /**
    * Get a random unused position inside a region of the World.
+   * All the unused positions of the region have the same probability.
    * @param start left/top position of the region.
    * @param end right/bottom position of the region.
+   * @param random generator of the random numbers.
    * @return the unused position.
    * @exception WorldError if there aren't unused positions.
    */
-  Position unused_position(Position start, Position end) const;
+  Position unused_position(Position start, Position end,
+                           Random* random) const;
 
   /**
    * Get a random orientation.
+   * @param random generator of the random numbers.
    * @return the random orientation.
    */
-  static Orientation random_orientation();
+  static Orientation random_orientation(Random* random);
 
 
   /**
@@ -161,10 +207,179 @@ public:
   void move(Position oldposition, Position newposition);
 
 private:
+  /**
+   * Number of bitmaps of occupancy, one for each ElementType.
+   */
+  static const unsigned NumBitmaps = ElementFood + 1;
+
+  /**
+   * Tile of the terrain.
+   */
+  struct Tile
+  {
+    /**
+     * Elements in Z-order, NULL if the position is not used.
+     */
+    Element* elements[WORLD_TILE_SIZE * WORLD_TILE_SIZE];
+
+    /**
+     * Positions used by each type of element, a word for each row.
+     */
+    Uint64 bitmaps[NumBitmaps][WORLD_TILE_SIZE];
+
+    /**
+     * Number of elements of each type.
+     */
+    Uint32 counts[NumBitmaps];
+  };
+
   Position size_;
-  Uint16 num_elements_;
+  Position tiles_size_;         /**< Number of tiles in each coord */
+  Uint32 counts_[NumBitmaps];   /**< Number of elements of each type */
+
+  std::vector<Tile*> tiles_;    /**< Tiles in row major order, or NULL */
+  /**
+   * Number of elements of each type in the tiles, as a two-dimensional
+   * Fenwick tree.
+   */
+  std::vector<Uint32> sums_[NumBitmaps];
+  Tile* spare_;                 /**< Tile freed kept to be used again */
+
+  // the tiles are not copied
+  World(const World& world);
+  World& operator =(const World& world);
+
+  /**
+   * Initialize the World.
+   * @param size size of the World.
+   */
+  void init_(Position size);
+
+  /**
+   * Index of the tile of a position.
+   * @param position the position.
+   * @return the index.
+   */
+  std::size_t tile_(Position position) const
+  {
+    return static_cast<std::size_t>(position.y / WORLD_TILE_SIZE) *
+      this->tiles_size_.x + position.x / WORLD_TILE_SIZE;
+  }
+
+  /**
+   * Index of a position in the elements of its tile.
+   * The bits of the coords inside of the tile are interleaved (Z-order).
+   * @param position the position.
+   * @return the index.
+   */
+  static unsigned cell_(Position position)
+  {
+    return spread_(position.x % WORLD_TILE_SIZE) |
+      spread_(position.y % WORLD_TILE_SIZE) << 1;
+  }
+
+  /**
+   * Insert a zero bit before each bit of a coord inside of a tile.
+   * @param coord the coord.
+   * @return the bits spread.
+   */
+  static unsigned spread_(unsigned coord)
+  {
+    coord = (coord | coord << 4) & 0x0f0f;
+    coord = (coord | coord << 2) & 0x3333;
+    coord = (coord | coord << 1) & 0x5555;
+    return coord;
+  }
 
-  boost::multi_array<Element*, 2> terrain_;
+  /**
+   * Get the element in a position.
+   * @param position the position, inside of the World.
+   * @return the element, NULL if the position is not used.
+   */
+  Element* element_(Position position) const
+  {
+    const Tile* tile = this->tiles_[this->tile_(position)];
+    return tile == NULL ? NULL : tile->elements[cell_(position)];
+  }
+
+  /**
+   * Put a element in a position and update the bitmaps.
+   * The tile is allocated if it's needed.
+   * @param element the element.
+   * @param position the position, inside of the World and not used.
+   */
+  void put_(Element* element, Position position);
+
+  /**
+   * Remove the element of a position and update the bitmaps.
+   * The tile is freed if it's empty.
+   * @param position the position, inside of the World and used.
+   * @return the element.
+   */
+  Element* take_(Position position);
+
+  /**
+   * Add a value to the number of elements of a type in a tile.
+   * @param type type of element.
+   * @param tx x coord of the tile.
+   * @param ty y coord of the tile.
+   * @param value value added.
+   */
+  void add_sum_(unsigned type, Coord tx, Coord ty, Sint32 value);
+
+  /**
+   * Number of elements of a type in the tiles before a tile, the tiles
+   * with a x coord less than tx and a y coord less than ty.
+   * @param type type of element.
+   * @param tx x coord of the tile.
+   * @param ty y coord of the tile.
+   * @return the number of elements.
+   */
+  Uint32 sum_(unsigned type, Coord tx, Coord ty) const;
+
+  /**
+   * Number of positions used by a type of element in a region.
+   * The tiles inside of the region are counted by the sums, only the tiles
+   * in the border of the region are counted row by row.
+   * @param start left/top position of the region.
+   * @param end right/bottom position of the region.
+   * @param type type of element, ElementNothing for any type.
+   * @return the number of positions.
+   */
+  Uint32 count_(Position start, Position end, unsigned type) const;
+
+  /**
+   * Number of positions used by a type of element in the part of a region
+   * inside of a tile.
+   * @param start left/top position of the region.
+   * @param end right/bottom position of the region.
+   * @param type type of element, ElementNothing for any type.
+   * @param tx x coord of the tile.
+   * @param ty y coord of the tile.
+   * @return the number of positions.
+   */
+  Uint32 count_tile_(Position start, Position end, unsigned type,
+                     Coord tx, Coord ty) const;
+
+  /**
+   * Number of unused positions in a region.
+   * @param start left/top position of the region.
+   * @param end right/bottom position of the region.
+   * @return the number of positions.
+   */
+  Uint64 count_unused_(Position start, Position end) const;
+
+  /**
+   * Find a unused position inside a region of the World by its index.
+   * The unused positions are indexed by tiles and, inside of each tile, in
+   * row major order.
+   * @param start left/top position of the region.
+   * @param end right/bottom position of the region.
+   * @param index index of the position, less than the unused positions of
+   * the region.
+   * @return the unused position.
+   */
+  Position select_unused_(Position start, Position end, Uint64 index) const;
 };
 
 }
@@ -20,6 +20,7 @@
 
 #include <iostream>
 #include <cstdio>
+#include <ctime>
 
 #include <getopt.h>
 
@@ -59,9 +60,11 @@ static void help()
 "Usage: %1% create [OPTION]... [DATABASE]\n\
 Create a void World.\n\
 The parameters not set are filled with the default values.\n\
+If the seed is not set, the current time is used.\n\
 \n\
 Mandatory arguments to long options are mandatory for short options too.\n\
       --size=X,Y             size of the World\n\
+      --seed=SEED            seed of the random numbers\n\
 \n\
       --rot=CYCLES           time needed to rot the food\n\
       --srot=SIZE            size that is substracted to the food\n\
@@ -118,6 +121,7 @@ static void parse_cmd(int argc, char* argv[])
 {
   struct option long_options[] = {
     {"size", required_argument, NULL, 's'},
+    {"seed", required_argument, NULL, 'S'},
 
     {"rot", required_argument, NULL, 'r'},
     {"srot", required_argument, NULL, 't'},
@@ -169,12 +173,18 @@ static void parse_cmd(int argc, char* argv[])
     switch (c)
     {
     case 's': // size
-      if (sscanf(optarg, "%hu,%hu", &db::default_environment.size_x,
+      if (sscanf(optarg, "%u,%u", &db::default_environment.size_x,
                  &db::default_environment.size_y) != 2)
         usage(boost::str(boost::format("Invalid value for --size (%1%)")
                          % optarg));
       break;
 
+    case 'S': // seed
+      if (sscanf(optarg, "%u", &db::default_environment.seed) != 1)
+        usage(boost::str(boost::format("Invalid value for --seed (%1%)")
+                         % optarg));
+      break;
+
     case 'r': // rot
       if (sscanf(optarg, "%d", &db::default_environment.time_rot) != 1)
         usage(boost::str(boost::format("Invalid value for --rot (%1%)")
@@ -344,6 +354,7 @@ static void parse_cmd(int argc, char* argv[])
  */
 void sw_create(int argc, char* argv[])
 {
+  db::default_environment.seed = std::time(NULL);
   parse_cmd(argc, argv);
 
   db::DB::create(database_path);
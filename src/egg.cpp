@@ -28,6 +28,7 @@
 #include <simpleworld/types.hpp>
 #include <simpleworld/simpleworld.hpp>
 #include <simpleworld/world.hpp>
+#include <simpleworld/random.hpp>
 #include <simpleworld/worlderror.hpp>
 #include <simpleworld/cpu/memory_file.hpp>
 namespace sw = simpleworld;
@@ -124,7 +125,7 @@ static void parse_cmd(int argc, char* argv[])
     switch (c)
     {
     case 'p': // position
-      if (sscanf(optarg, "%hu,%hu", &position.x, &position.y) != 2)
+      if (sscanf(optarg, "%u,%u", &position.x, &position.y) != 2)
         usage(boost::str(boost::format("Invalid value for --position (%1%)")
                          % optarg));
       break;
@@ -181,15 +182,17 @@ void sw_egg(int argc, char* argv[])
 {
   parse_cmd(argc, argv);
   sw::SimpleWorld simpleworld(database_path);
+  sw::Random random(simpleworld.env().seed(), 0, simpleworld.env().time(),
+                    sw::RandomCommand);
 
   // set a random position and orientation as the default
   try {
-    position = simpleworld.world().unused_position();
+    position = simpleworld.world().unused_position(&random);
   } catch (const sw::WorldError&) {
     std::cerr << "Can't add food because the world is full" << std::endl;
     std::exit(1);
   }
-  orientation = sw::World::random_orientation();
+  orientation = sw::World::random_orientation(&random);
 
   parse_cmd(argc, argv);
   simpleworld.add_egg(energy, position, orientation,
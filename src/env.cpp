@@ -395,7 +395,8 @@ void sw_env(int argc, char* argv[])
 
   db::Environment::insert(&simpleworld, simpleworld.env().time(),
                           simpleworld.env().size_x(),
-                          simpleworld.env().size_y(), rot, srot,
+                          simpleworld.env().size_y(),
+                          simpleworld.env().seed(), rot, srot,
                           mutations, birth, old, laziness, elaziness,
                           multiplier, tnothing, tmyself, tdetect, tinfo,
                           tmove, tturn, tattack, teat, tegg, nothing, myself,
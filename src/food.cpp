@@ -28,6 +28,7 @@
 #include <simpleworld/types.hpp>
 #include <simpleworld/simpleworld.hpp>
 #include <simpleworld/world.hpp>
+#include <simpleworld/random.hpp>
 #include <simpleworld/worlderror.hpp>
 namespace sw = simpleworld;
 
@@ -115,7 +116,7 @@ static void parse_cmd(int argc, char* argv[])
     switch (c)
     {
     case 'p': // position
-      if (sscanf(optarg, "%hu,%hu", &position.x, &position.y) != 2)
+      if (sscanf(optarg, "%u,%u", &position.x, &position.y) != 2)
         usage(boost::str(boost::format("Invalid value for --position (%1%)")
                          % optarg));
       break;
@@ -159,10 +160,12 @@ void sw_food(int argc, char* argv[])
 {
   parse_cmd(argc, argv);
   sw::SimpleWorld simpleworld(database_path);
+  sw::Random random(simpleworld.env().seed(), 0, simpleworld.env().time(),
+                    sw::RandomCommand);
 
   // set a random position as the default
   try {
-    position = simpleworld.world().unused_position();
+    position = simpleworld.world().unused_position(&random);
   } catch (const sw::WorldError&) {
     std::cerr << "Can't add food because the world is full" << std::endl;
     std::exit(1);
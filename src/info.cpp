@@ -299,8 +299,7 @@ static void parse_cmd(int argc, char* argv[])
  */
 static void show_env(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT time, size_x, size_y,\n\
        time_rot, size_rot, mutations_probability, time_birth, time_mutate,\n\
        time_laziness, energy_laziness, attack_multiplier,\n\
@@ -309,10 +308,9 @@ SELECT time, size_x, size_y,\n\
 FROM Environment\n\
 WHERE id = (SELECT max(id)\n\
             FROM Environment)\n\
-ORDER BY id;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+ORDER BY id;");
   show_query_line(true, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -321,13 +319,11 @@ ORDER BY id;", -1, &stmt, NULL))
  */
 static void show_spawns(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT id, frequency, max, start_x, start_y, end_x, end_y, energy\n\
-FROM Spawn;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+FROM Spawn;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -336,13 +332,11 @@ FROM Spawn;", -1, &stmt, NULL))
  */
 static void show_resources(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT id, frequency, max, start_x, start_y, end_x, end_y, size\n\
-FROM Resource;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+FROM Resource;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -351,14 +345,12 @@ FROM Resource;", -1, &stmt, NULL))
  */
 static void show_bugs(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT *\n\
 FROM AliveBug\n\
-ORDER BY bug_id;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+ORDER BY bug_id;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -367,14 +359,12 @@ ORDER BY bug_id;", -1, &stmt, NULL))
  */
 static void show_eggs(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT *\n\
 FROM Egg\n\
-ORDER BY bug_id;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+ORDER BY bug_id;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -383,14 +373,12 @@ ORDER BY bug_id;", -1, &stmt, NULL))
  */
 static void show_foods(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT *\n\
 FROM Food\n\
-ORDER BY id;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+ORDER BY id;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -399,15 +387,13 @@ ORDER BY id;", -1, &stmt, NULL))
  */
 static void show_stats(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT time, alive, eggs, food, energy, mutations, age,\n\
        last_births, last_sons, last_deaths, last_kills, last_mutations\n\
 FROM Stats\n\
-ORDER BY id;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+ORDER BY id;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -416,14 +402,12 @@ ORDER BY id;", -1, &stmt, NULL))
  */
 static void show_sortenergy(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT bug_id, energy\n\
 FROM AliveBug\n\
-ORDER BY energy DESC, bug_id;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+ORDER BY energy DESC, bug_id;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -432,17 +416,15 @@ ORDER BY energy DESC, bug_id;", -1, &stmt, NULL))
  */
 static void show_sortage(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT bug_id, (SELECT max(time) FROM Environment) - birth AS age\n\
 FROM AliveBug\n\
 UNION\n\
 SELECT bug_id, death - birth AS age\n\
 FROM DeadBug\n\
-ORDER BY age DESC, bug_id;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+ORDER BY age DESC, bug_id;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -451,16 +433,14 @@ ORDER BY age DESC, bug_id;", -1, &stmt, NULL))
  */
 static void show_sortsons(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT father_id, count(father_id) AS sons\n\
 FROM Bug\n\
 WHERE father_id IS NOT NULL\n\
 GROUP BY father_id\n\
-ORDER BY sons DESC;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+ORDER BY sons DESC;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -469,16 +449,14 @@ ORDER BY sons DESC;", -1, &stmt, NULL))
  */
 static void show_sortkills(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT killer_id, count(killer_id) AS kills\n\
 FROM DeadBug\n\
 WHERE killer_id IS NOT NULL\n\
 GROUP BY killer_id\n\
-ORDER BY kills DESC, killer_id;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+ORDER BY kills DESC, killer_id;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -487,15 +465,13 @@ ORDER BY kills DESC, killer_id;", -1, &stmt, NULL))
  */
 static void show_sortmutations(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT bug_id, count(position) AS mutations\n\
 FROM Mutation\n\
 GROUP BY bug_id\n\
-ORDER BY mutations DESC, id;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+ORDER BY mutations DESC, id;");
   show_query_column(true, 10, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -504,15 +480,13 @@ ORDER BY mutations DESC, id;", -1, &stmt, NULL))
  */
 static void show_food(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT *\n\
 FROM Food\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, food_id);
   show_query_line(true, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -521,15 +495,13 @@ WHERE id = ?;", -1, &stmt, NULL))
  */
 static void show_bug(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SELECT *\n\
 FROM AliveBug\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, bug_id);
   show_query_line(true, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -561,23 +533,21 @@ Bug[%1%] not found")
  */
 static bool bug_father(sw::SimpleWorld& sw, db::ID bug, db::ID* father)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
+  sqlite3_stmt* stmt = sw.prepare("\
 SSELECT father_id\n\
 FROM Bug\n\
-WHERE id = ?;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+WHERE id = ?;");
   sqlite3_bind_int64(stmt, 1, bug);
   switch(sqlite3_step(stmt)) {
   case SQLITE_DONE:
-    sqlite3_finalize(stmt);
+    sqlite3_reset(stmt);
     return false;
   case SQLITE_ROW:
     *father = sqlite3_column_int64(stmt, 0);
-    sqlite3_finalize(stmt);
+    sqlite3_reset(stmt);
     return true;
   default:
-    sqlite3_finalize(stmt);
+    sqlite3_reset(stmt);
     throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
   }
 }
@@ -667,12 +637,10 @@ static void show_mutations(sw::SimpleWorld& sw)
  */
 static void show_version(sw::SimpleWorld& sw)
 {
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(sw.db(), "\
-PRAGMA user_version;", -1, &stmt, NULL))
-    throw EXCEPTION(db::DBException, sqlite3_errmsg(sw.db()));
+  sqlite3_stmt* stmt = sw.prepare("\
+PRAGMA user_version;");
   show_query_line(true, "NULL", stmt);
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 }
 
 /**
@@ -25,6 +25,7 @@
 
 #include <boost/format.hpp>
 
+#include <simpleworld/config.hpp>
 #include <simpleworld/types.hpp>
 #include <simpleworld/simpleworld.hpp>
 namespace sw = simpleworld;
@@ -34,6 +35,8 @@ namespace sw = simpleworld;
 
 // Default values
 #define DEFAULT_CYCLES 1024
+#define DEFAULT_THREADS 0
+#define DEFAULT_CHECKPOINT_EVERY 0
 #define DEFAULT_VERBOSE 0
 
 
@@ -62,9 +65,17 @@ static void help()
 "Usage: %1% run [OPTION]... [DATABASE]\n\
 Execute some cycles in the World.\n\
 If the number of cycles are not specified, the default are 1024 cycles.\n\
+If the number of threads are not specified, one by processor is used.\n\
+With --memory the World runs in a copy of the database in memory that is\n\
+written to the file at the end, and every --checkpoint-every cycles rounded\n\
+up to a transaction of %3% cycles.\n\
 \n\
 Mandatory arguments to long options are mandatory for short options too.\n\
       --cycles=CYCLES        cycles to run\n\
+      --threads=THREADS      threads used to execute the bugs\n\
+      --memory               keep the database in memory\n\
+      --checkpoint-every=CYCLES\n\
+                             cycles between the writes of the database\n\
 \n\
   -h, --help                 display this help and exit\n\
 \n\
@@ -73,6 +84,7 @@ Exit status is 0 if OK, 1 if minor problems, 2 if serious trouble.\n\
 Report bugs to <%2%>.")
     % program_short_name
     % program_mailbugs
+    % CYCLES_BY_TRANSACTION
     << std::endl;
   std::exit(EXIT_SUCCESS);
 }
@@ -82,6 +94,9 @@ Report bugs to <%2%>.")
 static std::string database_path;
 
 static sw::Time cycles = DEFAULT_CYCLES;
+static unsigned threads = DEFAULT_THREADS;
+static bool memory = false;
+static sw::Time checkpoint_every = DEFAULT_CHECKPOINT_EVERY;
 
 /**
  * Parse the command line.
@@ -92,6 +107,9 @@ static void parse_cmd(int argc, char* argv[])
 {
   struct option long_options[] = {
     {"cycles", required_argument, NULL, 'c'},
+    {"threads", required_argument, NULL, 't'},
+    {"memory", no_argument, NULL, 'm'},
+    {"checkpoint-every", required_argument, NULL, 'k'},
 
     {"help", no_argument, NULL, 'h'},
 
@@ -117,6 +135,23 @@ static void parse_cmd(int argc, char* argv[])
                          % optarg));
       break;
 
+    case 't': // threads
+      if (sscanf(optarg, "%u", &threads) != 1)
+        usage(boost::str(boost::format("Invalid value for --threads (%1%)")
+                         % optarg));
+      break;
+
+    case 'm': // memory
+      memory = true;
+      break;
+
+    case 'k': // checkpoint-every
+      if (sscanf(optarg, "%u", &checkpoint_every) != 1)
+        usage(boost::str(boost::format("\
+Invalid value for --checkpoint-every (%1%)")
+                         % optarg));
+      break;
+
     case 'h':
       help();
       break;
@@ -133,6 +168,9 @@ static void parse_cmd(int argc, char* argv[])
     }
   }
 
+  if (checkpoint_every > 0 and not memory)
+    usage("--checkpoint-every needs --memory");
+
   if (argc == optind)
     usage("a database file is needed");
   else if ((optind + 1) < argc)
@@ -151,6 +189,8 @@ void sw_run(int argc, char* argv[])
 {
   parse_cmd(argc, argv);
 
-  sw::SimpleWorld simpleworld(database_path);
+  sw::SimpleWorld simpleworld(database_path, memory);
+  simpleworld.threads(threads);
+  simpleworld.checkpoint_every(checkpoint_every);
   simpleworld.run(cycles);
 }
@@ -21,7 +21,6 @@
 #include <iostream>
 #include <string>
 #include <cstdlib>
-#include <ctime>
 #include <cstring>
 
 #include <getopt.h>
@@ -170,8 +169,6 @@ static void parse_cmd(int argc, char* argv[])
 
 int main(int argc, char* argv[])
 try {
-  std::srand(std::time(NULL));
-
   if (argc < 2)
     usage("no command specified");
   else
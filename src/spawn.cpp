@@ -95,7 +95,7 @@ Report bugs to <%2%>.")
 static std::string database_path;
 
 static sw::Time frequency = DEFAULT_FREQUENCY;
-static sw::Uint16 max;
+static sw::Uint32 max;
 static sw::Position start;
 static sw::Position end;
 static sw::Energy energy = DEFAULT_ENERGY;
@@ -140,17 +140,17 @@ static void parse_cmd(int argc, char* argv[])
                          % optarg));
       break;
     case 'm': // max
-      if (sscanf(optarg, "%hu", &max) != 1)
+      if (sscanf(optarg, "%u", &max) != 1)
         usage(boost::str(boost::format("Invalid value for --max (%1%)")
                          % optarg));
       break;
     case 's': // start
-      if (sscanf(optarg, "%hu,%hu", &start.x, &start.y) != 2)
+      if (sscanf(optarg, "%u,%u", &start.x, &start.y) != 2)
         usage(boost::str(boost::format("Invalid value for --start (%1%)")
                          % optarg));
       break;
     case 'e': // end
-      if (sscanf(optarg, "%hu,%hu", &end.x, &end.y) != 2)
+      if (sscanf(optarg, "%u,%u", &end.x, &end.y) != 2)
         usage(boost::str(boost::format("Invalid value for --end (%1%)")
                          % optarg));
       break;
@@ -200,7 +200,7 @@ void sw_spawn(int argc, char* argv[])
 {
   parse_cmd(argc, argv);
   sw::SimpleWorld simpleworld(database_path);
-  sw::World world(simpleworld.world());
+  const sw::World& world(simpleworld.world());
 
   // set max, start and end as the default
   start.x = 0;
@@ -38,11 +38,10 @@ namespace cpu = simpleworld::cpu;
  * @exception FileAccessError problem with the file.
  */
 CPU::CPU(const std::string& filename) throw ()
-  : cpu::CPU(fakeisa, &this->registers_, &this->memory_),
+  : cpu::CPU(fakeisa, &this->registers_memory_, &this->memory_),
     cpu::Object(cpu::CPU::isa_, filename),
-    memory_(filename, &last_access)
+    memory_(filename), last_access(0)
 {
-  this->registers_.resize(TOTAL_REGISTERS * sizeof(cpu::Word));
 }
 
 /**
@@ -58,13 +57,21 @@ void CPU::next()
       << std::endl;
   } catch (const cpu::CPUException& e) {
     std::cout << boost::str(boost::format("Instruction[0x%08X]: 0x%08X")
-                            % this->registers_[ADDRESS(REGISTER_PC)]
-                            % this->memory_[this->registers_[ADDRESS(REGISTER_PC)]])
+                            % this->get_reg(REGISTER_PC)
+                            % this->memory_[this->get_reg(REGISTER_PC)])
               << std::endl;
   }
 
 
+  // the pages are shared with the copy until they are written
+  cpu::Memory before(this->memory_);
   cpu::CPU::next();
+  for (cpu::Address addr = 0;
+       addr + sizeof(cpu::Word) <= this->memory_.size();
+       addr += sizeof(cpu::Word))
+    if (not this->memory_.shares_page(before, addr / MEMORY_PAGE_SIZE) and
+        this->memory_[addr] != before[addr])
+      this->last_access = addr;
 
   sw::Uint8 i = 1;
   std::vector<sw::Uint8> regs_codes = cpu::CPU::isa_.register_codes();
@@ -85,13 +92,13 @@ void CPU::next()
   // Show the stack (the data between the fp and the sp).
   // If the sp is 0, then (suppose) the stack is not initialized.
   // If the fp is 0, then (suppose) the code is not in a function.
-  if (this->registers_[REGISTER_SP * sizeof(cpu::Word)] != 0 and
-      this->registers_[REGISTER_FP * sizeof(cpu::Word)] != 0 and
-      this->registers_[REGISTER_SP * sizeof(cpu::Word)] !=
-      this->registers_[REGISTER_FP * sizeof(cpu::Word)]) {
+  if (this->get_reg(REGISTER_SP) != 0 and
+      this->get_reg(REGISTER_FP) != 0 and
+      this->get_reg(REGISTER_SP) !=
+      this->get_reg(REGISTER_FP)) {
     std::cout << "Stack:" << std::endl;
-    for (cpu::Address addr = this->registers_[REGISTER_SP * sizeof(cpu::Word)];
-         addr > this->registers_[REGISTER_FP * sizeof(cpu::Word)];
+    for (cpu::Address addr = this->get_reg(REGISTER_SP);
+         addr > this->get_reg(REGISTER_FP);
          addr -= sizeof(cpu::Word))
       std::cout << boost::str(boost::format("0x%08X") %
                               this->memory_[addr - 4])
@@ -25,17 +25,26 @@
 
 #include <simpleworld/cpu/types.hpp>
 #include <simpleworld/cpu/memory.hpp>
+#include <simpleworld/cpu/memory_file.hpp>
 #include <simpleworld/cpu/object.hpp>
 #include <simpleworld/cpu/cpu.hpp>
 namespace cpu = simpleworld::cpu;
 
-#include "memoryfile.hpp"
+
+/**
+ * Registers of the CPU.
+ * They must be constructed before cpu::CPU, so they are in a base class.
+ */
+struct CPURegisters
+{
+  cpu::Memory registers_memory_;
+};
 
 
 /**
  * FakeCPU subclass that shows information about the execution.
  */
-class CPU: public cpu::CPU, cpu::Object
+class CPU: private CPURegisters, public cpu::CPU, cpu::Object
 {
 public:
   /**
@@ -52,10 +61,9 @@ public:
   void next();
 
 protected:
-  cpu::Memory registers_;
-  MemoryFile memory_;
+  cpu::MemoryFile memory_;
 
-  cpu::Address last_access;
+  cpu::Address last_access;     /**< Last address changed */
 };
 
 #endif // CPU_HPP
@@ -29,6 +29,7 @@
 #include <simpleworld/ints.hpp>
 #include <simpleworld/cpu/types.hpp>
 #include <simpleworld/cpu/memory.hpp>
+#include <simpleworld/cpu/memoryerror.hpp>
 #include <simpleworld/cpu/isa.hpp>
 #include <simpleworld/cpu/cpu.hpp>
 #include <simpleworld/cpu/source.hpp>
@@ -923,6 +924,115 @@ BOOST_AUTO_TEST_CASE(cpu_interrupt)
   BOOST_CHECK_EQUAL(memory[ADDRESS(data) + 0x10], 0x4);
 }
 
+/**
+ * Check the data of the interrupt of a fault and the critical faults.
+ */
+BOOST_AUTO_TEST_CASE(cpu_fault)
+{
+  cpu::Source source(cpu::isa);
+  cpu::Source::size_type line = 0;
+
+  source.insert(line++, "loada sp stack");
+  source.insert(line++, "loada ip interrupts_table");
+
+  // Invalid memory location
+  source.insert(line++, "loadi g0 0xfff0");
+  sw::Uint8 fault = line;
+  source.insert(line++, "storeri g0 g0 0x4");
+  source.insert(line++, "stop");
+
+  // Interrupt handler
+  // Store the address of the instruction and the address of the memory,
+  // then raise a interrupt without stack
+  source.insert(line++, ".label handler");
+  source.insert(line++, "loada g0 data");
+  source.insert(line++, "storeri g0 g1 0x0");
+  source.insert(line++, "storeri g0 g2 0x4");
+  source.insert(line++, "loadi sp 0xfff0");
+  source.insert(line++, "divi g0 g0 0x0");
+
+  // Space to store 2 words of data
+  sw::Uint8 data = line - 1;
+  source.insert(line++, ".label data");
+  source.insert(line++, ".block 0x8");
+
+  // Space for the 16 words in the stack
+  source.insert(line++, ".label stack");
+  source.insert(line++, ".block 0x40");
+
+  // Interrupts table
+  source.insert(line++, ".label interrupts_table");
+  source.insert(line++, "handler");   // Timer interrupt
+  source.insert(line++, "handler");   // Software interrupt
+  source.insert(line++, "handler");   // Invalid instruction
+  source.insert(line++, "handler");   // Invalid memory location
+  source.insert(line++, "handler");   // Division by zero
+
+  cpu::Memory registers;
+  cpu::Memory memory;
+  source.compile(&memory);
+  cpu::CPU cpu(cpu::isa, &registers, &memory);
+
+  // The interrupt of the fault in the handler can't be thrown
+  BOOST_CHECK_THROW(cpu.execute(), cpu::MemoryError);
+
+  BOOST_CHECK_EQUAL(memory[ADDRESS(data)], ADDRESS(fault));
+  BOOST_CHECK_EQUAL(memory[ADDRESS(data) + 0x4], 0xfff4);
+}
+
+/**
+ * Check the fault of a register out of range in the data of a instruction.
+ */
+BOOST_AUTO_TEST_CASE(cpu_fault_register)
+{
+  cpu::Source source(cpu::isa);
+  cpu::Source::size_type line = 0;
+
+  source.insert(line++, "loada sp stack");
+  source.insert(line++, "loada ip interrupts_table");
+
+  // The third register is changed to 0xff after the compilation
+  sw::Uint8 fault = line;
+  source.insert(line++, "add g0 g0 g0");
+  source.insert(line++, "stop");
+
+  // Interrupt handler
+  // Store the address of the instruction and the address of the register
+  source.insert(line++, ".label handler");
+  source.insert(line++, "loada g0 data");
+  source.insert(line++, "storeri g0 g1 0x0");
+  source.insert(line++, "storeri g0 g2 0x4");
+  source.insert(line++, "stop");
+
+  // Space to store 2 words of data
+  sw::Uint8 data = line - 1;
+  source.insert(line++, ".label data");
+  source.insert(line++, ".block 0x8");
+
+  // Space for the 16 words in the stack
+  source.insert(line++, ".label stack");
+  source.insert(line++, ".block 0x40");
+
+  // Interrupts table
+  source.insert(line++, ".label interrupts_table");
+  source.insert(line++, "handler");   // Timer interrupt
+  source.insert(line++, "handler");   // Software interrupt
+  source.insert(line++, "handler");   // Invalid instruction
+  source.insert(line++, "handler");   // Invalid memory location
+  source.insert(line++, "handler");   // Division by zero
+
+  cpu::Memory registers;
+  cpu::Memory memory;
+  source.compile(&memory);
+  memory.set_halfword(ADDRESS(fault) + 0x2, 0xff);
+  cpu::CPU cpu(cpu::isa, &registers, &memory);
+
+  cpu.execute();
+
+  BOOST_CHECK_EQUAL(memory[ADDRESS(data)], ADDRESS(fault));
+  BOOST_CHECK_EQUAL(memory[ADDRESS(data) + 0x4], ADDRESS(0xff));
+}
+
 /**
  * Check if the frame pointer works.
  */
@@ -1376,3 +1486,75 @@ BOOST_AUTO_TEST_CASE(cpu_windows)
   BOOST_CHECK_EQUAL(registers[REGISTER(cpu, "g0")], 0x10AB);
   BOOST_CHECK_EQUAL(registers[REGISTER(cpu, "r1")], 0x0f0f);
 }
+
+/**
+ * Check that the decoded instructions are discarded when the code changes.
+ */
+BOOST_AUTO_TEST_CASE(cpu_modified_code)
+{
+  cpu::Source source(cpu::isa);
+  cpu::Source::size_type line = 0;
+
+  source.insert(line++, "loadi g0 0x1");
+  source.insert(line++, "stop");
+  // Instructions used to replace the first one
+  source.insert(line++, "loadi g0 0x2");
+  source.insert(line++, "loadi g0 0x3");
+
+  cpu::Memory registers;
+  cpu::Memory memory;
+  source.compile(&memory);
+  cpu::CPU cpu(cpu::isa, &registers, &memory);
+  cpu.execute(1);
+  BOOST_CHECK_EQUAL(registers[REGISTER(cpu, "g0")], 0x1);
+
+  // Changed by the CPU
+  cpu.set_mem(ADDRESS(0), cpu.get_mem(ADDRESS(2)));
+  cpu.set_reg(REGISTER_PC, ADDRESS(0));
+  cpu.execute(1);
+  BOOST_CHECK_EQUAL(registers[REGISTER(cpu, "g0")], 0x2);
+
+  // Changed without using the CPU
+  memory.set_word(ADDRESS(0), memory.get_word(ADDRESS(3)));
+  cpu.invalidate_cache();
+  cpu.set_reg(REGISTER_PC, ADDRESS(0));
+  cpu.execute(1);
+  BOOST_CHECK_EQUAL(registers[REGISTER(cpu, "g0")], 0x3);
+}
+
+/**
+ * Share the decoded instructions between two CPUs with the same code.
+ */
+BOOST_AUTO_TEST_CASE(cpu_shared_code)
+{
+  cpu::Source source(cpu::isa);
+  cpu::Source::size_type line = 0;
+
+  source.insert(line++, "loadi g0 0x1");
+  source.insert(line++, "stop");
+  // Instructions used to replace the first one
+  source.insert(line++, "loadi g0 0x2");
+
+  cpu::Memory code;
+  source.compile(&code);
+  boost::shared_ptr<cpu::CPU::DecodedCode> decoded(new cpu::CPU::DecodedCode);
+  cpu::CPU::decode(cpu::isa, code, decoded.get());
+  BOOST_CHECK_EQUAL(decoded->size(), 3);
+
+  cpu::Memory registers1;
+  cpu::Memory memory1(code);
+  cpu::CPU cpu1(cpu::isa, &registers1, &memory1);
+  cpu1.share_cache(decoded);
+  cpu::Memory registers2;
+  cpu::Memory memory2(code);
+  cpu::CPU cpu2(cpu::isa, &registers2, &memory2);
+  cpu2.share_cache(decoded);
+
+  // The code changed by a CPU is only changed in its memory
+  cpu1.set_mem(ADDRESS(0), cpu1.get_mem(ADDRESS(2)));
+  cpu1.execute(1);
+  cpu2.execute(1);
+  BOOST_CHECK_EQUAL(registers1[REGISTER(cpu1, "g0")], 0x2);
+  BOOST_CHECK_EQUAL(registers2[REGISTER(cpu2, "g0")], 0x1);
+  BOOST_CHECK_EQUAL((*decoded)[0].instruction.data, 0x1);
+}
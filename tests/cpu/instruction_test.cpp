@@ -69,3 +69,16 @@ BOOST_AUTO_TEST_CASE(instruction_decode)
   BOOST_CHECK_EQUAL(inst.second, 0x4);
   BOOST_CHECK_EQUAL(inst.data, 0x5678);
 }
+
+/**
+ * Decode a instruction in the system endianness.
+ */
+BOOST_AUTO_TEST_CASE(instruction_decode_system_endian)
+{
+  cpu::Instruction inst(0x12345678, true);
+
+  BOOST_CHECK_EQUAL(inst.code, 0x12);
+  BOOST_CHECK_EQUAL(inst.first, 0x3);
+  BOOST_CHECK_EQUAL(inst.second, 0x4);
+  BOOST_CHECK_EQUAL(inst.data, 0x5678);
+}
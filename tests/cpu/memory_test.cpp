@@ -22,6 +22,8 @@
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <simpleworld/config.hpp>
 #include <simpleworld/ints.hpp>
 #include <simpleworld/cpu/memoryerror.hpp>
@@ -225,3 +227,212 @@ BOOST_AUTO_TEST_CASE(memory_set_non_aligned_quarter)
 
   BOOST_CHECK_EQUAL(memory.get_word(0), 0x012345);
 }
+
+/**
+ * Inserting and erasing bytes.
+ */
+BOOST_AUTO_TEST_CASE(memory_insert_erase)
+{
+  cpu::Memory memory(2 * 4);
+  memory.set_word(0, 0x01234567);
+  memory.set_word(4, 0x89abcdef);
+
+  memory.insert(4, 4);
+  BOOST_CHECK_EQUAL(memory.size(), 3 * 4);
+  BOOST_CHECK_EQUAL(memory.get_word(0), 0x01234567);
+  BOOST_CHECK_EQUAL(memory.get_word(4), 0);
+  BOOST_CHECK_EQUAL(memory.get_word(8), 0x89abcdef);
+
+  memory.erase(0, 4);
+  BOOST_CHECK_EQUAL(memory.size(), 2 * 4);
+  BOOST_CHECK_EQUAL(memory.get_word(0), 0);
+  BOOST_CHECK_EQUAL(memory.get_word(4), 0x89abcdef);
+
+  BOOST_CHECK_THROW(memory.insert(9, 4), cpu::MemoryError);
+  BOOST_CHECK_THROW(memory.erase(6, 4), cpu::MemoryError);
+}
+
+/**
+ * Writing a copy of the memory.
+ */
+BOOST_AUTO_TEST_CASE(memory_copy_on_write)
+{
+  cpu::Memory memory(MEMORY_PAGE_SIZE * 2);
+  memory.set_word(0, 0x01234567);
+  memory.set_word(MEMORY_PAGE_SIZE, 0x89abcdef);
+
+  cpu::Memory copy(memory);
+  copy.set_word(0, 0x76543210);
+  BOOST_CHECK_EQUAL(memory.get_word(0), 0x01234567);
+  BOOST_CHECK_EQUAL(copy.get_word(0), 0x76543210);
+  BOOST_CHECK_EQUAL(copy.get_word(MEMORY_PAGE_SIZE), 0x89abcdef);
+
+  cpu::Memory other;
+  other.copy(memory);
+  memory.set_word(MEMORY_PAGE_SIZE, 0);
+  BOOST_CHECK_EQUAL(other.size(), memory.size());
+  BOOST_CHECK_EQUAL(other.get_word(MEMORY_PAGE_SIZE), 0x89abcdef);
+  BOOST_CHECK_EQUAL(memory.get_word(MEMORY_PAGE_SIZE), 0);
+}
+
+/**
+ * Getting and setting words between two pages.
+ */
+BOOST_AUTO_TEST_CASE(memory_between_pages)
+{
+  cpu::Memory memory(MEMORY_PAGE_SIZE * 2);
+  memory.set_word(MEMORY_PAGE_SIZE - 2, 0x01234567);
+  memory.set_halfword(MEMORY_PAGE_SIZE * 2 - 3, 0x89ab);
+
+  BOOST_CHECK_EQUAL(memory.get_word(MEMORY_PAGE_SIZE - 2), 0x01234567);
+  BOOST_CHECK_EQUAL(memory.get_halfword(MEMORY_PAGE_SIZE - 2), 0x0123);
+  BOOST_CHECK_EQUAL(memory.get_halfword(MEMORY_PAGE_SIZE), 0x4567);
+  BOOST_CHECK_EQUAL(memory.get_halfword(MEMORY_PAGE_SIZE * 2 - 3), 0x89ab);
+
+  sw::Uint8 bytes[4];
+  memory.read(bytes, 4, MEMORY_PAGE_SIZE - 2);
+  BOOST_CHECK_EQUAL(bytes[0], 0x01);
+  BOOST_CHECK_EQUAL(bytes[3], 0x67);
+  BOOST_CHECK_THROW(memory.read(bytes, 4, MEMORY_PAGE_SIZE * 2 - 3),
+                    cpu::MemoryError);
+}
+
+/**
+ * Inserting, erasing and resizing across pages.
+ */
+BOOST_AUTO_TEST_CASE(memory_insert_erase_pages)
+{
+  cpu::Memory memory(MEMORY_PAGE_SIZE * 2);
+  for (cpu::Address i = 0; i < memory.size(); i += 4)
+    memory.set_word(i, i);
+  cpu::Memory original(memory);
+
+  memory.insert(MEMORY_PAGE_SIZE + 4, 8);
+  BOOST_CHECK_EQUAL(memory.size(), MEMORY_PAGE_SIZE * 2 + 8);
+  BOOST_CHECK_EQUAL(memory.get_word(MEMORY_PAGE_SIZE), MEMORY_PAGE_SIZE);
+  BOOST_CHECK_EQUAL(memory.get_word(MEMORY_PAGE_SIZE + 4), 0);
+  BOOST_CHECK_EQUAL(memory.get_word(MEMORY_PAGE_SIZE + 8), 0);
+  BOOST_CHECK_EQUAL(memory.get_word(MEMORY_PAGE_SIZE * 2 + 4),
+                    MEMORY_PAGE_SIZE * 2 - 4);
+
+  memory.erase(4, MEMORY_PAGE_SIZE + 4);
+  BOOST_CHECK_EQUAL(memory.size(), MEMORY_PAGE_SIZE + 4);
+  BOOST_CHECK_EQUAL(memory.get_word(0), 0);
+  BOOST_CHECK_EQUAL(memory.get_word(4), 0);
+  BOOST_CHECK_EQUAL(memory.get_word(8), MEMORY_PAGE_SIZE + 4);
+
+  // the bytes removed by a resize are zeroed if the memory grows again
+  memory.resize(4);
+  memory.resize(8);
+  BOOST_CHECK_EQUAL(memory.get_word(4), 0);
+
+  for (cpu::Address i = 0; i < original.size(); i += 4)
+    BOOST_CHECK_EQUAL(original.get_word(i), i);
+}
+
+/**
+ * Inserting and erasing bytes of any size in any address, compared with
+ * a vector of bytes.
+ */
+BOOST_AUTO_TEST_CASE(memory_insert_erase_any)
+{
+  const cpu::Address addresses[] = {0, 5, 8, MEMORY_PAGE_SIZE,
+                                    MEMORY_PAGE_SIZE + 6};
+  const cpu::Address sizes[] = {3, 4, MEMORY_PAGE_SIZE, MEMORY_PAGE_SIZE + 4,
+                                MEMORY_PAGE_SIZE * 2 + 1};
+
+  for (unsigned a = 0; a < sizeof(addresses) / sizeof(addresses[0]); a++)
+    for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+      std::vector<sw::Uint8> bytes(MEMORY_PAGE_SIZE * 3 - 8);
+      for (std::size_t i = 0; i < bytes.size(); i++)
+        bytes[i] = i * 7 + 1;
+      cpu::Memory memory(&bytes[0], bytes.size());
+      cpu::Memory original(memory);
+
+      cpu::Address address = addresses[a];
+      cpu::Address size = sizes[s];
+      memory.insert(address, size);
+      bytes.insert(bytes.begin() + address, size, 0);
+      std::vector<sw::Uint8> result(memory.size());
+      memory.read(&result[0], memory.size());
+      BOOST_CHECK(result == bytes);
+
+      memory.erase(address + 1, size);
+      bytes.erase(bytes.begin() + address + 1,
+                  bytes.begin() + address + 1 + size);
+      result.resize(memory.size());
+      memory.read(&result[0], memory.size());
+      BOOST_CHECK(result == bytes);
+
+      // the bytes after the end are zeroed
+      memory.resize(memory.size() + 8);
+      BOOST_CHECK_EQUAL(memory.get_word(memory.size() - 8), 0);
+      BOOST_CHECK_EQUAL(memory.get_word(memory.size() - 4), 0);
+
+      for (cpu::Address i = 0; i < original.size(); i++)
+        BOOST_CHECK_EQUAL(original.get_quarterword(i),
+                          static_cast<sw::Uint8>(i * 7 + 1));
+    }
+}
+
+/**
+ * Inserting and erasing whole pages in a page boundary keeps the pages
+ * after them.
+ */
+BOOST_AUTO_TEST_CASE(memory_insert_erase_whole_pages)
+{
+  cpu::Memory memory(MEMORY_PAGE_SIZE * 3);
+  memory.set_word(MEMORY_PAGE_SIZE * 2, 0x01234567);
+
+  memory.insert(MEMORY_PAGE_SIZE, MEMORY_PAGE_SIZE * 2);
+  cpu::Memory copy(memory);
+  memory.erase(MEMORY_PAGE_SIZE, MEMORY_PAGE_SIZE * 2);
+  memory.insert(MEMORY_PAGE_SIZE, MEMORY_PAGE_SIZE * 2);
+  BOOST_CHECK_EQUAL(memory.get_word(MEMORY_PAGE_SIZE * 4), 0x01234567);
+  BOOST_CHECK(memory.shares_page(copy, 0));
+  BOOST_CHECK(memory.shares_page(copy, 4));
+  BOOST_CHECK(not memory.shares_page(copy, 1));
+}
+
+/**
+ * Finding the pages written after a copy.
+ */
+BOOST_AUTO_TEST_CASE(memory_shares_page)
+{
+  cpu::Memory memory(MEMORY_PAGE_SIZE * 3);
+  cpu::Memory copy(memory);
+  BOOST_CHECK(memory.shares_page(copy, 0));
+  BOOST_CHECK(memory.shares_page(copy, 2));
+  BOOST_CHECK(not memory.shares_page(copy, 3));
+
+  memory.set_quarterword(MEMORY_PAGE_SIZE + 1, 0x01);
+  BOOST_CHECK(memory.shares_page(copy, 0));
+  BOOST_CHECK(not memory.shares_page(copy, 1));
+  BOOST_CHECK(memory.shares_page(copy, 2));
+  BOOST_CHECK_EQUAL(copy.get_quarterword(MEMORY_PAGE_SIZE + 1), 0);
+}
+
+/**
+ * Reading and writing the bytes in big endian.
+ */
+BOOST_AUTO_TEST_CASE(memory_read_write_big_endian)
+{
+  const sw::Uint8 data[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab};
+  cpu::Memory memory(data, sizeof(data));
+  BOOST_CHECK_EQUAL(memory.get_word(0), 0x01234567);
+  BOOST_CHECK_EQUAL(memory.get_halfword(4), 0x89ab);
+  BOOST_CHECK_EQUAL(memory.get_word(2), 0x456789ab);
+  BOOST_CHECK_EQUAL(memory.get_quarterword(1), 0x23);
+
+  memory.set_word(0, 0x76543210);
+  memory.set_quarterword(5, 0xcd);
+  sw::Uint8 bytes[sizeof(data)];
+  memory.read(bytes, sizeof(bytes));
+  BOOST_CHECK_EQUAL(bytes[0], 0x76);
+  BOOST_CHECK_EQUAL(bytes[3], 0x10);
+  BOOST_CHECK_EQUAL(bytes[4], 0x89);
+  BOOST_CHECK_EQUAL(bytes[5], 0xcd);
+
+  memory.write(data + 1, 2, 1);
+  BOOST_CHECK_EQUAL(memory.get_word(0), 0x76234510);
+}
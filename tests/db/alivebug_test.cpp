@@ -110,8 +110,7 @@ BOOST_AUTO_TEST_CASE(alivebug_insert_egg)
   world_id2 = db::World::insert(&sw, 13, 2);
   db::ID code_id = db::Code::insert(&sw, "code", 4);
   bug_id2 = db::Bug::insert(&sw, code_id, 0);
-  db::ID egg_id = db::Egg::insert(&sw, bug_id2, world_id2, 74,
-				  db::Code::insert(&sw, code_id));
+  db::ID egg_id = db::Egg::insert(&sw, bug_id2, world_id2, 74, code_id);
   db::Egg egg(&sw, egg_id);
   id2 = db::AliveBug::insert(&sw, &egg, 25);
   db::AliveBug alivebug(&sw, id2);
@@ -158,6 +157,40 @@ BOOST_AUTO_TEST_CASE(alivebug_update)
   transaction.commit();
 }
 
+/**
+ * Update several columns at once.
+ */
+BOOST_AUTO_TEST_CASE(alivebug_update_columns)
+{
+  db::DB sw = open_db(DB_SAVE);
+  db::Transaction transaction(&sw, db::Transaction::deferred);
+  db::AliveBug alivebug(&sw, id1);
+  db::ID memory_id = db::Code::insert(&sw, "edoc", 4);
+
+  alivebug.update(db::AliveBug::ColumnEnergy |
+                  db::AliveBug::ColumnActionTime, 87, 0, false, 0, true, 0);
+  BOOST_CHECK_EQUAL(alivebug.energy(), 87);
+  BOOST_CHECK_EQUAL(alivebug.is_null("time_last_action"), false);
+  BOOST_CHECK_EQUAL(alivebug.time_last_action(), 0);
+  BOOST_CHECK_EQUAL(alivebug.is_null("action_time"), true);
+
+  alivebug.update(db::AliveBug::ColumnTimeLastAction |
+                  db::AliveBug::ColumnActionTime |
+                  db::AliveBug::ColumnMemoryId,
+                  0, 0, true, 63, false, memory_id);
+  BOOST_CHECK_EQUAL(alivebug.energy(), 87);
+  BOOST_CHECK_EQUAL(alivebug.is_null("time_last_action"), true);
+  BOOST_CHECK_EQUAL(alivebug.is_null("action_time"), false);
+  BOOST_CHECK_EQUAL(alivebug.action_time(), 63);
+  BOOST_CHECK_EQUAL(alivebug.memory_id(), memory_id);
+
+  // nothing is written without columns
+  BOOST_CHECK_NO_THROW(alivebug.update(0, 0, 0, false, 0, false, 0));
+  BOOST_CHECK_EQUAL(alivebug.energy(), 87);
+
+  transaction.commit();
+}
+
 /**
  * Delete the data.
  */
@@ -29,6 +29,8 @@
 #include <simpleworld/db/transaction.hpp>
 #include <simpleworld/db/types.hpp>
 #include <simpleworld/db/code.hpp>
+#include <simpleworld/db/bug.hpp>
+#include <simpleworld/db/egg.hpp>
 namespace sw = simpleworld;
 namespace db = simpleworld::db;
 
@@ -99,6 +101,86 @@ BOOST_AUTO_TEST_CASE(code_get)
   BOOST_CHECK_EQUAL(data[7], 0x90);
 }
 
+/**
+ * Get the size and the references without loading the data.
+ */
+BOOST_AUTO_TEST_CASE(code_size_refs)
+{
+  db::DB sw(DB_FILE);
+
+  BOOST_CHECK_EQUAL(db::Code(&sw, 1).size(), 8);
+  BOOST_CHECK_EQUAL(db::Code(&sw, 1).refs(), 2);
+  BOOST_CHECK_EQUAL(db::Code(&sw, 3).size(), 8);
+  BOOST_CHECK_EQUAL(db::Code(&sw, 3).refs(), 1);
+  BOOST_CHECK(db::Code(&sw, 1).hash() != db::Code(&sw, 2).hash());
+}
+
+/**
+ * The same data is stored only once.
+ */
+BOOST_AUTO_TEST_CASE(code_insert_same)
+{
+  db::DB sw(DB_FILE);
+  db::Transaction transaction(&sw, db::Transaction::deferred);
+  sw::Uint8 code[8] = { 0xAB, 0xAB, 0xAB, 0xAB, 0xAB, 0xAB, 0xAB, 0xAB };
+
+  BOOST_CHECK_EQUAL(db::Code::insert(&sw, code, sizeof(code)), 1);
+  BOOST_CHECK(db::Code::insert(&sw, code, sizeof(code) - 4) != 1);
+  BOOST_CHECK_EQUAL(db::Code(&sw, 1).refs(), 2);
+
+  transaction.rollback();
+}
+
+/**
+ * The references are counted and the code is deleted when it isn't used.
+ */
+BOOST_AUTO_TEST_CASE(code_refs)
+{
+  db::DB sw(DB_FILE);
+  db::Transaction transaction(&sw, db::Transaction::deferred);
+
+  // the code 4 is used by the bug 3 and its egg
+  db::Egg::remove(&sw, 3);
+  BOOST_CHECK_EQUAL(db::Code(&sw, 4).refs(), 1);
+  db::Bug(&sw, 3).code_id(3);
+  BOOST_CHECK_EQUAL(db::Code(&sw, 3).refs(), 2);
+  BOOST_CHECK_THROW(db::Code(&sw, 4).refs(), db::DBException);
+
+  transaction.rollback();
+}
+
+/**
+ * The data is copied on write if it's shared.
+ */
+BOOST_AUTO_TEST_CASE(code_copy_on_write)
+{
+  db::DB sw(DB_FILE);
+  db::Transaction transaction(&sw, db::Transaction::deferred);
+  sw::Uint8 data[4] = { 0x01, 0x02, 0x03, 0x04 };
+
+  // the code 1 is used by the spawn 1 and the bug 1
+  db::Code shared(&sw, 1);
+  db::ID copy = shared.update(data, sizeof(data));
+  BOOST_CHECK(copy != 1);
+  BOOST_CHECK_EQUAL(shared.id(), copy);
+  BOOST_CHECK_EQUAL(db::Code(&sw, 1).size(), 8);
+  BOOST_CHECK_EQUAL(db::Code(&sw, copy).size(), 4);
+
+  // the code 3 is only used by the alive bug 1
+  db::Code code(&sw, 3);
+  data[0] = 0x05;
+  BOOST_CHECK_EQUAL(code.update(data, sizeof(data)), 3);
+  BOOST_CHECK_EQUAL(code.size(), 4);
+
+  // the code 3 has now the same data than the copy
+  data[0] = 0x01;
+  BOOST_CHECK_EQUAL(code.update(data, sizeof(data)), copy);
+  BOOST_CHECK_EQUAL(code.hash(), db::Code(&sw, copy).hash());
+
+  transaction.rollback();
+}
+
+
 db::ID id;
 
 /**
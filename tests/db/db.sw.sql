@@ -1,5 +1,5 @@
 PRAGMA foreign_keys=OFF;
-PRAGMA user_version=6;
+PRAGMA user_version=9;
 
 BEGIN TRANSACTION;
 
@@ -12,6 +12,8 @@ CREATE TABLE Environment
   size_x INTEGER NOT NULL,
   size_y INTEGER NOT NULL,
 
+  seed INTEGER NOT NULL,                -- Seed of the random numbers
+
   time_rot INTEGER NOT NULL,
   size_rot INTEGER NOT NULL,
 
@@ -46,6 +48,7 @@ CREATE TABLE Environment
   PRIMARY KEY(id),
   CHECK(time >= 0),
   CHECK(size_x > 0 AND size_y > 0),
+  CHECK(seed >= 0),
   CHECK(time_rot >= 0),
   CHECK(size_rot >= 0),
   CHECK(mutations_probability >= 0 AND mutations_probability <= 1),
@@ -83,10 +86,15 @@ CREATE TABLE World
 CREATE TABLE Code(
   id INTEGER NOT NULL,
 
+  hash INTEGER NOT NULL,
+  size INTEGER NOT NULL,
+  refs INTEGER NOT NULL DEFAULT 0,
+
   data BLOB NOT NULL,
 
   PRIMARY KEY(id),
-  CHECK(length(data) > 0 AND (length(data) % 4 = 0))
+  CHECK(length(data) > 0 AND (length(data) % 4 = 0)),
+  CHECK(refs >= 0)
 );
 
 CREATE TABLE Spawn(
@@ -167,7 +175,6 @@ CREATE TABLE Egg
   FOREIGN KEY(world_id) REFERENCES World(id) ON UPDATE CASCADE ON DELETE CASCADE,
   FOREIGN KEY(memory_id) REFERENCES Code(id) ON UPDATE CASCADE ON DELETE CASCADE,
   UNIQUE(world_id),
-  UNIQUE(memory_id),
   CHECK(energy > 0)
 );
 
@@ -175,9 +182,11 @@ CREATE TABLE Registers(
   id INTEGER NOT NULL,
 
   data BLOB NOT NULL,
+  running INTEGER NOT NULL DEFAULT 1,
 
   PRIMARY KEY(id),
-  CHECK(length(data) = 544)
+  CHECK(length(data) = 544),
+  CHECK(running IN (0, 1))
 );
 
 CREATE TABLE AliveBug
@@ -201,7 +210,6 @@ CREATE TABLE AliveBug
   FOREIGN KEY(memory_id) REFERENCES Code(id) ON UPDATE CASCADE ON DELETE CASCADE,
   UNIQUE(world_id),
   UNIQUE(registers_id),
-  UNIQUE(memory_id),
   CHECK(time_last_action IS NULL OR time_last_action >= 0),
   CHECK(action_time IS NULL OR action_time > 0),
   CHECK(birth >= 0),
@@ -302,14 +310,14 @@ CREATE TABLE Stats
   CHECK(last_mutations >= 0)
 );
 
-INSERT INTO "Environment" VALUES(1,200,16,16,1024,16,0.001,32,16384,1024,16,2.5,1,2,2,2,3,3,4,4,4,0,1,1,1,2,2,3,3,4);
+INSERT INTO "Environment" VALUES(1,200,16,16,12345,1024,16,0.001,32,16384,1024,16,2.5,1,2,2,2,3,3,4,4,4,0,1,1,1,2,2,3,3,4);
 INSERT INTO "World" VALUES(1,2,3,0);
 INSERT INTO "World" VALUES(2,11,11,2);
 INSERT INTO "World" VALUES(3,1,7,NULL);
-INSERT INTO "Code" VALUES(1,X'ABABABABABABABAB');
-INSERT INTO "Code" VALUES(2,X'BABABABABABABABA');
-INSERT INTO "Code" VALUES(3,X'1234567890ABCDEF');
-INSERT INTO "Code" VALUES(4,X'1A2B3C4D5E6F7890');
+INSERT INTO "Code" VALUES(1,-8633535273307836963,8,2,X'ABABABABABABABAB');
+INSERT INTO "Code" VALUES(2,-5166708545944096027,8,2,X'BABABABABABABABA');
+INSERT INTO "Code" VALUES(3,-6154872267656712556,8,1,X'1234567890ABCDEF');
+INSERT INTO "Code" VALUES(4,9137698223836070930,8,2,X'1A2B3C4D5E6F7890');
 INSERT INTO "Spawn" VALUES(1,1,1024,12,1,1,5,6,512);
 INSERT INTO "Spawn" VALUES(2,2,4096,16,4,5,8,9,1024);
 INSERT INTO "Resource" VALUES(1,512,10,0,0,16,16,64);
@@ -317,7 +325,7 @@ INSERT INTO "Bug" VALUES(1,1,1,NULL);
 INSERT INTO "Bug" VALUES(2,2,101,NULL);
 INSERT INTO "Bug" VALUES(3,4,200,1);
 INSERT INTO "Egg" VALUES(3,1,100,4);
-INSERT INTO "Registers" VALUES(1,X'00000000111111112222222233333333444444445555555566666666777777770000000000000001000000020000000300000004000000050000000600000007000000000000000100000002000000030000000400000005000000060000000700000000000000010000000200000003000000040000000500000006000000070000000000000001000000020000000300000004000000050000000600000007000000000000000100000002000000030000000400000005000000060000000700000000000000010000000200000003000000040000000500000006000000070000000000000001000000020000000300000004000000050000000600000007000000000000000100000002000000030000000400000005000000060000000700000000000000010000000200000003000000040000000500000006000000070000000000000001000000020000000300000004000000050000000600000007000000000000000100000002000000030000000400000005000000060000000700000000000000010000000200000003000000040000000500000006000000070000000000000001000000020000000300000004000000050000000600000007000000000000000100000002000000030000000400000005000000060000000700000000000000010000000200000003000000040000000500000006000000070000000000000001000000020000000300000004000000050000000600000007');
+INSERT INTO "Registers" VALUES(1,X'00000000111111112222222233333333444444445555555566666666777777770000000000000001000000020000000300000004000000050000000600000007000000000000000100000002000000030000000400000005000000060000000700000000000000010000000200000003000000040000000500000006000000070000000000000001000000020000000300000004000000050000000600000007000000000000000100000002000000030000000400000005000000060000000700000000000000010000000200000003000000040000000500000006000000070000000000000001000000020000000300000004000000050000000600000007000000000000000100000002000000030000000400000005000000060000000700000000000000010000000200000003000000040000000500000006000000070000000000000001000000020000000300000004000000050000000600000007000000000000000100000002000000030000000400000005000000060000000700000000000000010000000200000003000000040000000500000006000000070000000000000001000000020000000300000004000000050000000600000007000000000000000100000002000000030000000400000005000000060000000700000000000000010000000200000003000000040000000500000006000000070000000000000001000000020000000300000004000000050000000600000007',1);
 INSERT INTO "AliveBug" VALUES(1,2,75,126,189,NULL,1,3);
 INSERT INTO "DeadBug" VALUES(2,100,150,1);
 INSERT INTO "Mutation" VALUES(1,3,50,0,0,1,2);
@@ -330,6 +338,7 @@ INSERT INTO "Food" VALUES(1,2,3,10);
 INSERT INTO "Stats" VALUES(1,1024,90,100,40,32,10000,5,10240,100,10,105,99,20);
 
 CREATE INDEX Environment_index ON Environment(time);
+CREATE INDEX Code_index ON Code(hash);
 CREATE INDEX Bug_index ON Bug(father_id);
 CREATE INDEX DeadBug_index ON DeadBug(killer_id);
 CREATE INDEX Mutation_index ON Mutation(bug_id);
@@ -622,4 +631,158 @@ BEGIN
   WHERE id = OLD.registers_id;
 END;
 
+CREATE TRIGGER Code_update_refs
+AFTER UPDATE OF refs
+ON Code
+FOR EACH ROW
+WHEN NEW.refs = 0
+BEGIN
+  DELETE FROM Code
+  WHERE id = NEW.id;
+END;
+
+CREATE TRIGGER Spawn_insert_code_id
+AFTER INSERT
+ON Spawn
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.code_id;
+END;
+
+CREATE TRIGGER Spawn_delete_code_id
+AFTER DELETE
+ON Spawn
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.code_id;
+END;
+
+CREATE TRIGGER Spawn_update_code_id
+AFTER UPDATE OF code_id
+ON Spawn
+FOR EACH ROW
+WHEN EXISTS(SELECT 1
+            FROM Code
+            WHERE id = OLD.code_id)
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.code_id;
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.code_id;
+END;
+
+CREATE TRIGGER Bug_insert_code_id
+AFTER INSERT
+ON Bug
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.code_id;
+END;
+
+CREATE TRIGGER Bug_delete_code_id
+AFTER DELETE
+ON Bug
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.code_id;
+END;
+
+CREATE TRIGGER Bug_update_code_id
+AFTER UPDATE OF code_id
+ON Bug
+FOR EACH ROW
+WHEN EXISTS(SELECT 1
+            FROM Code
+            WHERE id = OLD.code_id)
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.code_id;
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.code_id;
+END;
+
+CREATE TRIGGER Egg_insert_memory_id
+AFTER INSERT
+ON Egg
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.memory_id;
+END;
+
+CREATE TRIGGER Egg_delete_memory_id
+AFTER DELETE
+ON Egg
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.memory_id;
+END;
+
+CREATE TRIGGER Egg_update_memory_id
+AFTER UPDATE OF memory_id
+ON Egg
+FOR EACH ROW
+WHEN EXISTS(SELECT 1
+            FROM Code
+            WHERE id = OLD.memory_id)
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.memory_id;
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.memory_id;
+END;
+
+CREATE TRIGGER AliveBug_insert_memory_id
+AFTER INSERT
+ON AliveBug
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.memory_id;
+END;
+
+CREATE TRIGGER AliveBug_delete_memory_id
+AFTER DELETE
+ON AliveBug
+FOR EACH ROW
+BEGIN
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.memory_id;
+END;
+
+CREATE TRIGGER AliveBug_update_memory_id
+AFTER UPDATE OF memory_id
+ON AliveBug
+FOR EACH ROW
+WHEN EXISTS(SELECT 1
+            FROM Code
+            WHERE id = OLD.memory_id)
+BEGIN
+  UPDATE Code
+  SET refs = refs + 1
+  WHERE id = NEW.memory_id;
+  UPDATE Code
+  SET refs = refs - 1
+  WHERE id = OLD.memory_id;
+END;
+
 COMMIT;
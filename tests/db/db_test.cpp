@@ -25,6 +25,7 @@
 #include <simpleworld/ints.hpp>
 #include <simpleworld/db/types.hpp>
 #include <simpleworld/db/db.hpp>
+#include <simpleworld/db/environment.hpp>
 namespace sw = simpleworld;
 namespace db = simpleworld::db;
 
@@ -115,3 +116,23 @@ BOOST_AUTO_TEST_CASE(db_food)
   BOOST_CHECK_EQUAL(food.size(), 1);
   BOOST_CHECK_EQUAL(food[0], 1);
 }
+
+/**
+ * Keep the database in memory until the checkpoint.
+ */
+BOOST_AUTO_TEST_CASE(db_memory)
+{
+  db::DB file = open_db(DB_SAVE);
+  db::ID env = file.last_environment();
+  sw::Time time = db::Environment(&file, env).time();
+
+  db::DB sw(DB_SAVE, true);
+  BOOST_CHECK(sw.memory());
+  BOOST_CHECK(not file.memory());
+  db::Environment(&sw, env).time(time + 1);
+  BOOST_CHECK_EQUAL(db::Environment(&sw, env).time(), time + 1);
+  BOOST_CHECK_EQUAL(db::Environment(&file, env).time(), time);
+
+  sw.checkpoint();
+  BOOST_CHECK_EQUAL(db::Environment(&file, env).time(), time + 1);
+}
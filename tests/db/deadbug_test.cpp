@@ -122,7 +122,7 @@ BOOST_AUTO_TEST_CASE(deadbug_insert_egg)
   db::ID world_id1 = db::World::insert(&sw, 1, 1, sw::OrientationNorth);
   db::ID code_id = db::Code::insert(&sw, "code", 4);
   db::ID id1 = db::Bug::insert(&sw, code_id, 0);
-  db::Egg::insert(&sw, id1, world_id1, 1000, db::Code::insert(&sw, code_id));
+  db::Egg::insert(&sw, id1, world_id1, 1000, code_id);
   db::Egg egg1(&sw, id1);
   db::DeadBug::insert(&sw, &egg1, 100);
   db::DeadBug deadbug1(&sw, id1);
@@ -136,7 +136,7 @@ BOOST_AUTO_TEST_CASE(deadbug_insert_egg)
 
   db::ID world_id2 = db::World::insert(&sw, 1, 1, sw::OrientationNorth);
   db::ID id2 = db::Bug::insert(&sw, code_id, 0);
-  db::Egg::insert(&sw, id2, world_id2, 1000, db::Code::insert(&sw, code_id));
+  db::Egg::insert(&sw, id2, world_id2, 1000, code_id);
   db::Egg egg2(&sw, id2);
   db::DeadBug::insert(&sw, &egg2, 100, 1);
   db::DeadBug deadbug2(&sw, id2);
@@ -163,8 +163,7 @@ BOOST_AUTO_TEST_CASE(deadbug_insert_alivebug)
   db::ID code_id = db::Code::insert(&sw, "code", 4);
   db::ID id1 = db::Bug::insert(&sw, code_id, 0);
   db::ID registers_id = db::Registers::insert(&sw);
-  db::AliveBug::insert(&sw, id1, world_id1, 0, 134, registers_id,
-		       db::Code::insert(&sw, code_id));
+  db::AliveBug::insert(&sw, id1, world_id1, 0, 134, registers_id, code_id);
   db::AliveBug alive1(&sw, id1);
   db::DeadBug::insert(&sw, &alive1, 100);
   db::DeadBug deadbug1(&sw, id1);
@@ -183,8 +182,7 @@ BOOST_AUTO_TEST_CASE(deadbug_insert_alivebug)
   db::ID id2 = db::Bug::insert(&sw, code_id, 0);
   registers_id = db::Registers::insert(&sw);
   code_id = db::Code::insert(&sw, "code", 4);
-  db::AliveBug::insert(&sw, id2, world_id2, 100, 12, registers_id,
-		       db::Code::insert(&sw, code_id));
+  db::AliveBug::insert(&sw, id2, world_id2, 100, 12, registers_id, code_id);
   db::AliveBug alive2(&sw, id2);
   db::DeadBug::insert(&sw, &alive2, 150, 1);
   db::DeadBug deadbug2(&sw, id2);
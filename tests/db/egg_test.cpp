@@ -68,7 +68,6 @@ BOOST_AUTO_TEST_CASE(egg_insert)
   world_id = db::World::insert(&sw, 4, 3, sw::OrientationNorth);
   db::ID code_id = db::Code::insert(&sw, "code", 4);
   db::ID bug_id = db::Bug::insert(&sw, code_id, 0);
-  code_id = db::Code::insert(&sw, code_id);
   id = db::Egg::insert(&sw, bug_id, world_id, 101, code_id);
   db::Egg egg(&sw, id);
 
@@ -91,7 +90,7 @@ BOOST_AUTO_TEST_CASE(egg_update)
   db::Transaction transaction(&sw, db::Transaction::deferred);
   db::Egg egg(&sw, id);
   egg.energy(82);
-  db::ID code_id = db::Code::insert(&sw, egg.memory_id());
+  db::ID code_id = egg.memory_id();
   egg.memory_id(code_id);
 
   BOOST_CHECK_EQUAL(egg.bug_id(), id);
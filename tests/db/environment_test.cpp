@@ -50,6 +50,7 @@ BOOST_AUTO_TEST_CASE(environment_get)
   BOOST_CHECK_EQUAL(environment.time(), 200);
   BOOST_CHECK_EQUAL(environment.size_x(), 16);
   BOOST_CHECK_EQUAL(environment.size_y(), 16);
+  BOOST_CHECK_EQUAL(environment.seed(), 12345);
   BOOST_CHECK_EQUAL(environment.time_rot(), 1024);
   BOOST_CHECK_EQUAL(environment.size_rot(), 16);
   BOOST_CHECK_EQUAL(environment.mutations_probability(), 0.001);
@@ -87,15 +88,16 @@ BOOST_AUTO_TEST_CASE(environment_insert)
 {
   db::DB sw = open_db(DB_SAVE);
   db::Transaction transaction(&sw, db::Transaction::deferred);
-  id = db::Environment::insert(&sw, 100, 16, 16, 4096, 8, 0.01, 16, 65536,
-                               2048, 32, 3.0, 2, 3, 3, 3, 4, 4, 5, 5, 5,
-                               1, 2, 2, 2, 3, 3, 4, 4, 5);
+  id = db::Environment::insert(&sw, 100, 16, 16, 54321, 4096, 8, 0.01, 16,
+                               65536, 2048, 32, 3.0, 2, 3, 3, 3, 4, 4, 5, 5,
+                               5, 1, 2, 2, 2, 3, 3, 4, 4, 5);
   db::Environment environment(&sw, id);
 
   BOOST_CHECK_EQUAL(environment.id(), id);
   BOOST_CHECK_EQUAL(environment.time(), 100);
   BOOST_CHECK_EQUAL(environment.size_x(), 16);
   BOOST_CHECK_EQUAL(environment.size_y(), 16);
+  BOOST_CHECK_EQUAL(environment.seed(), 54321);
   BOOST_CHECK_EQUAL(environment.time_rot(), 4096);
   BOOST_CHECK_EQUAL(environment.size_rot(), 8);
   BOOST_CHECK_EQUAL(environment.mutations_probability(), 0.01);
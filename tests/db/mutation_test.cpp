@@ -22,6 +22,8 @@
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 #include <simpleworld/ints.hpp>
 #include <simpleworld/db/types.hpp>
 #include <simpleworld/db/exception.hpp>
@@ -196,6 +198,44 @@ BOOST_AUTO_TEST_CASE(mutation_insert)
   transaction.commit();
 }
 
+/**
+ * Insert several mutations at once.
+ */
+BOOST_AUTO_TEST_CASE(mutation_insert_several)
+{
+  db::DB sw = open_db(DB_SAVE);
+  db::Transaction transaction(&sw, db::Transaction::deferred);
+  db::ID first = db::Mutation::insert_mutation(&sw, bug_id, 7, 0, 1, 2);
+
+  // more rows than the ones inserted by a statement
+  std::vector<db::Mutation::Data> mutations;
+  for (sw::Uint32 i = 0; i < 150; i++) {
+    db::Mutation::Data mutation = {static_cast<db::Mutation::Type>(i % 6),
+                                   i * 4, i, i + 1};
+    mutations.push_back(mutation);
+  }
+  db::Mutation::insert(&sw, bug_id, 8, mutations);
+
+  for (sw::Uint32 i = 0; i < 150; i++) {
+    db::Mutation mutation(&sw, first + 1 + i);
+    BOOST_CHECK_EQUAL(mutation.bug_id(), bug_id);
+    BOOST_CHECK_EQUAL(mutation.time(), 8);
+    BOOST_CHECK_EQUAL(mutation.type(), mutations[i].type);
+    BOOST_CHECK_EQUAL(mutation.position(), i * 4);
+    if (mutations[i].type == db::Mutation::Addition or
+        mutations[i].type == db::Mutation::Duplication)
+      BOOST_CHECK_EQUAL(mutation.is_null("original"), true);
+    else
+      BOOST_CHECK_EQUAL(mutation.original(), i);
+    if (mutations[i].type == db::Mutation::Deletion)
+      BOOST_CHECK_EQUAL(mutation.is_null("mutated"), true);
+    else
+      BOOST_CHECK_EQUAL(mutation.mutated(), i + 1);
+  }
+
+  transaction.commit();
+}
+
 
 /**
  * Update the data.
@@ -27,6 +27,7 @@
 #include <simpleworld/db/exception.hpp>
 #include <simpleworld/db/db.hpp>
 #include <simpleworld/db/transaction.hpp>
+#include <simpleworld/db/environment.hpp>
 #include <simpleworld/db/resource.hpp>
 namespace sw = simpleworld;
 namespace db = simpleworld::db;
@@ -109,6 +110,30 @@ BOOST_AUTO_TEST_CASE(resource_update)
   transaction.commit();
 }
 
+/**
+ * The max and the coords bigger than 2^31 - 1 are not changed.
+ */
+BOOST_AUTO_TEST_CASE(resource_big)
+{
+  db::DB sw = open_db(DB_SAVE);
+  db::Transaction transaction(&sw, db::Transaction::deferred);
+  db::Environment environment(&sw, sw.last_environment());
+  environment.size_x(4000000000U);
+  environment.size_y(4000000000U);
+  db::ID big = db::Resource::insert(&sw, 1024, 4000000000U,
+                                    3000000000U, 3000000000U,
+                                    3500000000U, 3500000000U, 128);
+
+  db::Resource resource(&sw, big);
+  BOOST_CHECK_EQUAL(resource.max(), 4000000000U);
+  BOOST_CHECK_EQUAL(resource.start_x(), 3000000000U);
+  BOOST_CHECK_EQUAL(resource.start_y(), 3000000000U);
+  BOOST_CHECK_EQUAL(resource.end_x(), 3500000000U);
+  BOOST_CHECK_EQUAL(resource.end_y(), 3500000000U);
+
+  transaction.rollback();
+}
+
 /**
  * Delete the data.
  */
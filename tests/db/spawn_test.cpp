@@ -27,6 +27,7 @@
 #include <simpleworld/db/exception.hpp>
 #include <simpleworld/db/db.hpp>
 #include <simpleworld/db/transaction.hpp>
+#include <simpleworld/db/environment.hpp>
 #include <simpleworld/db/code.hpp>
 #include <simpleworld/db/spawn.hpp>
 namespace sw = simpleworld;
@@ -128,6 +129,31 @@ BOOST_AUTO_TEST_CASE(spawn_update)
   transaction.commit();
 }
 
+/**
+ * The max and the coords bigger than 2^31 - 1 are not changed.
+ */
+BOOST_AUTO_TEST_CASE(spawn_big)
+{
+  db::DB sw = open_db(DB_SAVE);
+  db::Transaction transaction(&sw, db::Transaction::deferred);
+  db::Environment environment(&sw, sw.last_environment());
+  environment.size_x(4000000000U);
+  environment.size_y(4000000000U);
+  db::ID code_id = db::Code::insert(&sw, "1234", 4);
+  db::ID big = db::Spawn::insert(&sw, code_id, 1024, 4000000000U,
+                                 3000000000U, 3000000000U,
+                                 3500000000U, 3500000000U, 512);
+
+  db::Spawn spawn(&sw, big);
+  BOOST_CHECK_EQUAL(spawn.max(), 4000000000U);
+  BOOST_CHECK_EQUAL(spawn.start_x(), 3000000000U);
+  BOOST_CHECK_EQUAL(spawn.start_y(), 3000000000U);
+  BOOST_CHECK_EQUAL(spawn.end_x(), 3500000000U);
+  BOOST_CHECK_EQUAL(spawn.end_y(), 3500000000U);
+
+  transaction.rollback();
+}
+
 /**
  * Delete the data.
  */
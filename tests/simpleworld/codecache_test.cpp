@@ -0,0 +1,90 @@
+/**
+ * @file tests/simpleworld/codecache_test.cpp
+ * Unit test for CodeCache.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Unit test for CodeCache
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+
+#include <boost/format.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <sqlite3.h>
+
+#include <simpleworld/isa.hpp>
+#include <simpleworld/codecache.hpp>
+#include <simpleworld/db/db.hpp>
+#include <simpleworld/db/code.hpp>
+namespace sw = simpleworld;
+namespace db = simpleworld::db;
+
+
+#define DB_FILE (TESTOUTPUT "codecache.sw")
+
+
+/**
+ * Create a empty database.
+ */
+static void create_db()
+{
+  std::remove(DB_FILE);
+  db::DB::create(DB_FILE);
+}
+
+
+/**
+ * The code is loaded only once.
+ */
+BOOST_AUTO_TEST_CASE(codecache_shared)
+{
+  create_db();
+  db::DB sw(DB_FILE);
+  db::ID id = db::Code::insert(&sw, "\x01\x02\x03\x04", 4);
+
+  sw::CodeCache cache(sw::isa);
+  boost::shared_ptr<const sw::CodeImage> image = cache.get(&sw, id);
+  BOOST_CHECK_EQUAL(image->memory.get_word(0), 0x01020304);
+  BOOST_CHECK(cache.get(&sw, id) == image);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+}
+
+/**
+ * Two codes with the same hash are not shared.
+ */
+BOOST_AUTO_TEST_CASE(codecache_collision)
+{
+  create_db();
+  db::DB sw(DB_FILE);
+  db::ID id1 = db::Code::insert(&sw, "\x01\x02\x03\x04", 4);
+  db::ID id2 = db::Code::insert(&sw, "\x05\x06\x07\x08", 4);
+  sqlite3_exec(sw.db(), boost::str(boost::format("\
+UPDATE Code SET hash = (SELECT hash FROM Code WHERE id = %1%) WHERE id = %2%;")
+                                   % id1 % id2).c_str(),
+               NULL, NULL, NULL);
+  BOOST_REQUIRE_EQUAL(db::Code(&sw, id1).hash(), db::Code(&sw, id2).hash());
+
+  sw::CodeCache cache(sw::isa);
+  boost::shared_ptr<const sw::CodeImage> image1 = cache.get(&sw, id1);
+  boost::shared_ptr<const sw::CodeImage> image2 = cache.get(&sw, id2);
+  BOOST_CHECK(image1 != image2);
+  BOOST_CHECK_EQUAL(image1->memory.get_word(0), 0x01020304);
+  BOOST_CHECK_EQUAL(image2->memory.get_word(0), 0x05060708);
+}
@@ -0,0 +1,196 @@
+/**
+ * @file tests/simpleworld/mutation_test.cpp
+ * Unit test for mutation.hpp.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Unit test for mutation.hpp
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+#include <simpleworld/random.hpp>
+#include <simpleworld/mutation.hpp>
+#include <simpleworld/cpu/types.hpp>
+#include <simpleworld/cpu/memory.hpp>
+#include <simpleworld/db/mutation.hpp>
+namespace sw = simpleworld;
+namespace cpu = simpleworld::cpu;
+namespace db = simpleworld::db;
+
+
+/**
+ * Without probability there are no mutations.
+ */
+BOOST_AUTO_TEST_CASE(mutation_plan_none)
+{
+  sw::Random random(0, 0, 0, sw::RandomMutation);
+  sw::MutationsList list;
+  cpu::Address size = 4096;
+
+  BOOST_CHECK(not sw::plan_mutations(&list, &size, 0.0, &random));
+  BOOST_CHECK(list.empty());
+  BOOST_CHECK_EQUAL(size, 4096);
+}
+
+/**
+ * With probability 1 all the words are mutated.
+ */
+BOOST_AUTO_TEST_CASE(mutation_plan_all)
+{
+  sw::Random random(0, 0, 0, sw::RandomMutation);
+  sw::MutationsList list;
+  cpu::Address size = 4096;
+
+  BOOST_CHECK(sw::plan_mutations(&list, &size, 1.0, &random));
+
+  // no word is skipped
+  cpu::Address address = 0;
+  for (sw::MutationsList::const_iterator mutation = list.begin();
+       mutation != list.end();
+       ++mutation) {
+    BOOST_REQUIRE_EQUAL(mutation->address, address);
+    if (mutation->type != db::Mutation::Deletion)
+      address += sizeof(cpu::Word);
+  }
+  BOOST_CHECK_EQUAL(address, size);
+}
+
+/**
+ * The number, type and position of the mutations follow the same
+ * distribution as a trial for each word.
+ */
+BOOST_AUTO_TEST_CASE(mutation_plan_distribution)
+{
+  const int trials = 2000;
+  const int words = 1024;
+  const double probability = 0.01;
+
+  double sum = 0;
+  double sum2 = 0;
+  int types[6] = {0, 0, 0, 0, 0, 0};
+  int first_half = 0;
+  int second_half = 0;
+  for (int trial = 0; trial < trials; trial++) {
+    sw::Random random(1, trial, 0, sw::RandomMutation);
+    sw::MutationsList list;
+    cpu::Address size = words * sizeof(cpu::Word);
+    sw::plan_mutations(&list, &size, probability, &random);
+
+    sum += list.size();
+    sum2 += list.size() * list.size();
+
+    // the address in the original code
+    cpu::Address shift = 0;
+    for (sw::MutationsList::const_iterator mutation = list.begin();
+         mutation != list.end();
+         ++mutation) {
+      switch (mutation->type) {
+      case db::Mutation::Total:
+        types[0]++;
+        break;
+      case db::Mutation::Partial:
+        types[1]++;
+        break;
+      case db::Mutation::Permutation:
+        types[2]++;
+        break;
+      case db::Mutation::Addition:
+        types[3]++;
+        break;
+      case db::Mutation::Duplication:
+        types[4]++;
+        break;
+      case db::Mutation::Deletion:
+        types[5]++;
+        break;
+      }
+
+      cpu::Address address = mutation->address - shift;
+      if (address < words * sizeof(cpu::Word) / 2)
+        first_half++;
+      else
+        second_half++;
+
+      if (mutation->type == db::Mutation::Addition or
+          mutation->type == db::Mutation::Duplication)
+        shift += sizeof(cpu::Word);
+      else if (mutation->type == db::Mutation::Deletion)
+        shift -= sizeof(cpu::Word);
+    }
+  }
+
+  // after a addition or a duplication the same word is checked again, so
+  // each word is mutated at least k times with probability p * r ** (k - 1)
+  double p = probability;
+  double r = probability / 3;
+  double mean = sum / trials;
+  double variance = sum2 / trials - mean * mean;
+  double expected = words * p / (1 - r);
+  double expected_variance = words * (p * (1 + r) / ((1 - r) * (1 - r)) -
+                                      (p / (1 - r)) * (p / (1 - r)));
+  BOOST_CHECK(std::fabs(mean - expected) <
+              5 * std::sqrt(expected_variance / trials));
+  BOOST_CHECK(std::fabs(variance - expected_variance) <
+              0.1 * expected_variance);
+
+  // the types are uniform (the duplications at 0 are additions)
+  double total = sum;
+  for (int type = 0; type < 6; type++)
+    BOOST_CHECK(std::fabs(types[type] - total / 6) <
+                5 * std::sqrt(total / 6));
+
+  // the positions are uniform
+  BOOST_CHECK(std::fabs(first_half - total / 2) < 5 * std::sqrt(total / 4));
+}
+
+/**
+ * Apply the mutations to a code.
+ */
+BOOST_AUTO_TEST_CASE(mutation_apply)
+{
+  sw::Random random(0, 0, 0, sw::RandomMutation);
+  cpu::Memory memory(4 * sizeof(cpu::Word));
+  for (cpu::Address i = 0; i < 4; i++)
+    memory.set_word(i * sizeof(cpu::Word), i + 1);
+  // the values of the mutations are in the byte order of the memory
+  cpu::Word three = memory.get_word(8, false);
+
+  // addresses of the code already mutated: 1 2 3 4 -> 1 2 2 3 4 -> 1 2 2 4
+  sw::MutationsList list;
+  sw::Mutation duplication = {db::Mutation::Duplication, 8, 0, 0};
+  sw::Mutation deletion = {db::Mutation::Deletion, 12, 0, 0};
+  sw::Mutation addition = {db::Mutation::Addition, 16, 0, 0};
+  list.push_back(duplication);
+  list.push_back(deletion);
+  list.push_back(addition);
+  sw::apply_mutations(&list, &memory, &random);
+
+  BOOST_REQUIRE_EQUAL(memory.size(), 5 * sizeof(cpu::Word));
+  BOOST_CHECK_EQUAL(memory.get_word(0), 1);
+  BOOST_CHECK_EQUAL(memory.get_word(4), 2);
+  BOOST_CHECK_EQUAL(memory.get_word(8), 2);
+  BOOST_CHECK_EQUAL(memory.get_word(12), 4);
+  BOOST_CHECK_EQUAL(memory.get_word(16, false), list.back().new_value);
+
+  BOOST_REQUIRE_EQUAL(list.size(), 3);
+  BOOST_CHECK_EQUAL(list.front().new_value, memory.get_word(8, false));
+  sw::MutationsList::const_iterator iter = list.begin();
+  ++iter;
+  BOOST_CHECK_EQUAL(iter->old_value, three);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file tests/simpleworld/random_test.cpp
+ * Unit test for random.hpp.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Unit test for random.hpp
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <simpleworld/ints.hpp>
+#include <simpleworld/random.hpp>
+namespace sw = simpleworld;
+
+
+/**
+ * The same key generates the same numbers.
+ */
+BOOST_AUTO_TEST_CASE(random_same_key)
+{
+  sw::Random a(1234, 5, 100, sw::RandomSpawn);
+  sw::Random b(1234, 5, 100, sw::RandomSpawn);
+
+  for (int i = 0; i < 100; i++)
+    BOOST_CHECK_EQUAL(a.next(), b.next());
+}
+
+/**
+ * Keys that only differ in one field generate different numbers.
+ */
+BOOST_AUTO_TEST_CASE(random_different_key)
+{
+  sw::Random random(1234, 5, 100, sw::RandomSpawn);
+  sw::Random seed(1235, 5, 100, sw::RandomSpawn);
+  sw::Random entity(1234, 6, 100, sw::RandomSpawn);
+  sw::Random cycle(1234, 5, 101, sw::RandomSpawn);
+  sw::Random purpose(1234, 5, 100, sw::RandomMutation);
+
+  sw::Uint32 number = random.next();
+  BOOST_CHECK(number != seed.next());
+  BOOST_CHECK(number != entity.next());
+  BOOST_CHECK(number != cycle.next());
+  BOOST_CHECK(number != purpose.next());
+}
+
+/**
+ * The integers are in the range and all the values are generated.
+ */
+BOOST_AUTO_TEST_CASE(random_integer)
+{
+  sw::Random random(0, 0, 0, sw::RandomCommand);
+  int count[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+  for (int i = 0; i < 10000; i++) {
+    sw::Uint32 n = random.integer(10, 20);
+    BOOST_REQUIRE(n >= 10 and n < 20);
+    count[n - 10]++;
+  }
+
+  // each value is expected 1000 times
+  for (int i = 0; i < 10; i++)
+    BOOST_CHECK(count[i] > 850 and count[i] < 1150);
+}
+
+/**
+ * The integers of 64 bits are in the range and they are the same as the
+ * integers of 32 bits if the range fits in 32 bits.
+ */
+BOOST_AUTO_TEST_CASE(random_integer64)
+{
+  sw::Random a(0, 0, 0, sw::RandomCommand);
+  sw::Random b(0, 0, 0, sw::RandomCommand);
+  for (int i = 0; i < 100; i++)
+    BOOST_CHECK_EQUAL(a.integer64(10, 20), b.integer(10, 20));
+
+  sw::Uint64 min = 0x100000000ULL, max = 0x300000000ULL;
+  bool high = false;
+  for (int i = 0; i < 1000; i++) {
+    sw::Uint64 n = a.integer64(min, max);
+    BOOST_REQUIRE(n >= min and n < max);
+    if (n >= 0x200000000ULL)
+      high = true;
+  }
+  BOOST_CHECK(high);
+}
+
+/**
+ * The reals are in the range [0, 1).
+ */
+BOOST_AUTO_TEST_CASE(random_real)
+{
+  sw::Random random(0, 0, 0, sw::RandomCommand);
+
+  for (int i = 0; i < 1000; i++) {
+    double n = random.real();
+    BOOST_REQUIRE(n >= 0.0 and n < 1.0);
+  }
+}
@@ -0,0 +1,193 @@
+/**
+ * @file tests/simpleworld/simpleworld_test.cpp
+ * Unit test for SimpleWorld.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Unit test for SimpleWorld
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <boost/filesystem.hpp>
+
+#include <simpleworld/types.hpp>
+#include <simpleworld/isa.hpp>
+#include <simpleworld/simpleworld.hpp>
+#include <simpleworld/cpu/memory.hpp>
+#include <simpleworld/cpu/source.hpp>
+#include <simpleworld/db/db.hpp>
+#include <simpleworld/db/default.hpp>
+#include <simpleworld/db/code.hpp>
+#include <simpleworld/db/spawn.hpp>
+#include <simpleworld/db/resource.hpp>
+#include <simpleworld/db/world.hpp>
+#include <simpleworld/db/bug.hpp>
+#include <simpleworld/db/alivebug.hpp>
+#include <simpleworld/db/deadbug.hpp>
+#include <simpleworld/db/egg.hpp>
+#include <simpleworld/db/food.hpp>
+namespace sw = simpleworld;
+namespace cpu = simpleworld::cpu;
+namespace db = simpleworld::db;
+
+
+#define DB_SINGLE (TESTOUTPUT "single.sw")
+#define DB_SPLIT (TESTOUTPUT "split.sw")
+
+
+/**
+ * Insert the code of a bug.
+ * @param db the database.
+ * @param source the source code.
+ * @return the id of the code.
+ */
+static db::ID insert_code(db::DB* db, cpu::Source* source)
+{
+  cpu::Memory memory;
+  source->add_include_path(INCLUDE_DIR);
+  source->compile(&memory);
+
+  std::vector<sw::Uint8> data(memory.size());
+  memory.read(&data[0], memory.size());
+  return db::Code::insert(db, &data[0], memory.size());
+}
+
+/**
+ * Create a World with bugs that move randomly and bugs that execute a
+ * stop instruction.
+ * @param filename the name of the file.
+ */
+static void create_world(std::string filename)
+{
+  std::remove(filename.c_str());
+  db::default_environment.size_x = 32;
+  db::default_environment.size_y = 32;
+  db::default_environment.seed = 2;
+  db::default_environment.mutations_probability = 0.01;
+  db::DB::create(filename);
+  db::DB world(filename);
+
+  cpu::Source brainless(sw::isa, INCLUDE_DIR "bugs/brainless/brainless.swl");
+  db::Spawn::insert(&world, insert_code(&world, &brainless),
+                    16, 20, 0, 0, 31, 31, 1000);
+
+  // the interrupts are thrown after the stop instruction, so the bug
+  // would turn if it was executed again
+  cpu::Source stop(sw::isa);
+  stop.insert(".include \"stdlib/world.swl\"");
+  stop.insert("loada sp stack");
+  stop.insert("loada ip interrupts_table");
+  stop.insert("world STD_MOVEFORWARD");
+  stop.insert("stop");
+  stop.insert(".label handler");
+  stop.insert("world STD_TURNLEFT");
+  stop.insert("b handler");
+  stop.insert(".label interrupts_table");
+  for (int i = 0; i < 8; i++)
+    stop.insert("handler");
+  stop.insert(".label stack");
+  stop.insert(".block 0x40");
+  db::Spawn::insert(&world, insert_code(&world, &stop),
+                    32, 10, 0, 0, 31, 31, 1000);
+
+  db::Resource::insert(&world, 2, 100, 0, 0, 31, 31, 200);
+}
+
+/**
+ * Describe the elements of a World.
+ * The ids of the code can be different, so the code is described by its
+ * hash.
+ * @param filename the name of the file.
+ * @return the description.
+ */
+static std::string describe_world(std::string filename)
+{
+  db::DB world(filename);
+  std::string description;
+
+  std::vector<db::ID> bugs = world.alive_bugs();
+  for (std::vector<db::ID>::const_iterator id = bugs.begin();
+       id != bugs.end();
+       ++id) {
+    db::AliveBug bug(&world, *id);
+    db::World position(&world, bug.world_id());
+    description += boost::str(boost::format("bug %1%: %2% (%3%, %4%) %5% "
+                                            "%6% %7%\n")
+                              % *id
+                              % bug.energy()
+                              % position.position_x()
+                              % position.position_y()
+                              % position.orientation()
+                              % db::Code(&world, bug.memory_id()).hash()
+                              % db::Bug(&world, *id).mutations().size());
+  }
+
+  std::vector<db::ID> dead = world.dead_bugs();
+  for (std::vector<db::ID>::const_iterator id = dead.begin();
+       id != dead.end();
+       ++id)
+    description += boost::str(boost::format("dead %1%: %2%\n")
+                              % *id
+                              % db::DeadBug(&world, *id).death());
+
+  std::vector<db::ID> eggs = world.eggs();
+  for (std::vector<db::ID>::const_iterator id = eggs.begin();
+       id != eggs.end();
+       ++id)
+    description += boost::str(boost::format("egg %1%: %2%\n")
+                              % *id
+                              % db::Egg(&world, *id).energy());
+
+  std::vector<db::ID> food = world.food();
+  for (std::vector<db::ID>::const_iterator id = food.begin();
+       id != food.end();
+       ++id)
+    description += boost::str(boost::format("food %1%: %2%\n")
+                              % *id
+                              % db::Food(&world, *id).size());
+
+  return description;
+}
+
+
+/**
+ * A run split in several runs gives the same World as a single run.
+ */
+BOOST_AUTO_TEST_CASE(simpleworld_split_run)
+{
+  // the same file is used for both runs because the code compiled is not
+  // always the same (the unused fields of the instructions)
+  create_world(DB_SINGLE);
+  std::remove(DB_SPLIT);
+  boost::filesystem::copy_file(DB_SINGLE, DB_SPLIT);
+
+  sw::SimpleWorld(DB_SINGLE).run(300);
+  sw::SimpleWorld(DB_SPLIT).run(100);
+  sw::SimpleWorld(DB_SPLIT).run(1);
+  sw::SimpleWorld(DB_SPLIT).run(99);
+  sw::SimpleWorld(DB_SPLIT).run(100);
+
+  std::string single = describe_world(DB_SINGLE);
+  BOOST_CHECK(not db::DB(DB_SINGLE).alive_bugs().empty());
+  BOOST_CHECK(not db::DB(DB_SINGLE).dead_bugs().empty());
+  BOOST_CHECK_EQUAL(single, describe_world(DB_SPLIT));
+}
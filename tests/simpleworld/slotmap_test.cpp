@@ -0,0 +1,174 @@
+/**
+ * @file tests/simpleworld/slotmap_test.cpp
+ * Unit test for slotmap.hpp.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Unit test for slotmap.hpp
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <simpleworld/slotmap.hpp>
+namespace sw = simpleworld;
+
+
+/**
+ * Value stored in the slot map.
+ */
+struct Value
+{
+  Value(int n) : n(n) {}
+
+  int n;
+  sw::SlotHandle slot;
+};
+
+/**
+ * Get the values of a slot map in the order they are visited.
+ * @param map the slot map.
+ * @return the values.
+ */
+static std::vector<int> values(const sw::SlotMap<Value>& map)
+{
+  std::vector<int> v;
+  for (sw::SlotMap<Value>::iterator i = map.begin(); i != map.end(); ++i)
+    v.push_back((*i)->n);
+
+  return v;
+}
+
+
+/**
+ * Insert and get values.
+ */
+BOOST_AUTO_TEST_CASE(slotmap_insert)
+{
+  sw::SlotMap<Value> map;
+  Value a(0), b(1), c(2);
+
+  BOOST_CHECK(map.empty());
+  sw::SlotHandle ha = map.insert(&a);
+  sw::SlotHandle hb = map.insert(&b);
+  sw::SlotHandle hc = map.insert(&c);
+
+  BOOST_CHECK_EQUAL(map.size(), 3);
+  BOOST_CHECK_EQUAL(map.get(ha), &a);
+  BOOST_CHECK_EQUAL(map.get(hb), &b);
+  BOOST_CHECK_EQUAL(map.get(hc), &c);
+  BOOST_CHECK_EQUAL(b.slot.index, hb.index);
+  BOOST_CHECK_EQUAL(b.slot.generation, hb.generation);
+
+  std::vector<int> v = values(map);
+  BOOST_REQUIRE_EQUAL(v.size(), 3);
+  BOOST_CHECK_EQUAL(v[0], 0);
+  BOOST_CHECK_EQUAL(v[1], 1);
+  BOOST_CHECK_EQUAL(v[2], 2);
+}
+
+/**
+ * Remove values and check that the old handles are invalid.
+ */
+BOOST_AUTO_TEST_CASE(slotmap_remove)
+{
+  sw::SlotMap<Value> map;
+  Value a(0), b(1), c(2), d(3);
+
+  map.insert(&a);
+  sw::SlotHandle hb = map.insert(&b);
+  map.insert(&c);
+
+  map.remove(&b);
+  BOOST_CHECK_EQUAL(map.size(), 2);
+  BOOST_CHECK(map.get(hb) == NULL);
+
+  // the slot of b is reused but the handle of b is still invalid
+  sw::SlotHandle hd = map.insert(&d);
+  BOOST_CHECK_EQUAL(hd.index, hb.index);
+  BOOST_CHECK(map.get(hb) == NULL);
+  BOOST_CHECK_EQUAL(map.get(hd), &d);
+
+  std::vector<int> v = values(map);
+  BOOST_REQUIRE_EQUAL(v.size(), 3);
+  BOOST_CHECK_EQUAL(v[0], 0);
+  BOOST_CHECK_EQUAL(v[1], 2);
+  BOOST_CHECK_EQUAL(v[2], 3);
+}
+
+/**
+ * Remove values while iterating.
+ */
+BOOST_AUTO_TEST_CASE(slotmap_remove_iterating)
+{
+  sw::SlotMap<Value> map;
+  Value a(0), b(1), c(2), d(3);
+
+  map.insert(&a);
+  map.insert(&b);
+  map.insert(&c);
+  map.insert(&d);
+
+  std::vector<int> v;
+  for (sw::SlotMap<Value>::iterator i = map.begin(); i != map.end(); ++i) {
+    v.push_back((*i)->n);
+    // a removes c and b removes itself
+    if ((*i)->n == 0)
+      map.remove(&c);
+    else if ((*i)->n == 1)
+      map.remove(*i);
+  }
+
+  BOOST_REQUIRE_EQUAL(v.size(), 3);
+  BOOST_CHECK_EQUAL(v[0], 0);
+  BOOST_CHECK_EQUAL(v[1], 1);
+  BOOST_CHECK_EQUAL(v[2], 3);
+  BOOST_CHECK_EQUAL(map.size(), 2);
+}
+
+/**
+ * Compact the values keeping the order and the handles.
+ */
+BOOST_AUTO_TEST_CASE(slotmap_compact)
+{
+  sw::SlotMap<Value> map;
+  Value a(0), b(1), c(2), d(3);
+
+  map.insert(&a);
+  map.insert(&b);
+  map.insert(&c);
+  sw::SlotHandle hd = map.insert(&d);
+
+  map.remove(&a);
+  map.remove(&c);
+  map.compact();
+
+  BOOST_CHECK_EQUAL(map.size(), 2);
+  BOOST_CHECK_EQUAL(map.get(hd), &d);
+  BOOST_CHECK_EQUAL(map.get(b.slot), &b);
+
+  std::vector<int> v = values(map);
+  BOOST_REQUIRE_EQUAL(v.size(), 2);
+  BOOST_CHECK_EQUAL(v[0], 1);
+  BOOST_CHECK_EQUAL(v[1], 3);
+
+  map.remove(&b);
+  map.remove(&d);
+  map.compact();
+  BOOST_CHECK(map.empty());
+  BOOST_CHECK(map.begin() == map.end());
+}
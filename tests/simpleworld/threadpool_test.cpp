@@ -0,0 +1,82 @@
+/**
+ * @file tests/simpleworld/threadpool_test.cpp
+ * Unit test for threadpool.hpp.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Unit test for threadpool.hpp
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <cstddef>
+
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+
+#include <simpleworld/threadpool.hpp>
+namespace sw = simpleworld;
+
+
+/**
+ * Count the executions of a index.
+ * @param counts executions of each index.
+ * @param index the index.
+ */
+static void count(std::vector<int>& counts, std::size_t index)
+{
+  // tasks with different costs, so some ranges are stolen
+  volatile int work = 0;
+  for (std::size_t i = 0; i < (index % 7) * 1000; i++)
+    work++;
+
+  counts[index]++;
+}
+
+
+/**
+ * Execute each index once with different number of threads and tasks.
+ */
+BOOST_AUTO_TEST_CASE(threadpool_run)
+{
+  for (unsigned threads = 1; threads <= 4; threads++) {
+    sw::ThreadPool pool(threads);
+    BOOST_CHECK_EQUAL(pool.threads(), threads);
+
+    for (std::size_t size = 0; size < 100; size += 7) {
+      std::vector<int> counts(size, 0);
+      pool.run(size, boost::bind(count, boost::ref(counts), _1));
+
+      for (std::size_t i = 0; i < size; i++)
+        BOOST_REQUIRE_EQUAL(counts[i], 1);
+    }
+  }
+}
+
+/**
+ * Use the number of processors.
+ */
+BOOST_AUTO_TEST_CASE(threadpool_default)
+{
+  sw::ThreadPool pool;
+  BOOST_CHECK(pool.threads() >= 1);
+
+  std::vector<int> counts(1000, 0);
+  pool.run(counts.size(), boost::bind(count, boost::ref(counts), _1));
+  for (std::size_t i = 0; i < counts.size(); i++)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+}
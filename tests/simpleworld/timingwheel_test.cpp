@@ -0,0 +1,153 @@
+/**
+ * @file tests/simpleworld/timingwheel_test.cpp
+ * Unit test for timingwheel.hpp.
+ *
+ *  Copyright (C) 2010  Xosé Otero <xoseotero@gmail.com>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Unit test for timingwheel.hpp
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+
+#include <simpleworld/types.hpp>
+#include <simpleworld/timingwheel.hpp>
+namespace sw = simpleworld;
+
+
+/**
+ * Schedule and advance a few events.
+ */
+BOOST_AUTO_TEST_CASE(timingwheel_advance)
+{
+  sw::TimingWheel<int> wheel(10);
+  std::vector<int> due;
+
+  wheel.schedule(11, 1);
+  wheel.schedule(12, 2);
+  wheel.schedule(12, 3);
+  wheel.schedule(300, 4);
+  BOOST_CHECK_EQUAL(wheel.size(), 4);
+
+  wheel.advance(11, &due);
+  BOOST_REQUIRE_EQUAL(due.size(), 1);
+  BOOST_CHECK_EQUAL(due[0], 1);
+
+  due.clear();
+  wheel.advance(12, &due);
+  std::sort(due.begin(), due.end());
+  BOOST_REQUIRE_EQUAL(due.size(), 2);
+  BOOST_CHECK_EQUAL(due[0], 2);
+  BOOST_CHECK_EQUAL(due[1], 3);
+
+  due.clear();
+  wheel.advance(299, &due);
+  BOOST_CHECK(due.empty());
+  wheel.advance(300, &due);
+  BOOST_REQUIRE_EQUAL(due.size(), 1);
+  BOOST_CHECK_EQUAL(due[0], 4);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  BOOST_CHECK_EQUAL(wheel.now(), 300);
+}
+
+/**
+ * Schedule events in cycles already processed.
+ */
+BOOST_AUTO_TEST_CASE(timingwheel_past)
+{
+  sw::TimingWheel<int> wheel(100);
+  std::vector<int> due;
+
+  wheel.schedule(50, 1);
+  wheel.schedule(100, 2);
+
+  wheel.advance(101, &due);
+  std::sort(due.begin(), due.end());
+  BOOST_REQUIRE_EQUAL(due.size(), 2);
+  BOOST_CHECK_EQUAL(due[0], 1);
+  BOOST_CHECK_EQUAL(due[1], 2);
+}
+
+/**
+ * Remove all the events.
+ */
+BOOST_AUTO_TEST_CASE(timingwheel_clear)
+{
+  sw::TimingWheel<int> wheel;
+  std::vector<int> due;
+
+  wheel.schedule(5, 1);
+  wheel.schedule(100000, 2);
+  wheel.clear(1000);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  BOOST_CHECK_EQUAL(wheel.now(), 1000);
+
+  wheel.advance(200000, &due);
+  BOOST_CHECK(due.empty());
+}
+
+/**
+ * Compare the wheel with a simple implementation, with events in all the
+ * levels and events scheduled while advancing.
+ */
+BOOST_AUTO_TEST_CASE(timingwheel_random)
+{
+  std::srand(0);
+
+  sw::Time start = 0xfffff0;
+  sw::TimingWheel<int> wheel(start);
+  std::multimap<sw::Time, int> expected;
+
+  int value = 0;
+  for (; value < 2000; value++) {
+    sw::Time delay = std::rand() % (1 << (8 * (value % 4 + 1)));
+    sw::Time time = start + 1 + delay;
+    wheel.schedule(time, value);
+    expected.insert(std::make_pair(time, value));
+  }
+
+  for (sw::Time now = start + 1; now < start + 200000; now++) {
+    std::vector<int> due;
+    wheel.advance(now, &due);
+    std::sort(due.begin(), due.end());
+
+    std::vector<int> values;
+    while (not expected.empty() and expected.begin()->first <= now) {
+      BOOST_REQUIRE_EQUAL(expected.begin()->first, now);
+      values.push_back(expected.begin()->second);
+      expected.erase(expected.begin());
+    }
+    std::sort(values.begin(), values.end());
+
+    BOOST_REQUIRE(due == values);
+
+    // reschedule some events
+    for (std::vector<int>::const_iterator i = due.begin();
+         i != due.end();
+         ++i)
+      if (*i % 2 == 0) {
+        sw::Time time = now + 1 + std::rand() % 1000;
+        wheel.schedule(time, *i);
+        expected.insert(std::make_pair(time, *i));
+      }
+  }
+
+  BOOST_CHECK_EQUAL(wheel.size(), expected.size());
+}
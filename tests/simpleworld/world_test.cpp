@@ -28,6 +28,7 @@
 #include <simpleworld/worlderror.hpp>
 #include <simpleworld/element.hpp>
 #include <simpleworld/world.hpp>
+#include <simpleworld/random.hpp>
 namespace sw = simpleworld;
 
 
@@ -99,6 +100,64 @@ BOOST_AUTO_TEST_CASE(world_add)
   BOOST_CHECK_EQUAL(world.get(p1)->type, sw::ElementBug);
 }
 
+/**
+ * Get elements from the World without exceptions.
+ */
+BOOST_AUTO_TEST_CASE(world_try_get)
+{
+  sw::World world(16, 16);
+  sw::Position p0(0, 0), p1(15, 15), outside(16, 0);
+  sw::Element e0(sw::ElementEgg);
+
+  world.add(&e0, p0);
+
+  BOOST_CHECK_EQUAL(world.try_get(p0), &e0);
+  BOOST_CHECK(world.try_get(p1) == NULL);
+  BOOST_CHECK(world.try_get(outside) == NULL);
+}
+
+/**
+ * Count the elements of a region, with rows of several words.
+ */
+BOOST_AUTO_TEST_CASE(world_num_elements_region)
+{
+  sw::World world(200, 10);
+  sw::Element egg(sw::ElementEgg);
+  sw::Element bug(sw::ElementBug);
+  sw::Element food(sw::ElementFood);
+
+  for (sw::Coord x = 0; x < 200; x += 3)
+    world.add(&bug, sw::Position(x, 4));
+  world.add(&egg, sw::Position(63, 5));
+  world.add(&food, sw::Position(64, 5));
+  world.add(&food, sw::Position(199, 9));
+
+  sw::Position start(10, 0), end(150, 10);
+  sw::Uint16 bugs = 0;
+  for (sw::Coord x = start.x; x < end.x; x++)
+    if (x % 3 == 0)
+      bugs++;
+
+  BOOST_CHECK_EQUAL(world.num_elements(start, end, sw::ElementBug), bugs);
+  BOOST_CHECK_EQUAL(world.num_elements(start, end, sw::ElementEgg), 1);
+  BOOST_CHECK_EQUAL(world.num_elements(start, end, sw::ElementFood), 1);
+  BOOST_CHECK_EQUAL(world.num_elements(start, end), bugs + 2);
+  BOOST_CHECK_EQUAL(world.num_elements(sw::Position(0, 0),
+                                       sw::Position(200, 10)),
+                    world.num_elements());
+  BOOST_CHECK_EQUAL(world.num_elements(sw::Position(64, 5),
+                                       sw::Position(65, 6)), 1);
+
+  world.move(sw::Position(63, 4), sw::Position(63, 6));
+  world.remove(sw::Position(64, 5));
+  BOOST_CHECK_EQUAL(world.num_elements(start, end, sw::ElementBug), bugs);
+  BOOST_CHECK_EQUAL(world.num_elements(start, end, sw::ElementFood), 0);
+  BOOST_CHECK_EQUAL(world.num_elements(sw::Position(0, 4),
+                                       sw::Position(200, 5),
+                                       sw::ElementBug),
+                    66);
+}
+
 /**
  * Add elements to the World in invalid positions.
  */
@@ -159,11 +218,12 @@ BOOST_AUTO_TEST_CASE(world_remove_notused)
 BOOST_AUTO_TEST_CASE(world_unused_position)
 {
   sw::World world(16, 16);
-  sw::Position p = world.unused_position();
+  sw::Random random(0, 0, 0, sw::RandomCommand);
+  sw::Position p = world.unused_position(&random);
 
   BOOST_CHECK_EQUAL(world.used(p), false);
-  BOOST_CHECK(p.x >= 0 and p.x < 16);
-  BOOST_CHECK(p.y >= 0 and p.y < 16);
+  BOOST_CHECK(p.x < 16);
+  BOOST_CHECK(p.y < 16);
 }
 
 /**
@@ -178,7 +238,8 @@ BOOST_AUTO_TEST_CASE(world_unused_position_full)
     for (p.y = 0; p.y < 16; p.y++)
       world.add(&e, p);
 
-  BOOST_CHECK_THROW(world.unused_position(), sw::WorldError);
+  sw::Random random(0, 0, 0, sw::RandomCommand);
+  BOOST_CHECK_THROW(world.unused_position(&random), sw::WorldError);
 }
 
 /**
@@ -188,7 +249,8 @@ BOOST_AUTO_TEST_CASE(world_unused_position_region)
 {
   sw::World world(16, 16);
   sw::Position start(3, 5), end(10, 6);
-  sw::Position p = world.unused_position(start, end);
+  sw::Random random(0, 0, 0, sw::RandomCommand);
+  sw::Position p = world.unused_position(start, end, &random);
 
   BOOST_CHECK_EQUAL(world.used(p), false);
   BOOST_CHECK(p.x >= start.x and p.x < end.x);
@@ -208,7 +270,70 @@ BOOST_AUTO_TEST_CASE(world_unused_position_region_full)
     for (p.y = start.y; p.y < end.y; p.y++)
       world.add(&e, p);
 
-  BOOST_CHECK_THROW(world.unused_position(start, end), sw::WorldError);
+  sw::Random random(0, 0, 0, sw::RandomCommand);
+  BOOST_CHECK_THROW(world.unused_position(start, end, &random),
+                    sw::WorldError);
+}
+
+/**
+ * Get the only unused position of a region wider than a word.
+ */
+BOOST_AUTO_TEST_CASE(world_unused_position_region_last)
+{
+  sw::World world(200, 16);
+  sw::Position start(30, 2), end(170, 5), last(100, 4);
+  sw::Element e(sw::ElementFood);
+  sw::Position p;
+  for (p.x = start.x; p.x < end.x; p.x++)
+    for (p.y = start.y; p.y < end.y; p.y++)
+      if (not (p == last))
+        world.add(&e, p);
+
+  for (sw::Uint32 i = 0; i < 10; i++) {
+    sw::Random random(0, i, 0, sw::RandomCommand);
+    BOOST_CHECK_EQUAL(world.unused_position(start, end, &random), last);
+  }
+}
+
+/**
+ * Add more than 65535 elements to a big sparse world.
+ */
+BOOST_AUTO_TEST_CASE(world_big)
+{
+  sw::World world(100000, 100000);
+  sw::Position start(1000, 1000), end(99999, 99999), last(99999, 99999);
+  sw::Element e(sw::ElementFood);
+  sw::Position p(0, 50000);
+  for (p.x = 0; p.x < 70000; p.x++)
+    world.add(&e, p);
+  world.add(&e, last);
+
+  BOOST_CHECK_EQUAL(world.num_elements(), 70001);
+  BOOST_CHECK_EQUAL(world.num_elements(sw::Position(0, 0),
+                                       sw::Position(100000, 100000),
+                                       sw::ElementFood), 70001);
+  BOOST_CHECK_EQUAL(world.num_elements(start, end), 69000);
+  BOOST_CHECK_EQUAL(world.get(last), &e);
+
+  for (sw::Uint32 i = 0; i < 100; i++) {
+    sw::Random random(0, i, 0, sw::RandomCommand);
+    p = world.unused_position(start, end, &random);
+    BOOST_CHECK_EQUAL(world.used(p), false);
+    BOOST_CHECK(p.x >= start.x and p.x < end.x);
+    BOOST_CHECK(p.y >= start.y and p.y < end.y);
+  }
+
+  // there are more than 2^32 unused positions, the ones after the index
+  // 2^32 are in the rows after the 42949
+  bool after = false;
+  for (sw::Uint32 i = 0; i < 100; i++) {
+    sw::Random random(0, i, 0, sw::RandomCommand);
+    p = world.unused_position(&random);
+    BOOST_CHECK_EQUAL(world.used(p), false);
+    if (p.y > 43000)
+      after = true;
+  }
+  BOOST_CHECK(after);
 }
 
 /**
@@ -216,7 +341,8 @@ BOOST_AUTO_TEST_CASE(world_unused_position_region_full)
  */
 BOOST_AUTO_TEST_CASE(world_random_orientation)
 {
-  sw::Orientation o = sw::World::random_orientation();
+  sw::Random random(0, 0, 0, sw::RandomCommand);
+  sw::Orientation o = sw::World::random_orientation(&random);
 
   BOOST_CHECK(o == sw::OrientationNorth or
               o == sw::OrientationEast or